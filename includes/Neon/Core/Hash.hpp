@@ -0,0 +1,15 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace Zx
+{
+	template <typename T>
+	inline void HashCombine(std::size_t& seed, const T& value);
+}
+
+#include "Hash.inl"
+
+#endif //HASH_HPP
\ No newline at end of file
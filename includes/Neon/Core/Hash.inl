@@ -0,0 +1,13 @@
+namespace Zx
+{
+	/*
+	@brief : Mixes the hash of a value into a seed
+	@param : The seed, updated with the value
+	@param : The value to hash
+	*/
+	template <typename T>
+	inline void HashCombine(std::size_t& seed, const T& value)
+	{
+		seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef RANGEALLOCATOR_HPP
+#define RANGEALLOCATOR_HPP
+
+#include <cstdint>
+#include <map>
+
+namespace Zx
+{
+	class RangeAllocator
+	{
+	public:
+		RangeAllocator();
+		explicit RangeAllocator(uint64_t capacity);
+
+		bool Allocate(uint64_t size, uint64_t alignment, uint64_t& offset);
+		void Free(uint64_t offset, uint64_t size);
+		void Clear();
+
+		//Getters
+
+		inline uint64_t GetCapacity() const;
+		inline uint64_t GetFreeSize() const;
+		inline uint64_t GetLargestFreeRange() const;
+
+	private:
+		// Free ranges sorted by offset, adjacent ranges are always merged
+		std::map<uint64_t, uint64_t> m_freeRanges;
+
+		uint64_t m_capacity;
+		uint64_t m_freeSize;
+	};
+}
+
+#include "RangeAllocator.inl"
+
+#endif //RANGEALLOCATOR_HPP
\ No newline at end of file
@@ -0,0 +1,25 @@
+namespace Zx
+{
+	inline uint64_t RangeAllocator::GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	inline uint64_t RangeAllocator::GetFreeSize() const
+	{
+		return m_freeSize;
+	}
+
+	inline uint64_t RangeAllocator::GetLargestFreeRange() const
+	{
+		uint64_t largest = 0;
+
+		for (const auto& range : m_freeRanges)
+		{
+			if (range.second > largest)
+				largest = range.second;
+		}
+
+		return largest;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef RETIREQUEUE_HPP
+#define RETIREQUEUE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Zx
+{
+	/*
+	@brief : Counts the frames begun by the application, the retire queues reading the same counter agree on the frames which are over
+	*/
+	class FrameCounter
+	{
+	public:
+		explicit FrameCounter(uint32_t frameCount = 3);
+
+		inline void Advance();
+
+		//Getters
+
+		inline uint64_t GetFrame() const;
+		inline uint32_t GetFrameCount() const;
+		inline bool IsOver(uint64_t frame) const;
+
+	private:
+		uint64_t m_frame;
+
+		// The frames in flight, a frame is over once as many frames began after it
+		uint32_t m_frameCount;
+	};
+
+	/*
+	@brief : Holds the values the frames in flight may still use until the frame which retired them is over
+	*/
+	template <typename T>
+	class RetireQueue
+	{
+	public:
+		RetireQueue() = default;
+
+		void Push(const FrameCounter& counter, const T& value);
+
+		template <typename Function>
+		void Release(const FrameCounter& counter, Function release);
+
+		template <typename Function>
+		void ReleaseAll(Function release);
+
+		template <typename Predicate>
+		bool Take(const FrameCounter& counter, Predicate predicate, T& value);
+
+		//Getters
+
+		inline bool IsEmpty() const;
+		inline std::size_t GetSize() const;
+
+	private:
+		// The frame each value was retired in, in the order they were retired
+		std::vector<std::pair<uint64_t, T>> m_values;
+	};
+}
+
+#include "RetireQueue.inl"
+
+#endif //RETIREQUEUE_HPP
\ No newline at end of file
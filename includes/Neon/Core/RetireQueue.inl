@@ -0,0 +1,114 @@
+namespace Zx
+{
+	/*
+	@brief : Creates a counter at the frame 0
+	@param : The number of frames in flight
+	*/
+	inline FrameCounter::FrameCounter(uint32_t frameCount) : m_frame(0), m_frameCount(frameCount > 0 ? frameCount : 1)
+	{}
+
+	/*
+	@brief : Begins a new frame, to call once per frame once its fence is waited
+	*/
+	inline void FrameCounter::Advance()
+	{
+		m_frame++;
+	}
+
+	inline uint64_t FrameCounter::GetFrame() const
+	{
+		return m_frame;
+	}
+
+	inline uint32_t FrameCounter::GetFrameCount() const
+	{
+		return m_frameCount;
+	}
+
+	inline bool FrameCounter::IsOver(uint64_t frame) const
+	{
+		return m_frame - frame >= m_frameCount;
+	}
+
+	/*
+	@brief : Retires a value during the current frame
+	@param : The counter of the frames
+	@param : The value to keep until the frame is over
+	*/
+	template <typename T>
+	void RetireQueue<T>::Push(const FrameCounter& counter, const T& value)
+	{
+		m_values.push_back(std::make_pair(counter.GetFrame(), value));
+	}
+
+	/*
+	@brief : Releases the values retired by the frames which are over, in the order they were retired
+	@param : The counter of the frames
+	@param : The function releasing a value, called with a reference to it
+	*/
+	template <typename T>
+	template <typename Function>
+	void RetireQueue<T>::Release(const FrameCounter& counter, Function release)
+	{
+		auto it = std::stable_partition(m_values.begin(), m_values.end(), [&counter](const std::pair<uint64_t, T>& retired)
+		{
+			return !counter.IsOver(retired.first);
+		});
+
+		for (auto retired = it; retired != m_values.end(); ++retired)
+			release(retired->second);
+
+		m_values.erase(it, m_values.end());
+	}
+
+	/*
+	@brief : Releases every value whatever its frame, the device must be idle
+	@param : The function releasing a value, called with a reference to it
+	*/
+	template <typename T>
+	template <typename Function>
+	void RetireQueue<T>::ReleaseAll(Function release)
+	{
+		for (std::pair<uint64_t, T>& retired : m_values)
+			release(retired.second);
+
+		m_values.clear();
+	}
+
+	/*
+	@brief : Removes the first value of a frame which is over and matching a predicate, to reuse it instead of releasing it
+	@param : The counter of the frames
+	@param : The function telling if a value can be taken, called with a constant reference to it
+	@param : The value taken, left untouched if none is
+	@return : Returns true if a value is taken, false otherwise
+	*/
+	template <typename T>
+	template <typename Predicate>
+	bool RetireQueue<T>::Take(const FrameCounter& counter, Predicate predicate, T& value)
+	{
+		for (auto it = m_values.begin(); it != m_values.end(); ++it)
+		{
+			if (!counter.IsOver(it->first) || !predicate(static_cast<const T&>(it->second)))
+				continue;
+
+			value = it->second;
+			m_values.erase(it);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	template <typename T>
+	inline bool RetireQueue<T>::IsEmpty() const
+	{
+		return m_values.empty();
+	}
+
+	template <typename T>
+	inline std::size_t RetireQueue<T>::GetSize() const
+	{
+		return m_values.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef SPSCQUEUE_HPP
+#define SPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Zx
+{
+	/*
+	@brief : A bounded queue between one producer thread and one consumer thread, neither of them ever takes a lock
+	*/
+	template <typename T>
+	class SpscQueue
+	{
+	public:
+		explicit SpscQueue(std::size_t capacity);
+
+		SpscQueue(const SpscQueue&) = delete;
+		SpscQueue& operator=(const SpscQueue&) = delete;
+
+		bool Push(const T& value);
+		bool Pop(T& value);
+
+		//Getters
+
+		inline bool IsEmpty() const;
+		inline std::size_t GetCapacity() const;
+
+	private:
+		std::vector<T> m_items;
+		std::size_t m_mask;
+
+		// The indices only grow, each one is written by a single thread and on its own cache line
+		alignas(64) std::atomic<std::size_t> m_head;
+		alignas(64) std::atomic<std::size_t> m_tail;
+
+		// The last index of the other thread seen by the producer and by the consumer, the shared line is only read again when they look full or empty
+		alignas(64) std::size_t m_cachedHead;
+		alignas(64) std::size_t m_cachedTail;
+	};
+}
+
+#include "SpscQueue.inl"
+
+#endif //SPSCQUEUE_HPP
\ No newline at end of file
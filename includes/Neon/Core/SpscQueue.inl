@@ -0,0 +1,82 @@
+namespace Zx
+{
+	/*
+	@brief : Creates an empty queue
+	@param : The number of values the queue holds, rounded up to a power of two
+	*/
+	template <typename T>
+	SpscQueue<T>::SpscQueue(std::size_t capacity) : m_items(), m_mask(0), m_head(0), m_tail(0), m_cachedHead(0), m_cachedTail(0)
+	{
+		std::size_t size = 1;
+
+		while (size < capacity)
+			size <<= 1;
+
+		m_items.resize(size);
+		m_mask = size - 1;
+	}
+
+	/*
+	@brief : Appends a value, to call from the producer thread only
+	@param : The value to copy in the queue
+	@return : Returns true if the value is queued, false if the queue is full
+	*/
+	template <typename T>
+	bool SpscQueue<T>::Push(const T& value)
+	{
+		std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+		if (tail - m_cachedHead > m_mask)
+		{
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+
+			if (tail - m_cachedHead > m_mask)
+				return false;
+		}
+
+		m_items[tail & m_mask] = value;
+
+		// The value is written before the consumer can see it
+		m_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/*
+	@brief : Removes the oldest value, to call from the consumer thread only
+	@param : The value, left untouched if the queue is empty
+	@return : Returns true if a value is removed, false if the queue is empty
+	*/
+	template <typename T>
+	bool SpscQueue<T>::Pop(T& value)
+	{
+		std::size_t head = m_head.load(std::memory_order_relaxed);
+
+		if (head == m_cachedTail)
+		{
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+			if (head == m_cachedTail)
+				return false;
+		}
+
+		value = m_items[head & m_mask];
+
+		// The value is read before the producer can write over it
+		m_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template <typename T>
+	inline bool SpscQueue<T>::IsEmpty() const
+	{
+		return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+	}
+
+	template <typename T>
+	inline std::size_t SpscQueue<T>::GetCapacity() const
+	{
+		return m_items.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef BINDLESSTABLE_HPP
+#define BINDLESSTABLE_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/RetireQueue.hpp>
+
+namespace Zx
+{
+	class Device;
+	class DescriptorLayoutCache;
+
+	class BindlessTable
+	{
+		struct BindlessTables;
+
+	public:
+		BindlessTable() = default;
+		BindlessTable(Device& device, DescriptorLayoutCache& layoutCache, uint32_t maxTextures = 4096, uint32_t maxBuffers = 1024);
+		BindlessTable(const BindlessTable& bindlessTable);
+
+		~BindlessTable();
+
+		void BeginFrame();
+
+		uint32_t AddTexture(VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		uint32_t AddBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+		void RemoveTexture(uint32_t index);
+		void RemoveBuffer(uint32_t index);
+
+		void Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS) const;
+		void PushIndices(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const uint32_t* indices, uint32_t indexCount) const;
+
+		static VkPushConstantRange GetPushConstantRange(uint32_t indexCount);
+
+		//Getters
+
+		inline bool IsAvailable() const;
+		inline const VkDescriptorSetLayout& GetDescriptorSetLayout() const;
+		inline const VkDescriptorSet& GetDescriptorSet() const;
+		inline uint32_t GetMaxTextures() const;
+		inline uint32_t GetMaxBuffers() const;
+
+		BindlessTable& operator=(BindlessTable&& bindlessTable) noexcept;
+
+		static const uint32_t InvalidIndex = UINT32_MAX;
+
+	private:
+		struct Slots
+		{
+			inline Slots() : capacity(0), count(0), freeIndices(), retiredIndices()
+			{}
+
+			uint32_t capacity;
+			uint32_t count;
+			std::vector<uint32_t> freeIndices;
+			RetireQueue<uint32_t> retiredIndices;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<BindlessTables> m_bindlessTable;
+
+		struct BindlessTables
+		{
+			inline BindlessTables() : descriptorSetLayout(VK_NULL_HANDLE), descriptorPool(VK_NULL_HANDLE), descriptorSet(VK_NULL_HANDLE), textures(), buffers()
+			{}
+
+			VkDescriptorSetLayout descriptorSetLayout;
+			VkDescriptorPool descriptorPool;
+			VkDescriptorSet descriptorSet;
+
+			Slots textures;
+			Slots buffers;
+		};
+
+	private:
+		bool CreateDescriptorSet(DescriptorLayoutCache& layoutCache);
+
+		uint32_t AcquireSlot(Slots& slots);
+		void RetireSlot(Slots& slots, uint32_t index);
+	};
+}
+
+#include "BindlessTable.inl"
+
+#endif //BINDLESSTABLE_HPP
\ No newline at end of file
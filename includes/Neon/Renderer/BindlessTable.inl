@@ -0,0 +1,27 @@
+namespace Zx
+{
+	inline bool BindlessTable::IsAvailable() const
+	{
+		return (m_bindlessTable != nullptr) && (m_bindlessTable->descriptorSet != VK_NULL_HANDLE);
+	}
+
+	inline const VkDescriptorSetLayout& BindlessTable::GetDescriptorSetLayout() const
+	{
+		return m_bindlessTable->descriptorSetLayout;
+	}
+
+	inline const VkDescriptorSet& BindlessTable::GetDescriptorSet() const
+	{
+		return m_bindlessTable->descriptorSet;
+	}
+
+	inline uint32_t BindlessTable::GetMaxTextures() const
+	{
+		return m_bindlessTable->textures.capacity;
+	}
+
+	inline uint32_t BindlessTable::GetMaxBuffers() const
+	{
+		return m_bindlessTable->buffers.capacity;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef BUFFER_HPP
+#define BUFFER_HPP
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Zx
+{
+	class Device;
+
+	class Buffer
+	{
+		struct Buffers;
+
+	public:
+		Buffer() = default;
+		Buffer(Device& device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties, const void* data = nullptr,
+			const std::vector<uint32_t>& queueFamilies = {});
+		Buffer(const Buffer& buffer);
+
+		~Buffer();
+
+		bool Upload(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
+		bool Flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline bool IsHostVisible() const;
+		inline const VkBuffer& GetBuffer() const;
+		inline const VkDeviceMemory& GetMemory() const;
+		inline VkDeviceSize GetSize() const;
+		inline VkBufferUsageFlags GetUsage() const;
+		inline void* GetData() const;
+
+		Buffer& operator=(Buffer&& buffer) noexcept;
+
+	private:
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<Buffers> m_buffer;
+
+		struct Buffers
+		{
+			inline Buffers() : buffer(VK_NULL_HANDLE), memory(VK_NULL_HANDLE), size(0), allocationSize(0), usage(0), memoryProperties(0), data(nullptr), atomSize(1)
+			{}
+
+			VkBuffer buffer;
+			VkDeviceMemory memory;
+
+			VkDeviceSize size;
+			VkDeviceSize allocationSize;
+			VkBufferUsageFlags usage;
+			VkMemoryPropertyFlags memoryProperties;
+
+			char* data;
+			VkDeviceSize atomSize;
+		};
+
+	private:
+		bool CreateBuffer(VkMemoryPropertyFlags memoryProperties, const std::vector<uint32_t>& queueFamilies);
+		bool AllocateBufferMemory(VkMemoryPropertyFlags memoryProperties);
+		bool UploadStaged(const void* data, VkDeviceSize size, VkDeviceSize offset);
+	};
+}
+
+#include "Buffer.inl"
+
+#endif //BUFFER_HPP
\ No newline at end of file
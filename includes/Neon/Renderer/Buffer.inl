@@ -0,0 +1,37 @@
+namespace Zx
+{
+	inline bool Buffer::IsValid() const
+	{
+		return (m_buffer != nullptr) && (m_buffer->buffer != VK_NULL_HANDLE) && (m_buffer->memory != VK_NULL_HANDLE);
+	}
+
+	inline bool Buffer::IsHostVisible() const
+	{
+		return m_buffer->data != nullptr;
+	}
+
+	inline const VkBuffer& Buffer::GetBuffer() const
+	{
+		return m_buffer->buffer;
+	}
+
+	inline const VkDeviceMemory& Buffer::GetMemory() const
+	{
+		return m_buffer->memory;
+	}
+
+	inline VkDeviceSize Buffer::GetSize() const
+	{
+		return m_buffer->size;
+	}
+
+	inline VkBufferUsageFlags Buffer::GetUsage() const
+	{
+		return m_buffer->usage;
+	}
+
+	inline void* Buffer::GetData() const
+	{
+		return m_buffer->data;
+	}
+}
\ No newline at end of file
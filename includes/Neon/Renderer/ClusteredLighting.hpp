@@ -0,0 +1,175 @@
+#ifndef CLUSTEREDLIGHTING_HPP
+#define CLUSTEREDLIGHTING_HPP
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/Buffer.hpp>
+#include <Neon/Renderer/DeferredLighting.hpp>
+
+namespace Zx
+{
+	class Device;
+	class DescriptorLayoutCache;
+	class DescriptorAllocator;
+
+	struct ClusteredLightingInfo
+	{
+		// 16x9 tiles follow the usual aspect ratios, the slices are exponential in depth so a cluster is about as deep as it is wide
+		inline ClusteredLightingInfo() : tileCountX(16), tileCountY(9), sliceCount(24), maxLights(1024), maxLightIndices(64 * 1024), threadCount(0)
+		{}
+
+		uint32_t tileCountX;
+		uint32_t tileCountY;
+		uint32_t sliceCount;
+
+		uint32_t maxLights;
+
+		// The light lists of all the clusters share this many indices, the lists past it are truncated
+		uint32_t maxLightIndices;
+
+		// The slices are binned by this many threads, 0 uses every core
+		uint32_t threadCount;
+	};
+
+	/*
+	@brief : The perspective of the camera the lights are binned for, the view space looks down -Z
+	*/
+	struct ClusterProjection
+	{
+		float verticalFov;
+		float aspect;
+		float nearPlane;
+		float farPlane;
+	};
+
+	class ClusteredLighting
+	{
+		struct ClusteredLightings;
+
+	public:
+		ClusteredLighting() = default;
+		ClusteredLighting(Device& device, DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator, const ClusteredLightingInfo& info = ClusteredLightingInfo(),
+			uint32_t frameCount = 3);
+		ClusteredLighting(const ClusteredLighting& clusteredLighting);
+
+		void BeginFrame(uint32_t frameIndex);
+		bool AddLight(const PointLight& light);
+		bool Assign(const float* view, const ClusterProjection& projection, VkExtent2D extent);
+
+		void Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS) const;
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline const VkDescriptorSetLayout& GetDescriptorSetLayout() const;
+		inline uint32_t GetClusterCount() const;
+		inline uint32_t GetLightCount() const;
+		inline uint32_t GetLightIndexCount() const;
+
+		ClusteredLighting& operator=(ClusteredLighting&& clusteredLighting) noexcept;
+
+	private:
+		/*
+		@brief : The start of the cluster region, laid out like the std430 header the forward fragment shader reads
+		*/
+		struct ClusterHeader
+		{
+			uint32_t tileCountX;
+			uint32_t tileCountY;
+			uint32_t sliceCount;
+			uint32_t lightCount;
+
+			// A fragment finds its cluster from gl_FragCoord and log(depth) * sliceScale + sliceBias
+			float tileWidth;
+			float tileHeight;
+			float sliceScale;
+			float sliceBias;
+		};
+
+		struct ClusterRange
+		{
+			uint32_t offset;
+			uint32_t count;
+		};
+
+		struct TileRect
+		{
+			uint32_t light;
+			uint32_t x0;
+			uint32_t x1;
+			uint32_t y0;
+			uint32_t y1;
+		};
+
+		// The slices of a thread own a contiguous range of clusters, their indices are appended once every thread is done
+		struct SliceChunk
+		{
+			uint32_t firstSlice;
+			uint32_t lastSlice;
+
+			std::vector<TileRect> rects;
+			std::vector<uint32_t> indices;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<ClusteredLightings> m_clusteredLighting;
+
+		struct ClusteredLightings
+		{
+			inline ClusteredLightings() : info(), buffer(), descriptorSetLayout(VK_NULL_HANDLE), descriptorSet(VK_NULL_HANDLE), frameCount(0), frameSize(0), clusterRegion(0)
+				, lightRegion(0), indexRegion(0), frameIndex(0), lights(), lightX(), lightY(), lightDepth(), firstSlice(), lastSlice(), sliceDepths(), sliceScale(0.0f)
+				, sliceBias(0.0f), clusters(), chunks(), lightIndexCount(0)
+			{}
+
+			ClusteredLightingInfo info;
+
+			// Each frame owns a region holding the header and the clusters, the lights, then the light indices
+			Buffer buffer;
+
+			VkDescriptorSetLayout descriptorSetLayout;
+			VkDescriptorSet descriptorSet;
+
+			uint32_t frameCount;
+			VkDeviceSize frameSize;
+			VkDeviceSize clusterRegion;
+			VkDeviceSize lightRegion;
+			VkDeviceSize indexRegion;
+
+			uint32_t frameIndex;
+			std::vector<PointLight> lights;
+
+			// The lights in view space, one array per component so 4 lights are transformed at once
+			std::vector<float> lightX;
+			std::vector<float> lightY;
+			std::vector<float> lightDepth;
+			std::vector<uint32_t> firstSlice;
+			std::vector<uint32_t> lastSlice;
+
+			std::vector<float> sliceDepths;
+			float sliceScale;
+			float sliceBias;
+
+			std::vector<ClusterRange> clusters;
+			std::vector<SliceChunk> chunks;
+
+			uint32_t lightIndexCount;
+		};
+
+	private:
+		bool CreateBuffer();
+		bool CreateDescriptorSet(DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator);
+
+		void TransformLights(const float* view);
+		void BinSlices(SliceChunk& chunk, float tanHalfX, float tanHalfY);
+		bool ComputeTileRect(uint32_t light, float nearDepth, float farDepth, float tanHalfX, float tanHalfY, TileRect& rect) const;
+		bool Upload(VkExtent2D extent);
+
+		static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment);
+	};
+}
+
+#include "ClusteredLighting.inl"
+
+#endif //CLUSTEREDLIGHTING_HPP
\ No newline at end of file
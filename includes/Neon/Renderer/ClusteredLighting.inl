@@ -0,0 +1,27 @@
+namespace Zx
+{
+	inline bool ClusteredLighting::IsValid() const
+	{
+		return (m_clusteredLighting != nullptr) && (m_clusteredLighting->descriptorSet != VK_NULL_HANDLE);
+	}
+
+	inline const VkDescriptorSetLayout& ClusteredLighting::GetDescriptorSetLayout() const
+	{
+		return m_clusteredLighting->descriptorSetLayout;
+	}
+
+	inline uint32_t ClusteredLighting::GetClusterCount() const
+	{
+		return m_clusteredLighting->info.tileCountX * m_clusteredLighting->info.tileCountY * m_clusteredLighting->info.sliceCount;
+	}
+
+	inline uint32_t ClusteredLighting::GetLightCount() const
+	{
+		return static_cast<uint32_t>(m_clusteredLighting->lights.size());
+	}
+
+	inline uint32_t ClusteredLighting::GetLightIndexCount() const
+	{
+		return m_clusteredLighting->lightIndexCount;
+	}
+}
\ No newline at end of file
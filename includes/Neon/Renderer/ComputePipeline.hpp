@@ -0,0 +1,57 @@
+#ifndef COMPUTEPIPELINE_HPP
+#define COMPUTEPIPELINE_HPP
+
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/String.hpp>
+#include <Neon/Renderer/Pipeline.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	class ComputePipeline
+	{
+		struct ComputePipelines;
+
+	public:
+		ComputePipeline() = default;
+		ComputePipeline(Device& device, const String& filename, const PipelineInfo& info = PipelineInfo());
+		ComputePipeline(const ComputePipeline& computePipeline);
+
+		~ComputePipeline();
+
+		void Bind(VkCommandBuffer commandBuffer) const;
+		void Dispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) const;
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline const VkPipeline& GetPipeline() const;
+		inline const VkPipelineLayout& GetPipelineLayout() const;
+
+		ComputePipeline& operator=(ComputePipeline&& computePipeline) noexcept;
+
+	private:
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<ComputePipelines> m_computePipeline;
+
+		struct ComputePipelines
+		{
+			inline ComputePipelines() : pipeline(VK_NULL_HANDLE), pipelineLayout(VK_NULL_HANDLE)
+			{}
+
+			VkPipeline pipeline;
+			VkPipelineLayout pipelineLayout;
+		};
+
+	private:
+		bool CreatePipeline(const String& filename);
+		bool CreatePipelineLayout(const PipelineInfo& info);
+	};
+}
+
+#include "ComputePipeline.inl"
+
+#endif //COMPUTEPIPELINE_HPP
\ No newline at end of file
@@ -0,0 +1,17 @@
+namespace Zx
+{
+	inline bool ComputePipeline::IsValid() const
+	{
+		return (m_computePipeline != nullptr) && (m_computePipeline->pipeline != VK_NULL_HANDLE);
+	}
+
+	inline const VkPipeline& ComputePipeline::GetPipeline() const
+	{
+		return m_computePipeline->pipeline;
+	}
+
+	inline const VkPipelineLayout& ComputePipeline::GetPipelineLayout() const
+	{
+		return m_computePipeline->pipelineLayout;
+	}
+}
\ No newline at end of file
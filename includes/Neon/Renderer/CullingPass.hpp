@@ -0,0 +1,113 @@
+#ifndef CULLINGPASS_HPP
+#define CULLINGPASS_HPP
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/Buffer.hpp>
+#include <Neon/Renderer/ComputePipeline.hpp>
+#include <Neon/Renderer/IndirectDrawBuffer.hpp>
+
+namespace Zx
+{
+	class Device;
+	class DescriptorLayoutCache;
+	class DescriptorAllocator;
+
+	struct MeshRange;
+
+	/*
+	@brief : An object tested by the culling shader, laid out like the std430 struct of cull.comp
+	*/
+	struct CullingInstance
+	{
+		float center[3];
+		float radius;
+
+		uint32_t indexCount;
+		uint32_t firstIndex;
+		int32_t vertexOffset;
+		uint32_t firstInstance;
+	};
+
+	class CullingPass
+	{
+		struct CullingPasses;
+
+	public:
+		CullingPass() = default;
+		CullingPass(Device& device, DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator, IndirectDrawBuffer& indirectBuffer, uint32_t maxInstances,
+			uint32_t frameCount = 3);
+		CullingPass(const CullingPass& cullingPass);
+
+		~CullingPass();
+
+		void BeginFrame(uint32_t frameIndex);
+		bool AddInstance(const MeshRange& mesh, const float* center, float radius, uint32_t firstInstance = 0);
+		bool Flush();
+
+		void Record(VkCommandBuffer commandBuffer, const float* viewProjection) const;
+		bool Submit(const float* viewProjection);
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline bool IsAsync() const;
+		inline const VkSemaphore& GetSemaphore() const;
+		inline uint32_t GetInstanceCount() const;
+
+		CullingPass& operator=(CullingPass&& cullingPass) noexcept;
+
+	private:
+		struct CullingConstants
+		{
+			float planes[24];
+			uint32_t instanceCount;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<CullingPasses> m_cullingPass;
+
+		struct CullingPasses
+		{
+			inline CullingPasses() : pipeline(), indirectBuffer(), instanceBuffer(), descriptorSetLayout(VK_NULL_HANDLE), descriptorSet(VK_NULL_HANDLE)
+				, commandPool(VK_NULL_HANDLE), commandBuffers(), semaphores(), maxInstances(0), frameCount(0), frameSize(0), frameIndex(0), instanceCount(0)
+			{}
+
+			ComputePipeline pipeline;
+			IndirectDrawBuffer indirectBuffer;
+			Buffer instanceBuffer;
+
+			VkDescriptorSetLayout descriptorSetLayout;
+			VkDescriptorSet descriptorSet;
+
+			// Only created when the compute queue belongs to another family than the graphics queue
+			VkCommandPool commandPool;
+			std::vector<VkCommandBuffer> commandBuffers;
+			std::vector<VkSemaphore> semaphores;
+
+			uint32_t maxInstances;
+			uint32_t frameCount;
+			VkDeviceSize frameSize;
+
+			uint32_t frameIndex;
+			uint32_t instanceCount;
+		};
+
+	private:
+		bool CreateInstanceBuffer();
+		bool CreateDescriptorSet(DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator);
+		bool CreatePipeline();
+		bool CreateAsyncResources();
+
+		void RecordCulling(VkCommandBuffer commandBuffer, const float* viewProjection) const;
+
+		static void ExtractFrustumPlanes(const float* viewProjection, float* planes);
+		static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment);
+	};
+}
+
+#include "CullingPass.inl"
+
+#endif //CULLINGPASS_HPP
\ No newline at end of file
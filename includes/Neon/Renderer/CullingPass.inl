@@ -0,0 +1,22 @@
+namespace Zx
+{
+	inline bool CullingPass::IsValid() const
+	{
+		return (m_cullingPass != nullptr) && m_cullingPass->pipeline.IsValid() && (m_cullingPass->descriptorSet != VK_NULL_HANDLE);
+	}
+
+	inline bool CullingPass::IsAsync() const
+	{
+		return m_cullingPass->commandPool != VK_NULL_HANDLE;
+	}
+
+	inline const VkSemaphore& CullingPass::GetSemaphore() const
+	{
+		return m_cullingPass->semaphores[m_cullingPass->frameIndex];
+	}
+
+	inline uint32_t CullingPass::GetInstanceCount() const
+	{
+		return m_cullingPass->instanceCount;
+	}
+}
\ No newline at end of file
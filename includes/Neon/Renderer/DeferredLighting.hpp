@@ -0,0 +1,101 @@
+#ifndef DEFERREDLIGHTING_HPP
+#define DEFERREDLIGHTING_HPP
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/Buffer.hpp>
+#include <Neon/Renderer/DescriptorAllocator.hpp>
+#include <Neon/Renderer/Pipeline.hpp>
+
+namespace Zx
+{
+	class Device;
+	class RenderPass;
+	class SwapChain;
+	class DescriptorLayoutCache;
+
+	/*
+	@brief : A point light of the lighting shader, laid out like the std430 struct of lighting.frag
+	*/
+	struct PointLight
+	{
+		float position[3];
+		float radius;
+
+		float color[3];
+		float intensity;
+	};
+
+	class DeferredLighting
+	{
+		struct DeferredLightings;
+
+	public:
+		DeferredLighting() = default;
+		DeferredLighting(Device& device, RenderPass& renderPass, SwapChain& swapChain, DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator,
+			uint32_t maxLights = 1024, uint32_t frameCount = 3);
+		DeferredLighting(const DeferredLighting& deferredLighting);
+
+		void BeginFrame(uint32_t frameIndex);
+		bool AddLight(const PointLight& light);
+		bool Flush();
+
+		bool UpdateInputAttachments();
+		void Record(VkCommandBuffer commandBuffer, const float* inverseViewProjection) const;
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline uint32_t GetLightCount() const;
+
+		DeferredLighting& operator=(DeferredLighting&& deferredLighting) noexcept;
+
+	private:
+		struct LightingConstants
+		{
+			float inverseViewProjection[16];
+			uint32_t lightCount;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<RenderPass> m_renderPass;
+		std::shared_ptr<SwapChain> m_swapChain;
+		std::shared_ptr<DeferredLightings> m_lighting;
+
+		struct DeferredLightings
+		{
+			inline DeferredLightings() : pipeline(), descriptorAllocator(), lightBuffer(), descriptorSetLayout(VK_NULL_HANDLE), descriptorSet(VK_NULL_HANDLE), inputViews(), maxLights(0)
+				, frameCount(0), frameSize(0), frameIndex(0), lightCount(0)
+			{}
+
+			Pipeline pipeline;
+			DescriptorAllocator descriptorAllocator;
+			Buffer lightBuffer;
+
+			// The input attachments change with the extent of the swap chain, the set of the old views is released after a resize
+			VkDescriptorSetLayout descriptorSetLayout;
+			VkDescriptorSet descriptorSet;
+			std::vector<VkImageView> inputViews;
+
+			uint32_t maxLights;
+			uint32_t frameCount;
+			VkDeviceSize frameSize;
+
+			uint32_t frameIndex;
+			uint32_t lightCount;
+		};
+
+	private:
+		bool CreateLightBuffer();
+		bool CreateDescriptorSetLayout(DescriptorLayoutCache& layoutCache);
+		bool CreatePipeline();
+
+		static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment);
+	};
+}
+
+#include "DeferredLighting.inl"
+
+#endif //DEFERREDLIGHTING_HPP
\ No newline at end of file
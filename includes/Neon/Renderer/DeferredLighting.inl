@@ -0,0 +1,12 @@
+namespace Zx
+{
+	inline bool DeferredLighting::IsValid() const
+	{
+		return (m_lighting != nullptr) && (m_lighting->descriptorSet != VK_NULL_HANDLE);
+	}
+
+	inline uint32_t DeferredLighting::GetLightCount() const
+	{
+		return m_lighting->lightCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef DESCRIPTORALLOCATOR_HPP
+#define DESCRIPTORALLOCATOR_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/RetireQueue.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	struct DescriptorWrite
+	{
+		inline DescriptorWrite() : binding(0), arrayElement(0), type(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER), bufferInfo(), imageInfo()
+		{}
+
+		uint32_t binding;
+		uint32_t arrayElement;
+		VkDescriptorType type;
+		VkDescriptorBufferInfo bufferInfo;
+		VkDescriptorImageInfo imageInfo;
+	};
+
+	class DescriptorAllocator
+	{
+		struct DescriptorAllocators;
+
+	public:
+		DescriptorAllocator() = default;
+		DescriptorAllocator(Device& device, uint32_t frameCount = 3, uint32_t setsPerPool = 128);
+		DescriptorAllocator(const DescriptorAllocator& descriptorAllocator);
+
+		~DescriptorAllocator();
+
+		void BeginFrame(uint32_t frameIndex);
+		bool Allocate(VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet);
+		VkDescriptorSet GetImmutableSet(VkDescriptorSetLayout layout, const std::vector<DescriptorWrite>& writes);
+		void ReleaseImmutableSets(VkImageView imageView);
+
+		static DescriptorWrite BufferWrite(uint32_t binding, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+		static DescriptorWrite ImageWrite(uint32_t binding, VkDescriptorType type, VkSampler sampler, VkImageView imageView, VkImageLayout imageLayout);
+
+		//Getters
+
+		inline std::size_t GetPoolCount() const;
+		inline std::size_t GetImmutableSetCount() const;
+
+		DescriptorAllocator& operator=(DescriptorAllocator&& descriptorAllocator) noexcept;
+
+	private:
+		struct ImmutableSet
+		{
+			VkDescriptorSetLayout layout;
+			std::vector<DescriptorWrite> writes;
+			VkDescriptorSet descriptorSet;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<DescriptorAllocators> m_allocator;
+
+		struct DescriptorAllocators
+		{
+			inline DescriptorAllocators() : framePools(), persistentPools(), freePools(), immutableSets(), releasedSets(), frameIndex(0), setsPerPool(0), poolCount(0)
+			{}
+
+			std::vector<std::vector<VkDescriptorPool>> framePools;
+			std::vector<VkDescriptorPool> persistentPools;
+			std::vector<VkDescriptorPool> freePools;
+			std::unordered_multimap<std::size_t, ImmutableSet> immutableSets;
+
+			// The persistent pools cannot free a set, a released one is written again for a set of the same layout once no frame in flight uses it
+			RetireQueue<ImmutableSet> releasedSets;
+
+			uint32_t frameIndex;
+			uint32_t setsPerPool;
+			std::size_t poolCount;
+		};
+
+	private:
+		bool AllocateFromPools(std::vector<VkDescriptorPool>& pools, VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet);
+		bool GrabPool(VkDescriptorPool& pool);
+		bool ReuseReleasedSet(VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet);
+
+		static std::size_t HashWrites(VkDescriptorSetLayout layout, const std::vector<DescriptorWrite>& writes);
+		static bool IsSameWrite(const DescriptorWrite& a, const DescriptorWrite& b);
+		static bool IsImageDescriptor(VkDescriptorType type);
+	};
+}
+
+#include "DescriptorAllocator.inl"
+
+#endif //DESCRIPTORALLOCATOR_HPP
\ No newline at end of file
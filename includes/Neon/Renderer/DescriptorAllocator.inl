@@ -0,0 +1,12 @@
+namespace Zx
+{
+	inline std::size_t DescriptorAllocator::GetPoolCount() const
+	{
+		return m_allocator->poolCount;
+	}
+
+	inline std::size_t DescriptorAllocator::GetImmutableSetCount() const
+	{
+		return m_allocator->immutableSets.size();
+	}
+}
\ No newline at end of file
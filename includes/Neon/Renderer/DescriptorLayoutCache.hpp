@@ -0,0 +1,72 @@
+#ifndef DESCRIPTORLAYOUTCACHE_HPP
+#define DESCRIPTORLAYOUTCACHE_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Zx
+{
+	class Device;
+
+	class DescriptorLayoutCache
+	{
+		struct DescriptorLayoutCaches;
+
+	public:
+		DescriptorLayoutCache() = default;
+		DescriptorLayoutCache(Device& device);
+		DescriptorLayoutCache(const DescriptorLayoutCache& layoutCache);
+
+		~DescriptorLayoutCache();
+
+		VkDescriptorSetLayout GetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags = 0,
+			const std::vector<VkDescriptorBindingFlagsEXT>& bindingFlags = std::vector<VkDescriptorBindingFlagsEXT>());
+
+		//Getters
+
+		inline std::size_t GetLayoutCount() const;
+
+		DescriptorLayoutCache& operator=(DescriptorLayoutCache&& layoutCache) noexcept;
+
+	private:
+		struct LayoutKey
+		{
+			inline LayoutKey() : flags(0), bindings(), bindingFlags(), immutableBindings(), immutableSamplers()
+			{}
+
+			bool operator==(const LayoutKey& key) const;
+
+			VkDescriptorSetLayoutCreateFlags flags;
+			std::vector<VkDescriptorSetLayoutBinding> bindings;
+			std::vector<VkDescriptorBindingFlagsEXT> bindingFlags;
+			std::vector<uint32_t> immutableBindings;
+			std::vector<VkSampler> immutableSamplers;
+		};
+
+		struct LayoutKeyHash
+		{
+			std::size_t operator()(const LayoutKey& key) const;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<DescriptorLayoutCaches> m_layoutCache;
+
+		struct DescriptorLayoutCaches
+		{
+			inline DescriptorLayoutCaches() : layouts()
+			{}
+
+			std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHash> layouts;
+		};
+
+	private:
+		static LayoutKey CreateKey(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags,
+			const std::vector<VkDescriptorBindingFlagsEXT>& bindingFlags);
+	};
+}
+
+#include "DescriptorLayoutCache.inl"
+
+#endif //DESCRIPTORLAYOUTCACHE_HPP
\ No newline at end of file
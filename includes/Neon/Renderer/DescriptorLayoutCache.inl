@@ -0,0 +1,7 @@
+namespace Zx
+{
+	inline std::size_t DescriptorLayoutCache::GetLayoutCount() const
+	{
+		return m_layoutCache->layouts.size();
+	}
+}
\ No newline at end of file
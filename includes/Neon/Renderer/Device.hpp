@@ -5,6 +5,8 @@
 #include <vector>
 #include <vulkan/vulkan.h>
 
+#include <Neon/Core/RetireQueue.hpp>
+
 namespace Zx
 {
 	class SwapChain;
@@ -26,6 +28,7 @@ namespace Zx
 		~Device();
 
 		bool CreateDevice();
+		void BeginFrame();
 
 		//Getters and Setters
 
@@ -47,22 +50,58 @@ namespace Zx
 		struct Devices
 		{
 			inline Devices() : logicalDevice(VK_NULL_HANDLE), physicalDevice(VK_NULL_HANDLE), graphicsIndexFamily(UINT32_MAX),
-				presentIndexFamily(UINT32_MAX), graphicsQueue(VK_NULL_HANDLE), presentQueue(VK_NULL_HANDLE)
+				presentIndexFamily(UINT32_MAX), computeIndexFamily(UINT32_MAX), graphicsQueue(VK_NULL_HANDLE), presentQueue(VK_NULL_HANDLE), computeQueue(VK_NULL_HANDLE)
+				, descriptorIndexing(false), multiDrawIndirect(false), drawIndirectFirstInstance(false), samplerAnisotropy(false), textureCompressionBC(false)
+				, textureCompressionETC2(false), textureCompressionASTC(false), memoryBudget(false), presentWait(false), drawIndexedIndirectCount(nullptr)
+				, waitForPresent(nullptr), frameCounter()
 			{}
 
 			VkDevice logicalDevice;
 			VkPhysicalDevice physicalDevice;
 			uint32_t graphicsIndexFamily;
 			uint32_t presentIndexFamily;
+			uint32_t computeIndexFamily;
 			VkQueue graphicsQueue;
 			VkQueue presentQueue;
+			VkQueue computeQueue;
+
+			bool descriptorIndexing;
+			bool multiDrawIndirect;
+
+			// Without it, the indirect commands must start at the instance 0
+			bool drawIndirectFirstInstance;
+			bool samplerAnisotropy;
+
+			// Compressed formats families, each format must still be checked with IsFormatSampled
+			bool textureCompressionBC;
+			bool textureCompressionETC2;
+			bool textureCompressionASTC;
+
+			// VK_EXT_memory_budget, the budget and usage of each heap
+			bool memoryBudget;
+
+			// VK_KHR_present_id and VK_KHR_present_wait, the frame pacer then waits for the images to reach the screen
+			bool presentWait;
+
+			// nullptr when VK_KHR_draw_indirect_count is not supported
+			PFN_vkCmdDrawIndexedIndirectCountKHR drawIndexedIndirectCount;
+
+			// nullptr when presentWait is false
+			PFN_vkWaitForPresentKHR waitForPresent;
+
+			// Shared by the objects of the device, the resources they retire are released once the frames in flight which may use them are over
+			FrameCounter frameCounter;
 		};
 
 	private:
 		bool CreateLogicalDevice();
 		bool FoundPhysicalDevice();
 		bool CheckFamilyQueue(const VkPhysicalDevice& device);
+		void FindComputeFamily();
 		bool IsExtensionAvailable();
+		bool IsExtensionSupported(const char* extensionName) const;
+		bool QueryDescriptorIndexing(VkPhysicalDeviceDescriptorIndexingFeaturesEXT& enabledFeatures) const;
+		bool QueryPresentWait(VkPhysicalDevicePresentIdFeaturesKHR& presentIdFeatures, VkPhysicalDevicePresentWaitFeaturesKHR& presentWaitFeatures) const;
 
 		void GetDeviceQueue();
 
@@ -0,0 +1,117 @@
+#ifndef FRAMEPACER_HPP
+#define FRAMEPACER_HPP
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Zx
+{
+	class Device;
+	class SwapChain;
+
+	struct FramePacerInfo
+	{
+		inline FramePacerInfo() : maxFrameRate(0.0), justInTime(true), safetyMargin(0.001), spinTime(0.002)
+		{}
+
+		// 0 leaves the frame rate to the present mode
+		double maxFrameRate;
+
+		// The CPU starts a frame as late as it can still be shown at the next refresh, the input it reads is then as recent as possible
+		bool justInTime;
+
+		// Seconds kept between the predicted end of a frame and its deadline
+		double safetyMargin;
+
+		// The end of a wait yields instead of sleeping for this many seconds, the scheduler of the system may oversleep by a whole quantum
+		double spinTime;
+	};
+
+	class FramePacer
+	{
+		struct FramePacers;
+
+	public:
+		FramePacer() = default;
+		FramePacer(Device& device, SwapChain& swapChain, const FramePacerInfo& info = FramePacerInfo(), uint32_t frameCount = 3);
+		FramePacer(const FramePacer& framePacer);
+
+		~FramePacer();
+
+		void Wait();
+		void BeginFrame(uint32_t frameIndex);
+		void EndFrame();
+
+		void WriteBeginTimestamp(VkCommandBuffer commandBuffer);
+		void WriteEndTimestamp(VkCommandBuffer commandBuffer);
+
+		const void* NextPresentId();
+
+		//Getters and Setters
+
+		inline bool IsPresentWaitEnabled() const;
+		inline double GetCpuTime() const;
+		inline double GetGpuTime() const;
+		inline double GetDisplayInterval() const;
+
+		inline void SetMaxFrameRate(double maxFrameRate);
+
+		FramePacer& operator=(FramePacer&& framePacer) noexcept;
+
+	private:
+		typedef std::chrono::steady_clock Clock;
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<SwapChain> m_swapChain;
+		std::shared_ptr<FramePacers> m_framePacer;
+
+		struct FramePacers
+		{
+			inline FramePacers() : info(), queryPool(VK_NULL_HANDLE), timestampPeriod(0.0), timestampMask(0), frameCount(0), frameIndex(0), written(), presentWait(false)
+				, presentId(0), presentedId(0), presentInfo(), presentSwapChain(VK_NULL_HANDLE), frameStart(), capTime(), presentTime(), gpuBusyUntil(), cpuTime(0.0), gpuTime(0.0)
+				, displayInterval(0.0)
+			{}
+
+			FramePacerInfo info;
+
+			// Two timestamps per frame in flight, around the commands of the frame
+			VkQueryPool queryPool;
+			double timestampPeriod;
+			uint64_t timestampMask;
+			uint32_t frameCount;
+			uint32_t frameIndex;
+			std::vector<bool> written;
+
+			// The id of the last present and the last one seen on the screen, 0 is never presented
+			bool presentWait;
+			uint64_t presentId;
+			uint64_t presentedId;
+			VkPresentIdKHR presentInfo;
+			VkSwapchainKHR presentSwapChain;
+
+			Clock::time_point frameStart;
+			Clock::time_point capTime;
+			Clock::time_point presentTime;
+			Clock::time_point gpuBusyUntil;
+
+			// In seconds, the times follow their peaks at once and come down slowly so a late frame is not predicted twice
+			double cpuTime;
+			double gpuTime;
+			double displayInterval;
+		};
+
+	private:
+		bool CreateQueryPool();
+
+		bool WaitForPresent();
+		void SleepUntil(Clock::time_point target) const;
+
+		static double Track(double average, double sample);
+	};
+}
+
+#include "FramePacer.inl"
+
+#endif //FRAMEPACER_HPP
\ No newline at end of file
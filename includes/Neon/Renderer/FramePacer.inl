@@ -0,0 +1,27 @@
+namespace Zx
+{
+	inline bool FramePacer::IsPresentWaitEnabled() const
+	{
+		return m_framePacer->presentWait;
+	}
+
+	inline double FramePacer::GetCpuTime() const
+	{
+		return m_framePacer->cpuTime;
+	}
+
+	inline double FramePacer::GetGpuTime() const
+	{
+		return m_framePacer->gpuTime;
+	}
+
+	inline double FramePacer::GetDisplayInterval() const
+	{
+		return m_framePacer->displayInterval;
+	}
+
+	inline void FramePacer::SetMaxFrameRate(double maxFrameRate)
+	{
+		m_framePacer->info.maxFrameRate = maxFrameRate;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef GEOMETRYPOOL_HPP
+#define GEOMETRYPOOL_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/RangeAllocator.hpp>
+#include <Neon/Core/RetireQueue.hpp>
+#include <Neon/Renderer/Buffer.hpp>
+#include <Neon/Renderer/VertexBuffer.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	struct MeshRange
+	{
+		inline MeshRange() : firstVertex(0), vertexCount(0), firstIndex(0), indexCount(0)
+		{}
+
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+		uint32_t firstIndex;
+		uint32_t indexCount;
+	};
+
+	class GeometryPool
+	{
+		struct GeometryPools;
+
+	public:
+		GeometryPool() = default;
+		GeometryPool(Device& device, uint32_t vertexCapacity, uint32_t indexCapacity, uint32_t stride = sizeof(VertexData), VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+		GeometryPool(const GeometryPool& geometryPool);
+
+		~GeometryPool();
+
+		void BeginFrame();
+
+		bool AddMesh(const void* vertices, uint32_t vertexCount, const std::vector<uint32_t>& indices, MeshRange& mesh);
+		bool AddMesh(const std::vector<VertexData>& vertices, const std::vector<uint32_t>& indices, MeshRange& mesh);
+		bool AddLod(const MeshRange& mesh, const std::vector<uint32_t>& indices, MeshRange& lod);
+		void RemoveMesh(const MeshRange& mesh);
+
+		void Bind(VkCommandBuffer commandBuffer, uint32_t binding = 0) const;
+		void Draw(VkCommandBuffer commandBuffer, const MeshRange& mesh, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline const VkBuffer& GetVertexBuffer() const;
+		inline const VkBuffer& GetIndexBuffer() const;
+		inline VkIndexType GetIndexType() const;
+		inline uint32_t GetStride() const;
+		inline uint32_t GetFreeVertexCount() const;
+		inline uint32_t GetFreeIndexCount() const;
+
+		GeometryPool& operator=(GeometryPool&& geometryPool) noexcept;
+
+	private:
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<GeometryPools> m_geometryPool;
+
+		struct GeometryPools
+		{
+			inline GeometryPools() : vertexBuffer(), indexBuffer(), vertexRanges(), indexRanges(), retiredMeshes(), stride(0), indexType(VK_INDEX_TYPE_UINT32)
+			{}
+
+			Buffer vertexBuffer;
+			Buffer indexBuffer;
+
+			RangeAllocator vertexRanges;
+			RangeAllocator indexRanges;
+			RetireQueue<MeshRange> retiredMeshes;
+
+			uint32_t stride;
+			VkIndexType indexType;
+		};
+
+	private:
+		bool UploadIndices(const std::vector<uint32_t>& indices, uint32_t firstIndex);
+		void FreeMesh(const MeshRange& mesh);
+	};
+}
+
+#include "GeometryPool.inl"
+
+#endif //GEOMETRYPOOL_HPP
\ No newline at end of file
@@ -0,0 +1,37 @@
+namespace Zx
+{
+	inline bool GeometryPool::IsValid() const
+	{
+		return (m_geometryPool != nullptr) && m_geometryPool->vertexBuffer.IsValid() && m_geometryPool->indexBuffer.IsValid();
+	}
+
+	inline const VkBuffer& GeometryPool::GetVertexBuffer() const
+	{
+		return m_geometryPool->vertexBuffer.GetBuffer();
+	}
+
+	inline const VkBuffer& GeometryPool::GetIndexBuffer() const
+	{
+		return m_geometryPool->indexBuffer.GetBuffer();
+	}
+
+	inline VkIndexType GeometryPool::GetIndexType() const
+	{
+		return m_geometryPool->indexType;
+	}
+
+	inline uint32_t GeometryPool::GetStride() const
+	{
+		return m_geometryPool->stride;
+	}
+
+	inline uint32_t GeometryPool::GetFreeVertexCount() const
+	{
+		return static_cast<uint32_t>(m_geometryPool->vertexRanges.GetFreeSize());
+	}
+
+	inline uint32_t GeometryPool::GetFreeIndexCount() const
+	{
+		return static_cast<uint32_t>(m_geometryPool->indexRanges.GetFreeSize());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef IMAGE_HPP
+#define IMAGE_HPP
+
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/MemoryAllocator.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	class Image
+	{
+		struct Images;
+
+	public:
+		Image() = default;
+		Image(Device& device, MemoryAllocator& allocator, uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, uint32_t mipLevels = 1,
+			VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT, VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT);
+		Image(const Image& image);
+
+		~Image();
+
+		void Transition(VkCommandBuffer commandBuffer, VkImageLayout layout);
+		bool GenerateMips(VkCommandBuffer commandBuffer);
+
+		static uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline const VkImage& GetImage() const;
+		inline const VkImageView& GetImageView() const;
+		inline const VkImageView& GetDepthView() const;
+		inline VkFormat GetFormat() const;
+		inline VkExtent2D GetExtent() const;
+		inline uint32_t GetMipLevels() const;
+		inline VkImageAspectFlags GetAspect() const;
+		inline VkSampleCountFlagBits GetSampleCount() const;
+		inline VkImageLayout GetLayout() const;
+
+		Image& operator=(Image&& image) noexcept;
+
+	private:
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<Images> m_image;
+
+		struct Images
+		{
+			inline Images() : image(VK_NULL_HANDLE), imageView(VK_NULL_HANDLE), depthView(VK_NULL_HANDLE), allocator(), allocation(), format(VK_FORMAT_UNDEFINED), extent(), mipLevels(1)
+				, aspect(VK_IMAGE_ASPECT_COLOR_BIT), usage(0), samples(VK_SAMPLE_COUNT_1_BIT), layout(VK_IMAGE_LAYOUT_UNDEFINED)
+			{}
+
+			VkImage image;
+			VkImageView imageView;
+
+			// A depth stencil image read by a shader also needs a view of its depth alone, descriptors take a single aspect
+			VkImageView depthView;
+
+			MemoryAllocator allocator;
+			MemoryAllocation allocation;
+
+			VkFormat format;
+			VkExtent2D extent;
+			uint32_t mipLevels;
+			VkImageAspectFlags aspect;
+			VkImageUsageFlags usage;
+			VkSampleCountFlagBits samples;
+
+			// The layout of every mip level once the recorded commands are executed
+			VkImageLayout layout;
+		};
+
+	private:
+		bool CreateImage();
+		bool CreateImageView();
+
+		void Barrier(VkCommandBuffer commandBuffer, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t baseMipLevel, uint32_t mipLevelCount) const;
+
+		static void GetLayoutAccess(VkImageLayout layout, VkAccessFlags& access, VkPipelineStageFlags& stages);
+	};
+}
+
+#include "Image.inl"
+
+#endif //IMAGE_HPP
\ No newline at end of file
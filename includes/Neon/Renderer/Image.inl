@@ -0,0 +1,52 @@
+namespace Zx
+{
+	inline bool Image::IsValid() const
+	{
+		return (m_image != nullptr) && (m_image->image != VK_NULL_HANDLE) && (m_image->imageView != VK_NULL_HANDLE);
+	}
+
+	inline const VkImage& Image::GetImage() const
+	{
+		return m_image->image;
+	}
+
+	inline const VkImageView& Image::GetImageView() const
+	{
+		return m_image->imageView;
+	}
+
+	inline const VkImageView& Image::GetDepthView() const
+	{
+		return (m_image->depthView != VK_NULL_HANDLE) ? m_image->depthView : m_image->imageView;
+	}
+
+	inline VkFormat Image::GetFormat() const
+	{
+		return m_image->format;
+	}
+
+	inline VkExtent2D Image::GetExtent() const
+	{
+		return m_image->extent;
+	}
+
+	inline uint32_t Image::GetMipLevels() const
+	{
+		return m_image->mipLevels;
+	}
+
+	inline VkImageAspectFlags Image::GetAspect() const
+	{
+		return m_image->aspect;
+	}
+
+	inline VkSampleCountFlagBits Image::GetSampleCount() const
+	{
+		return m_image->samples;
+	}
+
+	inline VkImageLayout Image::GetLayout() const
+	{
+		return m_image->layout;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef IMAGEUPLOADER_HPP
+#define IMAGEUPLOADER_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/RetireQueue.hpp>
+#include <Neon/Renderer/Buffer.hpp>
+#include <Neon/Renderer/Image.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	class ImageUploader
+	{
+		struct ImageUploaders;
+
+	public:
+		ImageUploader() = default;
+		ImageUploader(Device& device, VkDeviceSize frameSize, uint32_t frameCount = 3);
+		ImageUploader(const ImageUploader& imageUploader);
+
+		~ImageUploader();
+
+		void BeginFrame(uint32_t frameIndex);
+		bool Upload(const Image& image, const void* data, VkDeviceSize size, uint32_t mipLevel = 0);
+		void GenerateMips(const Image& image);
+		bool Record(VkCommandBuffer commandBuffer);
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline std::size_t GetPendingCount() const;
+
+		ImageUploader& operator=(ImageUploader&& imageUploader) noexcept;
+
+	private:
+		struct PendingUpload
+		{
+			inline PendingUpload() : image(), stagingBuffer(), copies(), generateMips(false)
+			{}
+
+			Image image;
+			Buffer stagingBuffer;
+			std::vector<VkBufferImageCopy> copies;
+			bool generateMips;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<ImageUploaders> m_imageUploader;
+
+		struct ImageUploaders
+		{
+			inline ImageUploaders() : stagingBuffer(), pendingUploads(), retiredBuffers(), alignment(16), frameSize(0), frameCount(0), frameBegin(0), head(0)
+				, frameOpen(false)
+			{}
+
+			Buffer stagingBuffer;
+			std::vector<PendingUpload> pendingUploads;
+
+			// Dedicated staging buffers of the uploads larger than a frame, released once their frame is over
+			RetireQueue<Buffer> retiredBuffers;
+
+			VkDeviceSize alignment;
+			VkDeviceSize frameSize;
+			uint32_t frameCount;
+
+			VkDeviceSize frameBegin;
+			VkDeviceSize head;
+
+			// The region of the frame is only written between BeginFrame and Record, it is read by the command buffer of the frame
+			bool frameOpen;
+		};
+
+	private:
+		bool CreateStagingBuffer();
+		PendingUpload& GetPendingUpload(const Image& image, const Buffer& stagingBuffer);
+	};
+}
+
+#include "ImageUploader.inl"
+
+#endif //IMAGEUPLOADER_HPP
\ No newline at end of file
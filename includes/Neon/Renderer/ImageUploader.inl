@@ -0,0 +1,12 @@
+namespace Zx
+{
+	inline bool ImageUploader::IsValid() const
+	{
+		return (m_imageUploader != nullptr) && m_imageUploader->stagingBuffer.IsValid();
+	}
+
+	inline std::size_t ImageUploader::GetPendingCount() const
+	{
+		return m_imageUploader->pendingUploads.size();
+	}
+}
\ No newline at end of file
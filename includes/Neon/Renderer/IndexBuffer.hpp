@@ -0,0 +1,47 @@
+#ifndef INDEXBUFFER_HPP
+#define INDEXBUFFER_HPP
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/Buffer.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	class IndexBuffer
+	{
+	public:
+		IndexBuffer() = default;
+		IndexBuffer(Device& device, const std::vector<uint16_t>& indices);
+		IndexBuffer(Device& device, const std::vector<uint32_t>& indices);
+		IndexBuffer(const IndexBuffer& indexBuffer);
+
+		~IndexBuffer();
+
+		void Bind(VkCommandBuffer commandBuffer) const;
+
+		//Getters
+
+		inline const VkBuffer& GetIndexBuffer() const;
+		inline VkIndexType GetIndexType() const;
+		inline uint32_t GetIndexCount() const;
+
+		IndexBuffer& operator=(IndexBuffer&& indexBuffer) noexcept;
+
+	private:
+		Buffer m_buffer;
+
+		VkIndexType m_indexType;
+		uint32_t m_indexCount;
+
+	private:
+		void CreateIndexBuffer(Device& device, const void* indices, VkDeviceSize size);
+	};
+}
+
+#include "IndexBuffer.inl"
+
+#endif //INDEXBUFFER_HPP
\ No newline at end of file
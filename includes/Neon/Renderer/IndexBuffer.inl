@@ -0,0 +1,17 @@
+namespace Zx
+{
+	inline const VkBuffer& IndexBuffer::GetIndexBuffer() const
+	{
+		return m_buffer.GetBuffer();
+	}
+
+	inline VkIndexType IndexBuffer::GetIndexType() const
+	{
+		return m_indexType;
+	}
+
+	inline uint32_t IndexBuffer::GetIndexCount() const
+	{
+		return m_indexCount;
+	}
+}
\ No newline at end of file
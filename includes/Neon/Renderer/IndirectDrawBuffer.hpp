@@ -0,0 +1,84 @@
+#ifndef INDIRECTDRAWBUFFER_HPP
+#define INDIRECTDRAWBUFFER_HPP
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/Buffer.hpp>
+
+namespace Zx
+{
+	class Device;
+	class InstanceBuffer;
+
+	struct MeshRange;
+
+	class IndirectDrawBuffer
+	{
+		struct IndirectDrawBuffers;
+
+	public:
+		IndirectDrawBuffer() = default;
+		IndirectDrawBuffer(Device& device, uint32_t maxDraws, uint32_t frameCount = 3);
+		IndirectDrawBuffer(const IndirectDrawBuffer& indirectDrawBuffer);
+
+		~IndirectDrawBuffer();
+
+		void BeginFrame(uint32_t frameIndex);
+		bool AddDraw(const MeshRange& mesh, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+		bool Flush();
+
+		void ResetCount(VkCommandBuffer commandBuffer) const;
+
+		void Draw(VkCommandBuffer commandBuffer, const InstanceBuffer& instanceBuffer, uint32_t binding = 1) const;
+		void DrawCount(VkCommandBuffer commandBuffer) const;
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline bool IsCountSupported() const;
+		inline const VkBuffer& GetBuffer() const;
+		inline VkDeviceSize GetCountOffset() const;
+		inline VkDeviceSize GetCommandOffset() const;
+		inline VkDeviceSize GetCommandRange() const;
+		inline uint32_t GetDrawCount() const;
+		inline uint32_t GetMaxDraws() const;
+
+		IndirectDrawBuffer& operator=(IndirectDrawBuffer&& indirectDrawBuffer) noexcept;
+
+	private:
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<IndirectDrawBuffers> m_indirectBuffer;
+
+		struct IndirectDrawBuffers
+		{
+			inline IndirectDrawBuffers() : buffer(), countSupported(false), maxDraws(0), frameCount(0), countStride(0), frameSize(0), frameBegin(0), drawCount(0), firstInstances()
+			{}
+
+			Buffer buffer;
+			bool countSupported;
+
+			uint32_t maxDraws;
+			uint32_t frameCount;
+
+			VkDeviceSize countStride;
+			VkDeviceSize frameSize;
+
+			VkDeviceSize frameBegin;
+			uint32_t drawCount;
+
+			// The first instance of each command of the frame, written as 0 in the commands without drawIndirectFirstInstance
+			std::vector<uint32_t> firstInstances;
+		};
+
+	private:
+		void DrawCommands(VkCommandBuffer commandBuffer, uint32_t drawCount) const;
+
+		static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment);
+	};
+}
+
+#include "IndirectDrawBuffer.inl"
+
+#endif //INDIRECTDRAWBUFFER_HPP
\ No newline at end of file
@@ -0,0 +1,42 @@
+namespace Zx
+{
+	inline bool IndirectDrawBuffer::IsValid() const
+	{
+		return (m_indirectBuffer != nullptr) && m_indirectBuffer->buffer.IsValid();
+	}
+
+	inline bool IndirectDrawBuffer::IsCountSupported() const
+	{
+		return m_indirectBuffer->countSupported;
+	}
+
+	inline const VkBuffer& IndirectDrawBuffer::GetBuffer() const
+	{
+		return m_indirectBuffer->buffer.GetBuffer();
+	}
+
+	inline VkDeviceSize IndirectDrawBuffer::GetCountOffset() const
+	{
+		return m_indirectBuffer->frameBegin;
+	}
+
+	inline VkDeviceSize IndirectDrawBuffer::GetCommandOffset() const
+	{
+		return m_indirectBuffer->frameBegin + m_indirectBuffer->countStride;
+	}
+
+	inline VkDeviceSize IndirectDrawBuffer::GetCommandRange() const
+	{
+		return m_indirectBuffer->maxDraws * sizeof(VkDrawIndexedIndirectCommand);
+	}
+
+	inline uint32_t IndirectDrawBuffer::GetDrawCount() const
+	{
+		return m_indirectBuffer->drawCount;
+	}
+
+	inline uint32_t IndirectDrawBuffer::GetMaxDraws() const
+	{
+		return m_indirectBuffer->maxDraws;
+	}
+}
\ No newline at end of file
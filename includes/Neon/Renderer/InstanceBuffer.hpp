@@ -0,0 +1,70 @@
+#ifndef INSTANCEBUFFER_HPP
+#define INSTANCEBUFFER_HPP
+
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/Buffer.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	struct PipelineInfo;
+
+	struct InstanceData
+	{
+		float transform[16];
+		float color[4];
+	};
+
+	class InstanceBuffer
+	{
+		struct InstanceBuffers;
+
+	public:
+		InstanceBuffer() = default;
+		InstanceBuffer(Device& device, uint32_t maxInstances, uint32_t frameCount = 3);
+		InstanceBuffer(const InstanceBuffer& instanceBuffer);
+
+		~InstanceBuffer();
+
+		void BeginFrame(uint32_t frameIndex);
+		InstanceData* Allocate(uint32_t instanceCount, uint32_t& firstInstance);
+		bool Flush();
+
+		void Bind(VkCommandBuffer commandBuffer, uint32_t binding = 1, uint32_t firstInstance = 0) const;
+
+		static void AddVertexInput(PipelineInfo& info, uint32_t binding = 1, uint32_t firstLocation = 2);
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline uint32_t GetMaxInstances() const;
+		inline uint32_t GetInstanceCount() const;
+
+		InstanceBuffer& operator=(InstanceBuffer&& instanceBuffer) noexcept;
+
+	private:
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<InstanceBuffers> m_instanceBuffer;
+
+		struct InstanceBuffers
+		{
+			inline InstanceBuffers() : buffer(), maxInstances(0), frameCount(0), frameIndex(0), instanceCount(0)
+			{}
+
+			Buffer buffer;
+
+			uint32_t maxInstances;
+			uint32_t frameCount;
+
+			uint32_t frameIndex;
+			uint32_t instanceCount;
+		};
+	};
+}
+
+#include "InstanceBuffer.inl"
+
+#endif //INSTANCEBUFFER_HPP
\ No newline at end of file
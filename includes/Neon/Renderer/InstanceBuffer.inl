@@ -0,0 +1,17 @@
+namespace Zx
+{
+	inline bool InstanceBuffer::IsValid() const
+	{
+		return (m_instanceBuffer != nullptr) && m_instanceBuffer->buffer.IsValid();
+	}
+
+	inline uint32_t InstanceBuffer::GetMaxInstances() const
+	{
+		return m_instanceBuffer->maxInstances;
+	}
+
+	inline uint32_t InstanceBuffer::GetInstanceCount() const
+	{
+		return m_instanceBuffer->instanceCount;
+	}
+}
\ No newline at end of file
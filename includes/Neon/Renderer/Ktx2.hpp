@@ -0,0 +1,46 @@
+#ifndef KTX2_HPP
+#define KTX2_HPP
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Zx
+{
+	class File;
+
+	/*
+	@brief : A mip level of a KTX2 container, located in its content
+	*/
+	struct Ktx2Level
+	{
+		inline Ktx2Level() : offset(0), size(0)
+		{}
+
+		std::size_t offset;
+		std::size_t size;
+	};
+
+	/*
+	@brief : A 2D image read from a KTX2 container, the first level is the largest one
+	*/
+	struct Ktx2Image
+	{
+		inline Ktx2Image() : format(VK_FORMAT_UNDEFINED), width(0), height(0), generateMips(false), content(), levels()
+		{}
+
+		VkFormat format;
+		uint32_t width;
+		uint32_t height;
+
+		// The container asks for the mip chain to be generated from its single level
+		bool generateMips;
+
+		std::vector<char> content;
+		std::vector<Ktx2Level> levels;
+	};
+
+	bool LoadKtx2(const File& file, Ktx2Image& image);
+}
+
+#endif //KTX2_HPP
\ No newline at end of file
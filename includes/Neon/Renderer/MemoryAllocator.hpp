@@ -0,0 +1,94 @@
+#ifndef MEMORYALLOCATOR_HPP
+#define MEMORYALLOCATOR_HPP
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/RangeAllocator.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	struct MemoryAllocation
+	{
+		inline MemoryAllocation() : memory(VK_NULL_HANDLE), offset(0), size(0), memoryType(UINT32_MAX), block(UINT32_MAX)
+		{}
+
+		VkDeviceMemory memory;
+		VkDeviceSize offset;
+		VkDeviceSize size;
+		uint32_t memoryType;
+		uint32_t block;
+	};
+
+	class MemoryAllocator
+	{
+		struct MemoryAllocators;
+
+	public:
+		MemoryAllocator() = default;
+		MemoryAllocator(Device& device, VkDeviceSize blockSize = 64 * 1024 * 1024);
+		MemoryAllocator(const MemoryAllocator& allocator);
+
+		~MemoryAllocator();
+
+		bool Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags memoryProperties, MemoryAllocation& allocation);
+		void Free(const MemoryAllocation& allocation);
+
+		bool IsMemoryTypeAvailable(uint32_t memoryTypeBits, VkMemoryPropertyFlags memoryProperties) const;
+
+		bool GetMemoryBudget(VkDeviceSize& budget, VkDeviceSize& usage) const;
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline VkDeviceSize GetBlockSize() const;
+		inline VkDeviceSize GetAllocatedSize() const;
+		inline VkDeviceSize GetUsedSize() const;
+
+		MemoryAllocator& operator=(MemoryAllocator&& allocator) noexcept;
+
+	private:
+		struct MemoryBlock
+		{
+			inline MemoryBlock() : memory(VK_NULL_HANDLE), size(0), memoryType(UINT32_MAX), dedicated(false), ranges()
+			{}
+
+			VkDeviceMemory memory;
+			VkDeviceSize size;
+			uint32_t memoryType;
+			bool dedicated;
+
+			RangeAllocator ranges;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<MemoryAllocators> m_allocator;
+
+		struct MemoryAllocators
+		{
+			inline MemoryAllocators() : blocks(), memoryProperties(), blockSize(0), granularity(1), allocatedSize(0), usedSize(0)
+			{}
+
+			std::vector<MemoryBlock> blocks;
+			VkPhysicalDeviceMemoryProperties memoryProperties;
+
+			VkDeviceSize blockSize;
+			VkDeviceSize granularity;
+
+			VkDeviceSize allocatedSize;
+			VkDeviceSize usedSize;
+		};
+
+	private:
+		uint32_t FindMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags memoryProperties) const;
+		bool AllocateBlock(uint32_t memoryType, VkDeviceSize size, bool dedicated, uint32_t& block);
+		void FreeBlock(uint32_t block);
+	};
+}
+
+#include "MemoryAllocator.inl"
+
+#endif //MEMORYALLOCATOR_HPP
\ No newline at end of file
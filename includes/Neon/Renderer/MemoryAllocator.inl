@@ -0,0 +1,22 @@
+namespace Zx
+{
+	inline bool MemoryAllocator::IsValid() const
+	{
+		return m_allocator != nullptr;
+	}
+
+	inline VkDeviceSize MemoryAllocator::GetBlockSize() const
+	{
+		return m_allocator->blockSize;
+	}
+
+	inline VkDeviceSize MemoryAllocator::GetAllocatedSize() const
+	{
+		return m_allocator->allocatedSize;
+	}
+
+	inline VkDeviceSize MemoryAllocator::GetUsedSize() const
+	{
+		return m_allocator->usedSize;
+	}
+}
\ No newline at end of file
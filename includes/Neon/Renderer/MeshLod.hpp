@@ -0,0 +1,29 @@
+#ifndef MESHLOD_HPP
+#define MESHLOD_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <Neon/Renderer/GeometryPool.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : A level of detail of a mesh, its error is the distance to the full mesh in the units of the positions
+	*/
+	struct MeshLod
+	{
+		inline MeshLod() : mesh(), error(0.0f)
+		{}
+
+		MeshRange mesh;
+		float error;
+	};
+
+	bool BuildMeshLods(GeometryPool& geometryPool, const MeshRange& mesh, const std::vector<uint32_t>& indices, const float* positions, uint32_t positionStride,
+		std::vector<MeshLod>& lods, uint32_t maxLodCount = 8, float reduction = 0.5f);
+
+	uint32_t SelectMeshLod(const std::vector<MeshLod>& lods, const float* center, float radius, const float* viewProjection, float viewportHeight, float maxPixelError = 1.0f);
+}
+
+#endif //MESHLOD_HPP
\ No newline at end of file
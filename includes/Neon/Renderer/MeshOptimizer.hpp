@@ -0,0 +1,41 @@
+#ifndef MESHOPTIMIZER_HPP
+#define MESHOPTIMIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Zx
+{
+	/*
+	@brief : Measurements of the cost of drawing a mesh, lower is better for all of them
+	*/
+	struct MeshStatistics
+	{
+		inline MeshStatistics() : acmr(0.0f), atvr(0.0f), overdraw(0.0f), overfetch(0.0f)
+		{}
+
+		// Vertex shader invocations per triangle, between 0.5 and 3
+		float acmr;
+		// Vertex shader invocations per referenced vertex, 1 is optimal
+		float atvr;
+		// Shaded pixels per covered pixel, 1 is optimal
+		float overdraw;
+		// Bytes read by the vertex fetch per byte of referenced vertices, 1 is optimal
+		float overfetch;
+	};
+
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = 16);
+	void OptimizeOverdraw(std::vector<uint32_t>& indices, const float* positions, uint32_t vertexCount, uint32_t positionStride, uint32_t cacheSize = 16,
+		float threshold = 1.05f);
+	uint32_t OptimizeVertexFetch(void* vertices, uint32_t vertexCount, uint32_t stride, std::vector<uint32_t>& indices);
+
+	float SimplifyMesh(const std::vector<uint32_t>& indices, const float* positions, uint32_t vertexCount, uint32_t positionStride, std::size_t targetIndexCount,
+		float targetError, std::vector<uint32_t>& result);
+
+	uint32_t OptimizeMesh(void* vertices, uint32_t vertexCount, uint32_t stride, std::vector<uint32_t>& indices, uint32_t cacheSize = 16, float threshold = 1.05f);
+
+	MeshStatistics AnalyzeMesh(const void* vertices, uint32_t vertexCount, uint32_t stride, const std::vector<uint32_t>& indices, uint32_t cacheSize = 16);
+}
+
+#endif //MESHOPTIMIZER_HPP
\ No newline at end of file
@@ -2,7 +2,12 @@
 #define PIPELINE_HPP
 
 #include <vulkan/vulkan.h>
+#include <cstddef>
 #include <memory>
+#include <vector>
+
+#include <Neon/Core/String.hpp>
+#include <Neon/Renderer/VertexBuffer.hpp>
 
 namespace Zx
 {
@@ -10,14 +15,41 @@ namespace Zx
 	class RenderPass;
 	class SwapChain;
 
-	template <class O, class F>
-	class SmartDeleter;
+	struct PipelineInfo
+	{
+		// The vertex input defaults to a single binding of VertexData
+		inline PipelineInfo() : descriptorSetLayouts(), pushConstantRanges(), vertexBindings({ { 0, sizeof(VertexData), VK_VERTEX_INPUT_RATE_VERTEX } })
+			, vertexAttributes({ { 0, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(VertexData, x) }, { 1, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(VertexData, r) } })
+			, topology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP), depthTest(true), depthWrite(true), depthCompareOp(VK_COMPARE_OP_LESS_OR_EQUAL)
+			, vertexShader("C:/Users/Lucas/Documents/Neon/shaders/vert.spv"), fragmentShader("C:/Users/Lucas/Documents/Neon/shaders/frag.spv"), lighting(false)
+		{}
+
+		std::vector<VkDescriptorSetLayout> descriptorSetLayouts;
+		std::vector<VkPushConstantRange> pushConstantRanges;
+		std::vector<VkVertexInputBindingDescription> vertexBindings;
+		std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+		VkPrimitiveTopology topology;
+
+		// Ignored without a depth attachment, with a depth pre-pass the color pipeline only tests for the equal depth
+		bool depthTest;
+		bool depthWrite;
+		VkCompareOp depthCompareOp;
+
+		//Chemin absolu pour RenderDoc
+		String vertexShader;
+		String fragmentShader;
+
+		// A lighting pipeline draws in the lighting subpass of a deferred render pass, without depth state, the others draw in its geometry subpass
+		bool lighting;
+	};
 
 	class Pipeline
 	{
+		struct Pipelines;
+
 	public:
 		Pipeline() = default;
-		Pipeline(Device& device, RenderPass& renderPass, SwapChain& swapChain);
+		Pipeline(Device& device, RenderPass& renderPass, SwapChain& swapChain, const PipelineInfo& info = PipelineInfo());
 		Pipeline(const Pipeline& pipeline);
 
 		~Pipeline();
@@ -25,6 +57,8 @@ namespace Zx
 		//Getter
 
 		inline const VkPipeline& GetPipeline() const;
+		inline const VkPipeline& GetDepthPipeline() const;
+		inline const VkPipelineLayout& GetPipelineLayout() const;
 
 		Pipeline& operator=(Pipeline&&) noexcept;
 
@@ -33,11 +67,23 @@ namespace Zx
 		std::shared_ptr<Device> m_device;
 		std::shared_ptr<RenderPass> m_renderPass;
 
-		VkPipeline m_pipeline;
+		std::shared_ptr<Pipelines> m_pipeline;
+
+		PipelineInfo m_info;
+
+		struct Pipelines
+		{
+			inline Pipelines() : pipeline(VK_NULL_HANDLE), depthPipeline(VK_NULL_HANDLE), pipelineLayout(VK_NULL_HANDLE)
+			{}
+
+			VkPipeline pipeline;
+			VkPipeline depthPipeline;
+			VkPipelineLayout pipelineLayout;
+		};
+
 	private:
 		bool CreatePipeline();
-
-		SmartDeleter<VkPipelineLayout, PFN_vkDestroyPipelineLayout> CreatePipelineLayout();
+		bool CreatePipelineLayout();
 	};
 }
 
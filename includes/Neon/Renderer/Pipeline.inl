@@ -2,6 +2,16 @@ namespace Zx
 {
 	inline const VkPipeline& Pipeline::GetPipeline() const
 	{
-		return m_pipeline;
+		return m_pipeline->pipeline;
+	}
+
+	inline const VkPipeline& Pipeline::GetDepthPipeline() const
+	{
+		return m_pipeline->depthPipeline;
+	}
+
+	inline const VkPipelineLayout& Pipeline::GetPipelineLayout() const
+	{
+		return m_pipeline->pipelineLayout;
 	}
 }
\ No newline at end of file
@@ -15,6 +15,18 @@ namespace Zx
 {
 	class String;	
 
+	/*
+	@brief : What the events of a batch changed, resize stays set until the caller handles it
+	*/
+	struct WindowEvents
+	{
+		inline WindowEvents() : resize(false), close(false)
+		{}
+
+		bool resize;
+		bool close;
+	};
+
 	class Platform
 	{
 	public:
@@ -25,6 +37,7 @@ namespace Zx
 
 		bool CreateZWindow(int width, int height, const String& title);
 		bool CreateSurface();
+		bool PumpEvents(WindowEvents& events, int timeout);
 
 	public:
 		inline void SetVkInstance(const VkInstance& instance)
@@ -47,12 +60,25 @@ namespace Zx
 			return m_connection;
 		}
 
+		inline bool IsMinimized() const
+		{
+			return m_minimized;
+		}
+
 	private:
 		VkInstance m_instance;
 		VkSurfaceKHR m_surface;
 
 		xcb_connection_t* m_connection;
 		xcb_window_t m_handle;
+		xcb_atom_t m_deleteAtom;
+
+		uint16_t m_width;
+		uint16_t m_height;
+		bool m_minimized;
+
+	private:
+		void HandleEvent(const xcb_generic_event_t& event, WindowEvents& events);
 	};
 }
 
@@ -0,0 +1,331 @@
+#ifndef RENDERGRAPH_HPP
+#define RENDERGRAPH_HPP
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/RetireQueue.hpp>
+#include <Neon/Renderer/MemoryAllocator.hpp>
+
+namespace Zx
+{
+	class Device;
+
+	/*
+	@brief : The description of an image of the graph, an image created by the graph only lives between its first and its last pass
+	*/
+	struct RenderGraphImageInfo
+	{
+		inline RenderGraphImageInfo() : format(VK_FORMAT_UNDEFINED), width(0), height(0), usage(0), aspect(VK_IMAGE_ASPECT_COLOR_BIT), samples(VK_SAMPLE_COUNT_1_BIT)
+		{}
+
+		VkFormat format;
+
+		// A size of 0 follows the extent given to Reset
+		uint32_t width;
+		uint32_t height;
+
+		// Added to the usage deduced from the passes
+		VkImageUsageFlags usage;
+		VkImageAspectFlags aspect;
+		VkSampleCountFlagBits samples;
+	};
+
+	class RenderGraph
+	{
+		struct RenderGraphs;
+
+	public:
+		RenderGraph() = default;
+		RenderGraph(Device& device, MemoryAllocator& allocator);
+		RenderGraph(const RenderGraph& renderGraph);
+
+		~RenderGraph();
+
+		void Reset(VkExtent2D extent);
+
+		uint32_t CreateImage(const RenderGraphImageInfo& info);
+		uint32_t ImportImage(VkImage image, VkImageView imageView, const RenderGraphImageInfo& info, VkImageLayout initialLayout, VkImageLayout finalLayout,
+			VkPipelineStageFlags initialStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VkAccessFlags initialAccess = 0);
+		uint32_t ImportBuffer(VkBuffer buffer, VkPipelineStageFlags initialStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VkAccessFlags initialAccess = 0);
+
+		uint32_t AddPass(bool graphics, const std::function<void(VkCommandBuffer)>& record, bool sideEffect = false);
+		uint32_t AddSubpass(uint32_t pass, const std::function<void(VkCommandBuffer)>& record);
+		void AddColorAttachment(uint32_t pass, uint32_t image, const VkClearColorValue* clearColor = nullptr, uint32_t resolveImage = InvalidHandle);
+		void SetDepthAttachment(uint32_t pass, uint32_t image, const VkClearDepthStencilValue* clearDepth = nullptr, bool readOnly = false);
+		void AddInputAttachment(uint32_t pass, uint32_t image);
+		void Read(uint32_t pass, uint32_t resource, VkPipelineStageFlags stages, VkAccessFlags access, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+		void Write(uint32_t pass, uint32_t resource, VkPipelineStageFlags stages, VkAccessFlags access, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+
+		bool Compile();
+		void Execute(VkCommandBuffer commandBuffer) const;
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline bool IsCulled(uint32_t pass) const;
+		inline const VkRenderPass& GetRenderPass(uint32_t pass) const;
+		inline uint32_t GetSubpass(uint32_t pass) const;
+		inline const VkImage& GetImage(uint32_t image) const;
+		inline const VkImageView& GetImageView(uint32_t image) const;
+		inline uint32_t GetBarrierCount() const;
+		inline VkDeviceSize GetTransientSize() const;
+		inline VkDeviceSize GetUnaliasedSize() const;
+
+		RenderGraph& operator=(RenderGraph&& renderGraph) noexcept;
+
+		static const uint32_t InvalidHandle = UINT32_MAX;
+
+	private:
+		struct ResourceUse
+		{
+			inline ResourceUse() : resource(InvalidHandle), stages(0), access(0), layout(VK_IMAGE_LAYOUT_UNDEFINED), usage(0), write(false), attachment(false)
+			{}
+
+			uint32_t resource;
+			VkPipelineStageFlags stages;
+			VkAccessFlags access;
+			VkImageLayout layout;
+			VkImageUsageFlags usage;
+			bool write;
+
+			// The attachments of the subpasses of a render pass are synchronized by its subpass dependencies
+			bool attachment;
+		};
+
+		struct Attachment
+		{
+			inline Attachment() : resource(InvalidHandle), clear(false), clearValue(), layout(VK_IMAGE_LAYOUT_UNDEFINED), finalLayout(VK_IMAGE_LAYOUT_UNDEFINED)
+				, loadOp(VK_ATTACHMENT_LOAD_OP_DONT_CARE), storeOp(VK_ATTACHMENT_STORE_OP_DONT_CARE)
+			{}
+
+			uint32_t resource;
+			bool clear;
+			VkClearValue clearValue;
+
+			// The layout of the first subpass using the attachment, then of the last one
+			VkImageLayout layout;
+			VkImageLayout finalLayout;
+
+			// The contents are only loaded when a previous pass wrote them, and only stored when a later pass or the caller needs them
+			VkAttachmentLoadOp loadOp;
+			VkAttachmentStoreOp storeOp;
+		};
+
+		// The state of a resource while the passes are walked, the writes are made visible once per reading stage
+		struct ResourceState
+		{
+			inline ResourceState() : layout(VK_IMAGE_LAYOUT_UNDEFINED), writeStages(0), writeAccess(0), readStages(0), visibleStages(0), visibleAccess(0), written(false)
+				, writeSubpass(InvalidHandle), useSubpass(InvalidHandle)
+			{}
+
+			VkImageLayout layout;
+			VkPipelineStageFlags writeStages;
+			VkAccessFlags writeAccess;
+			VkPipelineStageFlags readStages;
+			VkPipelineStageFlags visibleStages;
+			VkAccessFlags visibleAccess;
+			bool written;
+
+			// The last subpass writing and using the attachment in the current render pass
+			uint32_t writeSubpass;
+			uint32_t useSubpass;
+		};
+
+		struct Resource
+		{
+			inline Resource() : image(VK_NULL_HANDLE), imageView(VK_NULL_HANDLE), buffer(VK_NULL_HANDLE), info(), usage(0), imported(false), keep(false)
+				, initialLayout(VK_IMAGE_LAYOUT_UNDEFINED), finalLayout(VK_IMAGE_LAYOUT_UNDEFINED), initialStages(0), initialAccess(0), firstPass(InvalidHandle)
+				, lastPass(0), transient(InvalidHandle), state()
+			{}
+
+			VkImage image;
+			VkImageView imageView;
+			VkBuffer buffer;
+
+			RenderGraphImageInfo info;
+			VkImageUsageFlags usage;
+
+			// An imported image is only kept after the graph when it has a final layout
+			bool imported;
+			bool keep;
+			VkImageLayout initialLayout;
+			VkImageLayout finalLayout;
+			VkPipelineStageFlags initialStages;
+			VkAccessFlags initialAccess;
+
+			// The lifetime of the resource among the passes kept by the compilation
+			uint32_t firstPass;
+			uint32_t lastPass;
+			uint32_t transient;
+
+			ResourceState state;
+		};
+
+		struct Pass
+		{
+			inline Pass() : record(), graphics(false), sideEffect(false), culled(false), group(InvalidHandle), subpass(0), uses(), attachments(), depthAttachment(InvalidHandle)
+				, resolveAttachments(), inputAttachments(), renderAttachments(), dependencies(), renderPass(VK_NULL_HANDLE), framebuffer(VK_NULL_HANDLE), extent(), srcStages(0)
+				, dstStages(0), imageBarriers(), bufferBarriers()
+			{}
+
+			std::function<void(VkCommandBuffer)> record;
+
+			bool graphics;
+			bool sideEffect;
+			bool culled;
+
+			// The first pass of the render pass the pass is a subpass of, itself if it begins one
+			uint32_t group;
+			uint32_t subpass;
+
+			std::vector<ResourceUse> uses;
+
+			// The color attachments come first, the depth attachment is the last one, a color attachment is resolved in the image at the same index if there is one
+			std::vector<Attachment> attachments;
+			uint32_t depthAttachment;
+			std::vector<Attachment> resolveAttachments;
+			std::vector<Attachment> inputAttachments;
+
+			// Only filled for the first pass of a render pass, the attachments of all its subpasses and the dependencies between them
+			std::vector<Attachment> renderAttachments;
+			std::vector<VkSubpassDependency> dependencies;
+
+			VkRenderPass renderPass;
+			VkFramebuffer framebuffer;
+			VkExtent2D extent;
+
+			// Every barrier of a render pass is recorded in a single call before it begins
+			VkPipelineStageFlags srcStages;
+			VkPipelineStageFlags dstStages;
+			std::vector<VkImageMemoryBarrier> imageBarriers;
+			std::vector<VkBufferMemoryBarrier> bufferBarriers;
+		};
+
+		// Images with disjoint lifetimes share the memory of a slot, the contents of an image do not survive its lifetime
+		struct TransientImage
+		{
+			inline TransientImage() : image(VK_NULL_HANDLE), imageView(VK_NULL_HANDLE), info(), usage(0), firstPass(0), lastPass(0), slot(InvalidHandle)
+			{}
+
+			VkImage image;
+			VkImageView imageView;
+
+			RenderGraphImageInfo info;
+			VkImageUsageFlags usage;
+			uint32_t firstPass;
+			uint32_t lastPass;
+			uint32_t slot;
+		};
+
+		struct MemorySlot
+		{
+			inline MemorySlot() : allocation(), requirements(), lifetimes(), lazy(false), lastStages(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT), lastAccess(0)
+			{}
+
+			MemoryAllocation allocation;
+			VkMemoryRequirements requirements;
+			std::vector<std::pair<uint32_t, uint32_t>> lifetimes;
+
+			// Only holds transient attachments, in lazily allocated memory when the device has some
+			bool lazy;
+
+			// The last access to the memory of the slot, the next image using it waits for it
+			VkPipelineStageFlags lastStages;
+			VkAccessFlags lastAccess;
+		};
+
+		struct CachedRenderPass
+		{
+			inline CachedRenderPass() : attachments(), subpasses(), dependencies(), renderPass(VK_NULL_HANDLE)
+			{}
+
+			std::vector<VkAttachmentDescription> attachments;
+
+			// The references of each subpass, one after the other
+			std::vector<uint32_t> subpasses;
+			std::vector<VkSubpassDependency> dependencies;
+			VkRenderPass renderPass;
+		};
+
+		struct CachedFramebuffer
+		{
+			inline CachedFramebuffer() : renderPass(VK_NULL_HANDLE), imageViews(), extent(), framebuffer(VK_NULL_HANDLE), lastUsedFrame(0)
+			{}
+
+			VkRenderPass renderPass;
+			std::vector<VkImageView> imageViews;
+			VkExtent2D extent;
+			VkFramebuffer framebuffer;
+			uint64_t lastUsedFrame;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<RenderGraphs> m_renderGraph;
+
+		struct RenderGraphs
+		{
+			inline RenderGraphs() : allocator(), resources(), passes(), finalBarriers(), finalSrcStages(0), finalDstStages(0), transientImages(), memorySlots()
+				, renderPasses(), framebuffers(), retiredImages(), retiredAllocations(), extent(), barrierCount(0), transientSize(0), unaliasedSize(0), compiled(false)
+			{}
+
+			MemoryAllocator allocator;
+
+			std::vector<Resource> resources;
+			std::vector<Pass> passes;
+
+			// Moves the imported images to the layout they are expected in after the graph
+			std::vector<VkImageMemoryBarrier> finalBarriers;
+			VkPipelineStageFlags finalSrcStages;
+			VkPipelineStageFlags finalDstStages;
+
+			// Kept from a frame to the next while the transient images of the graph stay the same
+			std::vector<TransientImage> transientImages;
+			std::vector<MemorySlot> memorySlots;
+
+			std::vector<CachedRenderPass> renderPasses;
+			std::vector<CachedFramebuffer> framebuffers;
+
+			// Released once the frames using them are over
+			RetireQueue<std::pair<VkImage, VkImageView>> retiredImages;
+			RetireQueue<MemoryAllocation> retiredAllocations;
+
+			VkExtent2D extent;
+
+			uint32_t barrierCount;
+			VkDeviceSize transientSize;
+			VkDeviceSize unaliasedSize;
+
+			bool compiled;
+		};
+
+	private:
+		void CullPasses();
+		bool CreateTransientImages();
+		bool AllocateTransientImages(std::vector<TransientImage>& transientImages);
+		void ComputeBarriers();
+		void BeginRenderPass(uint32_t pass);
+		void EndRenderPass(uint32_t pass, uint32_t lastPass);
+		void AddUse(Pass& pass, Resource& resource, const ResourceUse& use, uint32_t subpass, std::vector<bool>& begun);
+		void AddBarrier(Pass& pass, Resource& resource, const ResourceUse& use);
+		void AddDependency(Pass& pass, Resource& resource, const ResourceUse& use, uint32_t subpass);
+		bool CreateRenderPass(uint32_t pass);
+		bool CreateFramebuffer(Pass& pass);
+
+		void ReleaseTransientImages(bool retire);
+		void ReleaseRetired(bool all);
+
+		bool IsLastSubpass(uint32_t pass) const;
+		static uint32_t FindAttachment(const std::vector<Attachment>& attachments, uint32_t resource);
+		static void UpdateState(ResourceState& state, const ResourceUse& use, bool visible, bool image);
+		static void GetLayoutAccess(VkImageLayout layout, VkAccessFlags& access, VkPipelineStageFlags& stages);
+		static VkImageUsageFlags GetLayoutUsage(VkImageLayout layout);
+	};
+}
+
+#include "RenderGraph.inl"
+
+#endif //RENDERGRAPH_HPP
\ No newline at end of file
@@ -0,0 +1,47 @@
+namespace Zx
+{
+	inline bool RenderGraph::IsValid() const
+	{
+		return (m_renderGraph != nullptr) && m_renderGraph->compiled;
+	}
+
+	inline bool RenderGraph::IsCulled(uint32_t pass) const
+	{
+		return m_renderGraph->passes[pass].culled;
+	}
+
+	inline const VkRenderPass& RenderGraph::GetRenderPass(uint32_t pass) const
+	{
+		return m_renderGraph->passes[pass].renderPass;
+	}
+
+	inline uint32_t RenderGraph::GetSubpass(uint32_t pass) const
+	{
+		return m_renderGraph->passes[pass].subpass;
+	}
+
+	inline const VkImage& RenderGraph::GetImage(uint32_t image) const
+	{
+		return m_renderGraph->resources[image].image;
+	}
+
+	inline const VkImageView& RenderGraph::GetImageView(uint32_t image) const
+	{
+		return m_renderGraph->resources[image].imageView;
+	}
+
+	inline uint32_t RenderGraph::GetBarrierCount() const
+	{
+		return m_renderGraph->barrierCount;
+	}
+
+	inline VkDeviceSize RenderGraph::GetTransientSize() const
+	{
+		return m_renderGraph->transientSize;
+	}
+
+	inline VkDeviceSize RenderGraph::GetUnaliasedSize() const
+	{
+		return m_renderGraph->unaliasedSize;
+	}
+}
\ No newline at end of file
@@ -1,38 +1,121 @@
 #ifndef RENDERPASS_HPP
 #define RENDERPASS_HPP
 
+#include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/RetireQueue.hpp>
+#include <Neon/Renderer/Image.hpp>
+#include <Neon/Renderer/MemoryAllocator.hpp>
+#include <Neon/Renderer/RenderGraph.hpp>
 
 namespace Zx
 {
 	class Device;
 	class SwapChain;
 
+	struct RenderPassInfo
+	{
+		inline RenderPassInfo() : depth(true), depthPrePass(false), transientAttachments(true), samples(VK_SAMPLE_COUNT_1_BIT), deferred(false)
+		{}
+
+		// A depth attachment of the extent of the swap chain, recreated with it
+		bool depth;
+
+		// A first subpass only writes the depth, the color subpass then shades the visible fragments only
+		bool depthPrePass;
+
+		// The attachments only used inside the render pass are never stored, tiled GPUs keep them in tile memory without backing them
+		bool transientAttachments;
+
+		// Lowered to the highest count the device supports, the multisampled color is resolved in the swap chain image at the end of the subpass
+		VkSampleCountFlagBits samples;
+
+		// The geometry subpass fills a G-buffer the lighting subpass reads as input attachments, it needs a depth and ignores the pre-pass and the samples
+		bool deferred;
+	};
+
 	class RenderPass
 	{
 		struct RenderPasss;
+		struct Attachments;
 
 	public:
 		RenderPass() = default;
 		RenderPass(Device& device, SwapChain& swapChain);
+		RenderPass(Device& device, SwapChain& swapChain, MemoryAllocator& allocator, const RenderPassInfo& info = RenderPassInfo());
 		RenderPass(const RenderPass& renderPass);
 
 		~RenderPass();
 
 		inline const VkRenderPass& GetRenderPass() const;
+		inline bool HasDepth() const;
+		inline bool HasDepthPrePass() const;
+		inline bool IsDeferred() const;
+		inline VkFormat GetDepthFormat() const;
+		inline uint32_t GetColorSubpass() const;
+		inline uint32_t GetGeometrySubpass() const;
+		inline uint32_t GetGeometryColorCount() const;
+		inline VkSampleCountFlagBits GetSampleCount() const;
+		inline const Image& GetDepthImage() const;
+		inline const Image& GetGBufferImage(uint32_t index) const;
+		inline uint32_t GetGBufferCount() const;
 	
-		bool CreateFramebuffer(VkFramebuffer& framebuffer, VkImageView imageView);
+		bool CreateAttachments();
+		RenderGraph& DeclareFrame(uint32_t imageIndex);
+		uint32_t DeclareSubpasses(const std::function<void(VkCommandBuffer, uint32_t)>& record, const VkClearColorValue& clearColor);
+		void BeginFrame();
 
 		RenderPass& operator=(RenderPass&&) noexcept;
 
 	private:
 		std::shared_ptr<SwapChain> m_swapChain;
 		std::shared_ptr<Device> m_device;
+		std::shared_ptr<Attachments> m_attachments;
 
 		VkRenderPass m_renderPass;
+
+		struct Attachments
+		{
+			inline Attachments() : allocator(), info(), depthFormat(VK_FORMAT_UNDEFINED), depthImage(), samples(VK_SAMPLE_COUNT_1_BIT), colorImage(), gBufferImages()
+				, renderGraph(), swapChainAttachment(RenderGraph::InvalidHandle), colorAttachment(RenderGraph::InvalidHandle), depthAttachment(RenderGraph::InvalidHandle)
+				, gBufferAttachments(), retiredImages()
+			{}
+
+			MemoryAllocator allocator;
+			RenderPassInfo info;
+
+			VkFormat depthFormat;
+			Image depthImage;
+
+			// Only created with more than one sample, the swap chain image is then the resolve attachment
+			VkSampleCountFlagBits samples;
+			Image colorImage;
+
+			// The albedo then the normal of the deferred path, they only live in the render pass
+			std::vector<Image> gBufferImages;
+
+			// Records the frames, the render pass and the framebuffers are the ones it compiles from the subpasses
+			RenderGraph renderGraph;
+
+			// The handles of the attachments in the graph of the current frame
+			uint32_t swapChainAttachment;
+			uint32_t colorAttachment;
+			uint32_t depthAttachment;
+			std::vector<uint32_t> gBufferAttachments;
+
+			// The attachments replaced by CreateAttachments live until the frames in flight which may still use them are over
+			RetireQueue<Image> retiredImages;
+		};
 	
 	private:
 		bool CreateRenderPass();
+		void RetireImage(Image& image);
+		VkFormat FindDepthFormat() const;
+		VkSampleCountFlagBits FindSampleCount(VkSampleCountFlagBits samples) const;
 	};
 }
 
@@ -4,4 +4,59 @@ namespace Zx
 	{
 		return m_renderPass;
 	}
+
+	inline bool RenderPass::HasDepth() const
+	{
+		return (m_attachments != nullptr) && (m_attachments->depthFormat != VK_FORMAT_UNDEFINED);
+	}
+
+	inline bool RenderPass::HasDepthPrePass() const
+	{
+		return HasDepth() && m_attachments->info.depthPrePass;
+	}
+
+	inline bool RenderPass::IsDeferred() const
+	{
+		return HasDepth() && m_attachments->info.deferred;
+	}
+
+	inline VkFormat RenderPass::GetDepthFormat() const
+	{
+		return HasDepth() ? m_attachments->depthFormat : VK_FORMAT_UNDEFINED;
+	}
+
+	inline uint32_t RenderPass::GetColorSubpass() const
+	{
+		return (HasDepthPrePass() || IsDeferred()) ? 1 : 0;
+	}
+
+	inline uint32_t RenderPass::GetGeometrySubpass() const
+	{
+		return IsDeferred() ? 0 : GetColorSubpass();
+	}
+
+	inline uint32_t RenderPass::GetGeometryColorCount() const
+	{
+		return IsDeferred() ? GetGBufferCount() : 1;
+	}
+
+	inline VkSampleCountFlagBits RenderPass::GetSampleCount() const
+	{
+		return (m_attachments != nullptr) ? m_attachments->samples : VK_SAMPLE_COUNT_1_BIT;
+	}
+
+	inline const Image& RenderPass::GetDepthImage() const
+	{
+		return m_attachments->depthImage;
+	}
+
+	inline const Image& RenderPass::GetGBufferImage(uint32_t index) const
+	{
+		return m_attachments->gBufferImages[index];
+	}
+
+	inline uint32_t RenderPass::GetGBufferCount() const
+	{
+		return IsDeferred() ? static_cast<uint32_t>(m_attachments->gBufferImages.size()) : 0;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef SAMPLERCACHE_HPP
+#define SAMPLERCACHE_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <vulkan/vulkan.h>
+
+namespace Zx
+{
+	class Device;
+
+	struct SamplerInfo
+	{
+		inline SamplerInfo() : magFilter(VK_FILTER_LINEAR), minFilter(VK_FILTER_LINEAR), mipmapMode(VK_SAMPLER_MIPMAP_MODE_LINEAR), addressMode(VK_SAMPLER_ADDRESS_MODE_REPEAT)
+			, maxAnisotropy(16.0f), maxLod(VK_LOD_CLAMP_NONE), compareOp(VK_COMPARE_OP_NEVER), compareEnable(false)
+		{}
+
+		bool operator==(const SamplerInfo& info) const;
+
+		VkFilter magFilter;
+		VkFilter minFilter;
+		VkSamplerMipmapMode mipmapMode;
+		VkSamplerAddressMode addressMode;
+
+		// Clamped to the limit of the device, 1 or less disables the anisotropic filtering
+		float maxAnisotropy;
+		float maxLod;
+
+		VkCompareOp compareOp;
+		bool compareEnable;
+	};
+
+	class SamplerCache
+	{
+		struct SamplerCaches;
+
+	public:
+		SamplerCache() = default;
+		SamplerCache(Device& device);
+		SamplerCache(const SamplerCache& samplerCache);
+
+		~SamplerCache();
+
+		VkSampler GetSampler(const SamplerInfo& info = SamplerInfo());
+
+		//Getters
+
+		inline std::size_t GetSamplerCount() const;
+
+		SamplerCache& operator=(SamplerCache&& samplerCache) noexcept;
+
+	private:
+		struct SamplerInfoHash
+		{
+			std::size_t operator()(const SamplerInfo& info) const;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<SamplerCaches> m_samplerCache;
+
+		struct SamplerCaches
+		{
+			inline SamplerCaches() : samplers(), maxAnisotropy(0.0f)
+			{}
+
+			std::unordered_map<SamplerInfo, VkSampler, SamplerInfoHash> samplers;
+
+			// 0 when the device does not support anisotropic filtering
+			float maxAnisotropy;
+		};
+	};
+}
+
+#include "SamplerCache.inl"
+
+#endif //SAMPLERCACHE_HPP
\ No newline at end of file
@@ -0,0 +1,7 @@
+namespace Zx
+{
+	inline std::size_t SamplerCache::GetSamplerCount() const
+	{
+		return m_samplerCache->samplers.size();
+	}
+}
\ No newline at end of file
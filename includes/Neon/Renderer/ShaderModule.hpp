@@ -1,7 +1,9 @@
 #ifndef SHADERMODULE_HPP
 #define SHADERMODULE_HPP
 
+#include <map>
 #include <memory>
+#include <vector>
 #include <vulkan/vulkan.h>
 
 #include <Neon/Core/String.hpp>
@@ -13,6 +15,9 @@ namespace Zx
 	class Device;
 
 	SmartDeleter<VkShaderModule, PFN_vkDestroyShaderModule> CreateShaderModule(const String& filename, const Device& device);
+
+	bool ReflectDescriptorBindings(const String& filename, VkShaderStageFlags stage, std::map<uint32_t, std::vector<VkDescriptorSetLayoutBinding>>& sets);
+	bool ReflectDescriptorBindings(const std::vector<char>& code, VkShaderStageFlags stage, std::map<uint32_t, std::vector<VkDescriptorSetLayoutBinding>>& sets);
 }
 
 #endif //SHADERMODULE_HPP
\ No newline at end of file
@@ -3,13 +3,34 @@
 
 #include <vector>
 #include <memory>
+#include <utility>
 #include <vulkan/vulkan.h>
 
+#include <Neon/Core/RetireQueue.hpp>
+
 namespace Zx
 {
 	class Window;
 	class Device;
 
+	struct SwapChainInfo
+	{
+		// Mailbox when available, FIFO otherwise, with one image more than the minimum of the surface
+		inline SwapChainInfo() : presentModes({ VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_KHR }), imageCount(0)
+		{}
+
+		static SwapChainInfo Uncapped();
+		static SwapChainInfo LowLatency();
+		static SwapChainInfo VSync();
+		static SwapChainInfo AdaptiveVSync();
+
+		// Tried in order, FIFO is always supported and taken when none of them is
+		std::vector<VkPresentModeKHR> presentModes;
+
+		// Clamped to the counts the surface supports, 0 asks for one image more than the minimum
+		uint32_t imageCount;
+	};
+
 	class SwapChain
 	{
 		struct SwapChains;
@@ -23,25 +44,37 @@ namespace Zx
 		~SwapChain();
 
 		bool CreateSwapChain();
+		void BeginFrame();
 		
 		//Getters and Setters
 
 		inline bool IsRenderAvailable() const;
+		inline std::size_t GetRetiredCount() const;
+		inline VkPresentModeKHR GetPresentMode() const;
+		inline uint32_t GetImageCount() const;
 		inline const std::shared_ptr<SwapChains>& GetSwapChain() const;
 		
 		inline void SetDevice(const Device& device);
 		inline void SetWindow(const Window& window);
+		void SetInfo(const SwapChainInfo& info);
 
 		SwapChain& operator=(SwapChain&& swapChain) noexcept;
 
 	private:
+		struct RetiredSwapChain
+		{
+			VkSwapchainKHR swapChain;
+			std::vector<VkImageView> imageView;
+		};
+
 		std::shared_ptr<SwapChains> m_swapChain;
 		std::shared_ptr<Device> m_device;
 		std::shared_ptr<Window> m_window;
 
 		struct SwapChains
 		{
-			inline SwapChains() : swapChain(VK_NULL_HANDLE), extent({ 0, 0 }), format(VK_FORMAT_UNDEFINED), image(), imageView()
+			inline SwapChains() : swapChain(VK_NULL_HANDLE), extent({ 0, 0 }), format(VK_FORMAT_UNDEFINED), image(), imageView(), info(), presentMode(VK_PRESENT_MODE_FIFO_KHR)
+				, retired()
 			{}
 
 			VkSwapchainKHR swapChain;
@@ -49,14 +82,22 @@ namespace Zx
 			VkFormat format;
 			std::vector<VkImage> image;
 			std::vector<VkImageView> imageView;
+
+			// The policy asked for and the present mode the surface gave
+			SwapChainInfo info;
+			VkPresentModeKHR presentMode;
+
+			// A replaced swap chain lives until the frames in flight which may still use its images are over
+			RetireQueue<RetiredSwapChain> retired;
 		};
 
 		bool m_isRenderAvailable;
 
 	private:
 		bool CreateSwapChainImageView();
+		void DestroyRetiredSwapChain(RetiredSwapChain& retired);
 
-		uint32_t GetSwapChainNumImages(const VkSurfaceCapabilitiesKHR& surfaceCapabilities);
+		uint32_t GetSwapChainNumImages(const VkSurfaceCapabilitiesKHR& surfaceCapabilities, VkPresentModeKHR presentMode);
 		VkSurfaceFormatKHR GetSwapChainFormat(const std::vector<VkSurfaceFormatKHR>& surfaceFormats);
 		VkExtent2D GetSwapChainExtent(const VkSurfaceCapabilitiesKHR& surfaceCapabilities);
 		VkImageUsageFlags GetSwapChainUsageFlags(const VkSurfaceCapabilitiesKHR& surfaceCapabilities);
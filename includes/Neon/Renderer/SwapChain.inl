@@ -5,6 +5,21 @@ namespace Zx
 		return m_isRenderAvailable;
 	}
 
+	inline std::size_t SwapChain::GetRetiredCount() const
+	{
+		return m_swapChain->retired.GetSize();
+	}
+
+	inline VkPresentModeKHR SwapChain::GetPresentMode() const
+	{
+		return m_swapChain->presentMode;
+	}
+
+	inline uint32_t SwapChain::GetImageCount() const
+	{
+		return static_cast<uint32_t>(m_swapChain->image.size());
+	}
+
 	inline const std::shared_ptr<SwapChain::SwapChains>& SwapChain::GetSwapChain() const
 	{
 		return m_swapChain;
@@ -0,0 +1,61 @@
+#ifndef TEXTURE_HPP
+#define TEXTURE_HPP
+
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/Image.hpp>
+#include <Neon/Renderer/SamplerCache.hpp>
+
+namespace Zx
+{
+	class Device;
+	class File;
+	class MemoryAllocator;
+	class ImageUploader;
+
+	class Texture
+	{
+		struct Textures;
+
+	public:
+		Texture() = default;
+		Texture(Device& device, MemoryAllocator& allocator, SamplerCache& samplerCache, uint32_t width, uint32_t height, VkFormat format, bool mipmapped = true,
+			const SamplerInfo& samplerInfo = SamplerInfo());
+		Texture(Device& device, MemoryAllocator& allocator, SamplerCache& samplerCache, ImageUploader& imageUploader, const File& file,
+			const SamplerInfo& samplerInfo = SamplerInfo());
+		Texture(const Texture& texture);
+
+		~Texture();
+
+		bool Upload(ImageUploader& imageUploader, const void* texels, VkDeviceSize size);
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline const Image& GetImage() const;
+		inline const VkImageView& GetImageView() const;
+		inline const VkSampler& GetSampler() const;
+
+		Texture& operator=(Texture&& texture) noexcept;
+
+	private:
+		std::shared_ptr<Textures> m_texture;
+
+		struct Textures
+		{
+			inline Textures() : image(), sampler(VK_NULL_HANDLE), mipmapped(false)
+			{}
+
+			Image image;
+
+			// Owned by the sampler cache
+			VkSampler sampler;
+			bool mipmapped;
+		};
+	};
+}
+
+#include "Texture.inl"
+
+#endif //TEXTURE_HPP
\ No newline at end of file
@@ -0,0 +1,22 @@
+namespace Zx
+{
+	inline bool Texture::IsValid() const
+	{
+		return (m_texture != nullptr) && m_texture->image.IsValid() && (m_texture->sampler != VK_NULL_HANDLE);
+	}
+
+	inline const Image& Texture::GetImage() const
+	{
+		return m_texture->image;
+	}
+
+	inline const VkImageView& Texture::GetImageView() const
+	{
+		return m_texture->image.GetImageView();
+	}
+
+	inline const VkSampler& Texture::GetSampler() const
+	{
+		return m_texture->sampler;
+	}
+}
\ No newline at end of file
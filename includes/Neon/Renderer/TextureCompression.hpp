@@ -0,0 +1,35 @@
+#ifndef TEXTURECOMPRESSION_HPP
+#define TEXTURECOMPRESSION_HPP
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Zx
+{
+	class Device;
+
+	/*
+	@brief : The texel block of a format, 1x1 for the uncompressed formats
+	*/
+	struct FormatBlock
+	{
+		inline FormatBlock() : width(1), height(1), size(0)
+		{}
+
+		uint32_t width;
+		uint32_t height;
+		uint32_t size;
+	};
+
+	bool GetFormatBlock(VkFormat format, FormatBlock& block);
+	bool IsBlockCompressed(VkFormat format);
+	VkDeviceSize GetImageSize(VkFormat format, uint32_t width, uint32_t height);
+
+	bool IsFormatSampled(const Device& device, VkFormat format);
+
+	VkFormat GetTranscodedFormat(VkFormat format);
+	bool TranscodeImage(VkFormat format, const void* data, VkDeviceSize size, uint32_t width, uint32_t height, std::vector<uint8_t>& texels);
+}
+
+#endif //TEXTURECOMPRESSION_HPP
\ No newline at end of file
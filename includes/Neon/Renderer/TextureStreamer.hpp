@@ -0,0 +1,122 @@
+#ifndef TEXTURESTREAMER_HPP
+#define TEXTURESTREAMER_HPP
+
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Core/RetireQueue.hpp>
+#include <Neon/Renderer/BindlessTable.hpp>
+#include <Neon/Renderer/Image.hpp>
+#include <Neon/Renderer/ImageUploader.hpp>
+#include <Neon/Renderer/Ktx2.hpp>
+#include <Neon/Renderer/MemoryAllocator.hpp>
+#include <Neon/Renderer/SamplerCache.hpp>
+
+namespace Zx
+{
+	class Device;
+	class File;
+
+	class TextureStreamer
+	{
+		struct TextureStreamers;
+
+	public:
+		TextureStreamer() = default;
+		TextureStreamer(Device& device, MemoryAllocator& allocator, SamplerCache& samplerCache, ImageUploader& imageUploader, BindlessTable& bindlessTable,
+			VkDeviceSize maxResidentSize = 0, VkDeviceSize uploadSize = 4 * 1024 * 1024);
+		TextureStreamer(const TextureStreamer& textureStreamer);
+
+		~TextureStreamer();
+
+		uint32_t Add(const File& file, const SamplerInfo& samplerInfo = SamplerInfo());
+		void Remove(uint32_t handle);
+
+		void BeginFrame();
+		void Request(uint32_t handle, float screenSize);
+		bool Update(VkCommandBuffer commandBuffer);
+
+		uint32_t GetTextureIndex(uint32_t handle) const;
+
+		//Getters
+
+		inline bool IsValid() const;
+		inline VkDeviceSize GetResidentSize() const;
+		inline VkDeviceSize GetBudget() const;
+
+		TextureStreamer& operator=(TextureStreamer&& textureStreamer) noexcept;
+
+		static const uint32_t InvalidHandle = UINT32_MAX;
+
+	private:
+		struct StreamedTexture
+		{
+			inline StreamedTexture() : source(), loading(), image(), sampler(VK_NULL_HANDLE), bindlessIndex(BindlessTable::InvalidIndex), levelCount(0), residentMip(0)
+				, minResidentMip(0), requestedMip(0), targetMip(0), lastUsedFrame(0), requestedSize(0.0f), used(false), loaded(false)
+			{}
+
+			// Read and transcoded on a worker thread, its levels are in the format of the image
+			std::shared_ptr<Ktx2Image> source;
+			std::future<bool> loading;
+
+			Image image;
+			VkSampler sampler;
+			uint32_t bindlessIndex;
+
+			// The image holds the levels from residentMip to the end of the chain, residentMip is levelCount when nothing is resident
+			uint32_t levelCount;
+			uint32_t residentMip;
+			uint32_t minResidentMip;
+			uint32_t requestedMip;
+			uint32_t targetMip;
+			uint64_t lastUsedFrame;
+
+			// The largest size on the screen asked for this frame, in pixels
+			float requestedSize;
+
+			bool used;
+			bool loaded;
+		};
+
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<TextureStreamers> m_textureStreamer;
+
+		struct TextureStreamers
+		{
+			inline TextureStreamers() : allocator(), samplerCache(), imageUploader(), bindlessTable(), textures(), freeHandles(), retiredImages(), maxResidentSize(0)
+				, uploadSize(0), residentSize(0), budget(0)
+			{}
+
+			MemoryAllocator allocator;
+			SamplerCache samplerCache;
+			ImageUploader imageUploader;
+			BindlessTable bindlessTable;
+
+			std::vector<StreamedTexture> textures;
+			std::vector<uint32_t> freeHandles;
+
+			// Images replaced by a new residency, released once the frames sampling them are over
+			RetireQueue<Image> retiredImages;
+
+			VkDeviceSize maxResidentSize;
+			VkDeviceSize uploadSize;
+			VkDeviceSize residentSize;
+			VkDeviceSize budget;
+		};
+
+	private:
+		void PollLoading(StreamedTexture& texture);
+		void ComputeBudget();
+		bool Evict(VkDeviceSize size, uint32_t handle);
+		bool SetResidentMip(StreamedTexture& texture, uint32_t mip, VkCommandBuffer commandBuffer);
+
+		VkDeviceSize GetLevelsSize(const StreamedTexture& texture, uint32_t mip) const;
+	};
+}
+
+#include "TextureStreamer.inl"
+
+#endif //TEXTURESTREAMER_HPP
\ No newline at end of file
@@ -0,0 +1,17 @@
+namespace Zx
+{
+	inline bool TextureStreamer::IsValid() const
+	{
+		return (m_textureStreamer != nullptr) && m_textureStreamer->imageUploader.IsValid();
+	}
+
+	inline VkDeviceSize TextureStreamer::GetResidentSize() const
+	{
+		return m_textureStreamer->residentSize;
+	}
+
+	inline VkDeviceSize TextureStreamer::GetBudget() const
+	{
+		return m_textureStreamer->budget;
+	}
+}
\ No newline at end of file
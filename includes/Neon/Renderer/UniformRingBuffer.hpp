@@ -0,0 +1,78 @@
+#ifndef UNIFORMRINGBUFFER_HPP
+#define UNIFORMRINGBUFFER_HPP
+
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/Buffer.hpp>
+
+namespace Zx
+{
+	class Device;
+	class DescriptorLayoutCache;
+	class DescriptorAllocator;
+
+	class UniformRingBuffer
+	{
+		struct UniformRingBuffers;
+
+	public:
+		UniformRingBuffer() = default;
+		UniformRingBuffer(Device& device, DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator, VkDeviceSize frameSize, uint32_t frameCount = 3,
+			VkDeviceSize range = 256);
+		UniformRingBuffer(const UniformRingBuffer& uniformRingBuffer);
+
+		~UniformRingBuffer();
+
+		void BeginFrame(uint32_t frameIndex);
+		void* Allocate(VkDeviceSize size, uint32_t& dynamicOffset);
+		bool Flush();
+
+		void Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, uint32_t dynamicOffset) const;
+
+		template <typename T>
+		inline T* Allocate(uint32_t& dynamicOffset);
+
+		//Getters
+
+		inline const VkDescriptorSetLayout& GetDescriptorSetLayout() const;
+		inline const VkDescriptorSet& GetDescriptorSet() const;
+		inline VkDeviceSize GetAlignment() const;
+		inline VkDeviceSize GetRange() const;
+
+		UniformRingBuffer& operator=(UniformRingBuffer&& uniformRingBuffer) noexcept;
+
+	private:
+		std::shared_ptr<Device> m_device;
+		std::shared_ptr<UniformRingBuffers> m_ringBuffer;
+
+		struct UniformRingBuffers
+		{
+			inline UniformRingBuffers() : descriptorSetLayout(VK_NULL_HANDLE), descriptorSet(VK_NULL_HANDLE), alignment(1), range(0), frameSize(0), frameCount(0)
+				, frameBegin(0), head(0)
+			{}
+
+			Buffer buffer;
+			VkDescriptorSetLayout descriptorSetLayout;
+			VkDescriptorSet descriptorSet;
+
+			VkDeviceSize alignment;
+			VkDeviceSize range;
+			VkDeviceSize frameSize;
+			uint32_t frameCount;
+
+			VkDeviceSize frameBegin;
+			VkDeviceSize head;
+		};
+
+	private:
+		bool CreateRingBuffer();
+		bool CreateDescriptorSet(DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator);
+
+		static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment);
+	};
+}
+
+#include "UniformRingBuffer.inl"
+
+#endif //UNIFORMRINGBUFFER_HPP
\ No newline at end of file
@@ -0,0 +1,33 @@
+namespace Zx
+{
+	/*
+	@brief : Allocates room for one T in the current frame of the ring buffer
+	@param : The dynamic offset to give to vkCmdBindDescriptorSets
+	@return : Returns a pointer to the mapped memory, nullptr if the frame is full
+	*/
+	template <typename T>
+	inline T* UniformRingBuffer::Allocate(uint32_t& dynamicOffset)
+	{
+		return static_cast<T*>(Allocate(sizeof(T), dynamicOffset));
+	}
+
+	inline const VkDescriptorSetLayout& UniformRingBuffer::GetDescriptorSetLayout() const
+	{
+		return m_ringBuffer->descriptorSetLayout;
+	}
+
+	inline const VkDescriptorSet& UniformRingBuffer::GetDescriptorSet() const
+	{
+		return m_ringBuffer->descriptorSet;
+	}
+
+	inline VkDeviceSize UniformRingBuffer::GetAlignment() const
+	{
+		return m_ringBuffer->alignment;
+	}
+
+	inline VkDeviceSize UniformRingBuffer::GetRange() const
+	{
+		return m_ringBuffer->range;
+	}
+}
\ No newline at end of file
@@ -2,8 +2,11 @@
 #define VERTEXBUFFER_HPP
 
 #include <memory>
+#include <vector>
 #include <vulkan/vulkan.h>
 
+#include <Neon/Renderer/Buffer.hpp>
+
 namespace Zx
 {
 	class Device;
@@ -17,21 +20,28 @@ namespace Zx
 	class VertexBuffer
 	{
 	public:
-		VertexBuffer(Device& device);
+		VertexBuffer() = default;
+		VertexBuffer(Device& device, const void* vertices, uint32_t vertexCount, uint32_t stride);
+		VertexBuffer(Device& device, const std::vector<VertexData>& vertices);
+		VertexBuffer(const VertexBuffer& vertexBuffer);
 
 		~VertexBuffer();
 
+		void Bind(VkCommandBuffer commandBuffer, uint32_t binding = 0) const;
+
+		//Getters
+
 		inline const VkBuffer& GetVertexBuffer() const;
+		inline uint32_t GetVertexCount() const;
+		inline uint32_t GetStride() const;
 
-	private:
-		std::shared_ptr<Device> m_device;
+		VertexBuffer& operator=(VertexBuffer&& vertexBuffer) noexcept;
 
-		VkDeviceMemory m_memory;
-		VkBuffer m_vertexBuffer;
 	private:
-		bool CreateVertexBuffer();
+		Buffer m_buffer;
 
-		bool AllocateBufferMemory(const VkBuffer& buffer, VkDeviceMemory* memory);
+		uint32_t m_vertexCount;
+		uint32_t m_stride;
 	};
 }
 
@@ -2,6 +2,16 @@ namespace Zx
 {
 	inline const VkBuffer& VertexBuffer::GetVertexBuffer() const
 	{
-		return m_vertexBuffer;
+		return m_buffer.GetBuffer();
+	}
+
+	inline uint32_t VertexBuffer::GetVertexCount() const
+	{
+		return m_vertexCount;
+	}
+
+	inline uint32_t VertexBuffer::GetStride() const
+	{
+		return m_stride;
 	}
 }
\ No newline at end of file
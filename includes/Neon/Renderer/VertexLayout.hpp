@@ -0,0 +1,59 @@
+#ifndef VERTEXLAYOUT_HPP
+#define VERTEXLAYOUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include <Neon/Renderer/VertexBuffer.hpp>
+
+namespace Zx
+{
+	struct PipelineInfo;
+
+	/*
+	@brief : A vertex of 16 bytes, half float position, unorm8 color and octahedral snorm16 normal
+	*/
+	struct CompactVertexData
+	{
+		uint16_t position[4];
+		uint8_t color[4];
+		int16_t normal[2];
+	};
+
+	class VertexLayout
+	{
+	public:
+		explicit VertexLayout(uint32_t binding = 0, VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX);
+
+		VertexLayout& Add(uint32_t location, VkFormat format);
+		void Apply(PipelineInfo& info) const;
+
+		static VertexLayout Compact(uint32_t binding = 0);
+		static uint32_t GetFormatSize(VkFormat format);
+
+		//Getters
+
+		inline uint32_t GetBinding() const;
+		inline uint32_t GetStride() const;
+		inline const std::vector<VkVertexInputAttributeDescription>& GetAttributes() const;
+
+	private:
+		std::vector<VkVertexInputAttributeDescription> m_attributes;
+
+		uint32_t m_binding;
+		uint32_t m_stride;
+		VkVertexInputRate m_inputRate;
+	};
+
+	void PackHalf(const float* source, uint16_t* destination, std::size_t count);
+	void PackUnorm8(const float* source, uint8_t* destination, std::size_t count);
+	void PackOctahedral(const float* normals, int16_t* destination, std::size_t count);
+
+	void PackVertices(const std::vector<VertexData>& vertices, const float* normals, std::vector<CompactVertexData>& compactVertices);
+}
+
+#include "VertexLayout.inl"
+
+#endif //VERTEXLAYOUT_HPP
\ No newline at end of file
@@ -0,0 +1,17 @@
+namespace Zx
+{
+	inline uint32_t VertexLayout::GetBinding() const
+	{
+		return m_binding;
+	}
+
+	inline uint32_t VertexLayout::GetStride() const
+	{
+		return m_stride;
+	}
+
+	inline const std::vector<VkVertexInputAttributeDescription>& VertexLayout::GetAttributes() const
+	{
+		return m_attributes;
+	}
+}
\ No newline at end of file
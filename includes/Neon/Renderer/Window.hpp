@@ -65,6 +65,16 @@ namespace Zx
 		{
 			return m_surfacePlatform->GetWindow();
 		}
+
+		inline bool IsMinimized() const
+		{
+			return m_surfacePlatform->IsMinimized();
+		}
+
+		inline bool PumpEvents(WindowEvents& events, int timeout)
+		{
+			return m_surfacePlatform->PumpEvents(events, timeout);
+		}
 		#endif
 		
 	private:
@@ -17,4 +17,8 @@
 	#define NEON_POSIX
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define NEON_SSE2
+#endif
+
 #endif //UTILS_HPP
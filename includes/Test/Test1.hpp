@@ -1,9 +1,15 @@
 #ifndef TEST1_HPP
 #define TEST1_HPP
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <vector>
 #include <vulkan/vulkan.h>
 
+#include <Neon/Core/SpscQueue.hpp>
+
 namespace Zx
 {
 	class Device;
@@ -12,37 +18,105 @@ namespace Zx
 	class Pipeline;
 	class RenderPass;
 	class Window;
-	class VertexBuffer;
+	class GeometryPool;
+	class IndirectDrawBuffer;
+	class CullingPass;
+	class DeferredLighting;
+	class ClusteredLighting;
+	class InstanceBuffer;
+	class ImageUploader;
+	class TextureStreamer;
+	class UniformRingBuffer;
+	class DescriptorAllocator;
+	class BindlessTable;
+	class FramePacer;
 	class ShaderModule;
 	class Sync;
 	class CommandBuffers;
 
 	struct RenderingResourcesData;
+	struct MeshLod;
 
 	class Test1
 	{
 	public:
-		Test1(const RenderPass&, const SwapChain&, const Pipeline&, const VertexBuffer&, const Device&, const Window&, const CommandBuffers&, const std::vector<RenderingResourcesData>&);
+		Test1(const RenderPass&, const SwapChain&, const Pipeline&, const GeometryPool&, const std::vector<std::vector<MeshLod>>&, const IndirectDrawBuffer&, const CullingPass&, const DeferredLighting&, const ClusteredLighting&,
+			const InstanceBuffer&, const ImageUploader&, uint32_t, const TextureStreamer&, uint32_t,
+			const UniformRingBuffer&, const DescriptorAllocator&, const BindlessTable&, const FramePacer&, const Device&, const Window&, const CommandBuffers&, const std::vector<RenderingResourcesData>&);
 
 		bool RenderingLoop();
 
 	private:
-		bool PrepareFrame(VkCommandBuffer commandBuffer, const VkImageView& view, VkFramebuffer& framebuffer);
+		struct FrameData;
+
+		/*
+		@brief : A command of the event thread, the render thread runs them in order
+		*/
+		struct RenderCommand
+		{
+			uint32_t type;
+			uint32_t frame;
+		};
+
+		static const uint32_t DrawCommand = 0;
+		static const uint32_t ResizeCommand = 1;
+		static const uint32_t QuitCommand = 2;
+
+	private:
+		void RenderThread();
+		bool SubmitFrame();
+		bool PushCommand(const RenderCommand& command);
+		bool WaitForRenderThread();
+		void Simulate(FrameData& frame) const;
+		bool PrepareFrame(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+		void RecordSubpass(VkCommandBuffer commandBuffer, uint32_t subpass, uint32_t dynamicOffset);
+		void RecordDraws(VkCommandBuffer commandBuffer);
+		bool UseClusteredLighting() const;
 		void ChildClear();
 		bool ChildOnWindowSizeChanged();
 		bool OnWindowSizeChanged();
-		bool Draw();
+		bool Draw(const FrameData& frame);
 
 	private:
 		std::shared_ptr<RenderPass> m_renderPass;
 		std::shared_ptr<SwapChain> m_swapChain;
 		std::shared_ptr<Pipeline> m_pipeline;
-		std::shared_ptr<VertexBuffer> m_vertexBuffer;
+		std::shared_ptr<GeometryPool> m_geometryPool;
+		std::shared_ptr<std::vector<std::vector<MeshLod>>> m_meshes;
+		std::shared_ptr<IndirectDrawBuffer> m_indirectBuffer;
+		std::shared_ptr<CullingPass> m_cullingPass;
+		std::shared_ptr<DeferredLighting> m_deferredLighting;
+		std::shared_ptr<ClusteredLighting> m_clusteredLighting;
+		std::shared_ptr<InstanceBuffer> m_instanceBuffer;
+		std::shared_ptr<ImageUploader> m_imageUploader;
+		std::shared_ptr<TextureStreamer> m_textureStreamer;
+		std::shared_ptr<UniformRingBuffer> m_uniformBuffer;
+		std::shared_ptr<DescriptorAllocator> m_descriptorAllocator;
+		std::shared_ptr<BindlessTable> m_bindlessTable;
+		std::shared_ptr<FramePacer> m_framePacer;
 		std::shared_ptr<Device> m_device;
 		std::shared_ptr<Window> m_window;
 		std::shared_ptr<CommandBuffers> m_commandBuffers;
 		std::shared_ptr<std::vector<RenderingResourcesData>> m_renderingResources;
 
+		uint32_t m_textureIndex;
+		uint32_t m_streamedTexture;
+
+		// The event thread builds a frame while the render thread submits the other one
+		std::shared_ptr<std::vector<FrameData>> m_frames;
+		std::shared_ptr<SpscQueue<RenderCommand>> m_commands;
+		std::shared_ptr<SpscQueue<uint32_t>> m_freeFrames;
+
+		// The threads only sleep on these when a queue is empty or full
+		std::mutex m_wakeMutex;
+		std::condition_variable m_renderWake;
+		std::condition_variable m_eventWake;
+
+		std::atomic<bool> m_renderAvailable;
+		std::atomic<bool> m_renderFailed;
+		std::atomic<uint64_t> m_doneCommands;
+		uint64_t m_pushedCommands;
+
 	};
 }
 
@@ -0,0 +1,108 @@
+#include <iterator>
+
+#include <Neon/Core/RangeAllocator.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Constructs an empty allocator
+	*/
+	RangeAllocator::RangeAllocator() : m_freeRanges(), m_capacity(0), m_freeSize(0)
+	{}
+
+	/*
+	@brief : Constructs an allocator managing the range [0, capacity)
+	@param : The size of the managed range
+	*/
+	RangeAllocator::RangeAllocator(uint64_t capacity) : m_freeRanges(), m_capacity(capacity), m_freeSize(0)
+	{
+		Clear();
+	}
+
+	/*
+	@brief : Allocates an aligned range in the first free range large enough
+	@param : The size of the range
+	@param : The alignment of the offset, 0 or 1 for none
+	@param : The offset of the allocated range
+	@return : Returns true if the allocation is a success, false if no free range fits
+	*/
+	bool RangeAllocator::Allocate(uint64_t size, uint64_t alignment, uint64_t& offset)
+	{
+		if (size == 0)
+			return false;
+
+		for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it)
+		{
+			uint64_t begin = it->first;
+			uint64_t end = it->first + it->second;
+			uint64_t aligned = (alignment > 1) ? ((begin + alignment - 1) / alignment) * alignment : begin;
+
+			if (aligned + size > end)
+				continue;
+
+			m_freeRanges.erase(it);
+
+			// The padding in front of the aligned offset and the tail stay free
+			if (aligned > begin)
+				m_freeRanges[begin] = aligned - begin;
+
+			if (aligned + size < end)
+				m_freeRanges[aligned + size] = end - (aligned + size);
+
+			m_freeSize -= size;
+			offset = aligned;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	/*
+	@brief : Gives back a range, it is merged with its free neighbours
+	@param : The offset returned by Allocate
+	@param : The size given to Allocate
+	*/
+	void RangeAllocator::Free(uint64_t offset, uint64_t size)
+	{
+		if ((size == 0) || (offset + size > m_capacity))
+			return;
+
+		m_freeSize += size;
+
+		uint64_t end = offset + size;
+		auto next = m_freeRanges.lower_bound(offset);
+
+		if ((next != m_freeRanges.end()) && (next->first == end))
+		{
+			end += next->second;
+			next = m_freeRanges.erase(next);
+		}
+
+		if (next != m_freeRanges.begin())
+		{
+			auto previous = std::prev(next);
+
+			if (previous->first + previous->second == offset)
+			{
+				previous->second = end - previous->first;
+				return;
+			}
+		}
+
+		m_freeRanges[offset] = end - offset;
+	}
+
+	/*
+	@brief : Frees every allocation at once
+	*/
+	void RangeAllocator::Clear()
+	{
+		m_freeRanges.clear();
+
+		if (m_capacity > 0)
+			m_freeRanges[0] = m_capacity;
+
+		m_freeSize = m_capacity;
+	}
+}
\ No newline at end of file
@@ -3,13 +3,32 @@
 #include <map>
 #include <memory>
 
+#include <Neon/Core/File.hpp>
 #include <Neon/Renderer/Device.hpp>
 #include <Neon/Renderer/SwapChain.hpp>
 #include <Neon/Renderer/Renderer.hpp>
 #include <Neon/Renderer/Pipeline.hpp>
 #include <Neon/Renderer/RenderPass.hpp>
 #include <Neon/Renderer/Window.hpp>
-#include <Neon/Renderer/VertexBuffer.hpp>
+#include <Neon/Renderer/GeometryPool.hpp>
+#include <Neon/Renderer/MeshLod.hpp>
+#include <Neon/Renderer/IndirectDrawBuffer.hpp>
+#include <Neon/Renderer/CullingPass.hpp>
+#include <Neon/Renderer/DeferredLighting.hpp>
+#include <Neon/Renderer/ClusteredLighting.hpp>
+#include <Neon/Renderer/InstanceBuffer.hpp>
+#include <Neon/Renderer/VertexLayout.hpp>
+#include <Neon/Renderer/MeshOptimizer.hpp>
+#include <Neon/Renderer/DescriptorLayoutCache.hpp>
+#include <Neon/Renderer/DescriptorAllocator.hpp>
+#include <Neon/Renderer/UniformRingBuffer.hpp>
+#include <Neon/Renderer/BindlessTable.hpp>
+#include <Neon/Renderer/FramePacer.hpp>
+#include <Neon/Renderer/MemoryAllocator.hpp>
+#include <Neon/Renderer/SamplerCache.hpp>
+#include <Neon/Renderer/ImageUploader.hpp>
+#include <Neon/Renderer/Texture.hpp>
+#include <Neon/Renderer/TextureStreamer.hpp>
 #include <Neon/Renderer/ShaderModule.hpp>
 #include <Neon/Renderer/Sync.hpp>
 #include <Neon/Renderer/CommandBuffers.hpp>
@@ -26,13 +45,138 @@ int main(void)
 
 	window.CreateZWindow(500, 500, "toto");
 
+	// Mailbox keeps the latency low without tearing, Uncapped measures the throughput and VSync saves power
+	swap.SetInfo(SwapChainInfo::LowLatency());
+
 	Renderer renderer(device, window, swap);
 
-	RenderPass renderPass(device, swap);
+	// The surface may not support the policy, the swap chain reports what it got
+	std::cout << "Swap chain with present mode " << swap.GetPresentMode() << " and " << swap.GetImageCount() << " images" << std::endl;
+
+	// Images share large blocks of device memory, the depth attachment included
+	MemoryAllocator memoryAllocator(device);
+
+	// The depth pre-pass only pays off with costly fragments, the color subpass then shades each pixel once
+	// The samples are resolved inside the render pass, the multisampled attachments are never written to memory
+	RenderPassInfo renderPassInfo;
+	renderPassInfo.depthPrePass = false;
+	renderPassInfo.samples = VK_SAMPLE_COUNT_4_BIT;
+
+	// The deferred path lights each pixel once whatever the number of lights, switch it to measure it against the forward path
+	renderPassInfo.deferred = false;
+
+	RenderPass renderPass(device, swap, memoryAllocator, renderPassInfo);
+
+	DescriptorLayoutCache layoutCache(device);
+	DescriptorAllocator descriptorAllocator(device);
+
+	UniformRingBuffer uniformBuffer(device, layoutCache, descriptorAllocator, 64 * 1024);
+
+	BindlessTable bindlessTable(device, layoutCache);
+
+	PipelineInfo pipelineInfo;
+	pipelineInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	pipelineInfo.descriptorSetLayouts.push_back(uniformBuffer.GetDescriptorSetLayout());
+
+	// Set 1 holds every texture and buffer, a draw only pushes the indices of its material
+	if (bindlessTable.IsAvailable())
+	{
+		pipelineInfo.descriptorSetLayouts.push_back(bindlessTable.GetDescriptorSetLayout());
+		pipelineInfo.pushConstantRanges.push_back(BindlessTable::GetPushConstantRange(4));
+	}
+
+	// The forward shading only reads the lights of the cluster of its fragment, the set follows the bindless table
+	ClusteredLighting clusteredLighting(device, layoutCache, descriptorAllocator);
+
+	if (!renderPass.IsDeferred() && clusteredLighting.IsValid())
+		pipelineInfo.descriptorSetLayouts.push_back(clusteredLighting.GetDescriptorSetLayout());
+
+	// Binding 0 reads 16 bytes vertices, the normal takes location 2 so the instance attributes start at 3
+	VertexLayout::Compact().Apply(pipelineInfo);
+
+	// Binding 1 streams a transform and a color per instance, copies of a mesh are drawn in one call
+	InstanceBuffer::AddVertexInput(pipelineInfo, 1, 3);
+
+	// The deferred geometry writes the albedo and the normal instead of the shaded color
+	if (renderPass.IsDeferred())
+		pipelineInfo.fragmentShader = "C:/Users/Lucas/Documents/Neon/shaders/gbuffer.spv";
+
+	Pipeline pipeline(device, renderPass, swap, pipelineInfo);
+
+	DeferredLighting deferredLighting(device, renderPass, swap, layoutCache, descriptorAllocator);
+
+	std::vector<VertexData> vertices =
+	{
+		{ -0.7f, -0.7f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f },
+		{ -0.7f, 0.7f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f },
+		{ 0.7f, -0.7f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f },
+		{ 0.7f, 0.7f, 0.0f, 1.0f, 0.3f, 0.3f, 0.3f, 0.0f }
+	};
+
+	std::vector<uint32_t> indices = { 0, 1, 2, 2, 1, 3 };
+
+	// Meshes are reordered for the vertex cache, overdraw and vertex fetch before they are packed
+	MeshStatistics statistics = AnalyzeMesh(vertices.data(), static_cast<uint32_t>(vertices.size()), sizeof(VertexData), indices);
 
-	Pipeline pipeline(device, renderPass, swap);
+	vertices.resize(OptimizeMesh(vertices.data(), static_cast<uint32_t>(vertices.size()), sizeof(VertexData), indices));
+	MeshStatistics optimizedStatistics = AnalyzeMesh(vertices.data(), static_cast<uint32_t>(vertices.size()), sizeof(VertexData), indices);
 
-	VertexBuffer vertexBuffer(device);
+	std::cout << "Mesh 0 : ACMR " << statistics.acmr << " -> " << optimizedStatistics.acmr << ", ATVR " << statistics.atvr << " -> " << optimizedStatistics.atvr
+		<< ", overdraw " << statistics.overdraw << " -> " << optimizedStatistics.overdraw << ", overfetch " << statistics.overfetch << " -> "
+		<< optimizedStatistics.overfetch << std::endl;
+
+	std::vector<CompactVertexData> compactVertices;
+	PackVertices(vertices, nullptr, compactVertices);
+
+	// Every mesh of the scene lives in the same buffers, they are bound once per frame
+	GeometryPool geometryPool(device, 1 << 16, 3 << 16, sizeof(CompactVertexData));
+	std::vector<MeshRange> meshes(1);
+
+	geometryPool.AddMesh(compactVertices.data(), static_cast<uint32_t>(compactVertices.size()), indices, meshes[0]);
+
+	// The levels of detail share the vertices of their mesh, a level is picked per object from its error on the screen
+	std::vector<std::vector<MeshLod>> meshLods(meshes.size());
+
+	BuildMeshLods(geometryPool, meshes[0], indices, &vertices[0].x, sizeof(VertexData), meshLods[0]);
+
+	// The texels of the images go through the staging region of the frame recording them
+	SamplerCache samplerCache(device);
+	ImageUploader imageUploader(device, 8 * 1024 * 1024);
+
+	std::vector<uint32_t> checkerTexels(64 * 64);
+
+	for (uint32_t i = 0; i < checkerTexels.size(); i++)
+		checkerTexels[i] = ((((i % 64) / 8) + ((i / 64) / 8)) % 2 == 0) ? 0xFFFFFFFF : 0xFF404040;
+
+	Texture checkerTexture(device, memoryAllocator, samplerCache, 64, 64, VK_FORMAT_R8G8B8A8_UNORM);
+	checkerTexture.Upload(imageUploader, checkerTexels.data(), checkerTexels.size() * sizeof(uint32_t));
+
+	uint32_t textureIndex = BindlessTable::InvalidIndex;
+
+	if (bindlessTable.IsAvailable())
+		textureIndex = bindlessTable.AddTexture(checkerTexture.GetImageView(), checkerTexture.GetSampler());
+
+	// Block compressed textures keep their format on the device, or are transcoded when the device cannot sample it
+	File albedoFile("C:/Users/Lucas/Documents/Neon/textures/albedo.ktx2");
+	Texture albedoTexture;
+
+	if (albedoFile.IsExist())
+		albedoTexture = Texture(device, memoryAllocator, samplerCache, imageUploader, albedoFile);
+
+	if (albedoTexture.IsValid() && bindlessTable.IsAvailable())
+		textureIndex = bindlessTable.AddTexture(albedoTexture.GetImageView(), albedoTexture.GetSampler());
+
+	// Large textures start with their smallest levels, the others are streamed in from their size on the screen within the memory budget
+	TextureStreamer textureStreamer(device, memoryAllocator, samplerCache, imageUploader, bindlessTable);
+	File terrainFile("C:/Users/Lucas/Documents/Neon/textures/terrain.ktx2");
+	uint32_t streamedTexture = TextureStreamer::InvalidHandle;
+
+	if (terrainFile.IsExist())
+		streamedTexture = textureStreamer.Add(terrainFile);
+
+	IndirectDrawBuffer indirectBuffer(device, 4096);
+	CullingPass cullingPass(device, layoutCache, descriptorAllocator, indirectBuffer, 4096);
+	InstanceBuffer instanceBuffer(device, 100000);
 
 	CommandBuffers commandBuffers(device, swap, pipeline, renderPass);
 
@@ -40,7 +184,12 @@ int main(void)
 
 	Sync sync(device, *renderingRessources);
 
-	Test1 test1(renderPass, swap, pipeline, vertexBuffer, device, window, commandBuffers, *renderingRessources);
+	// The frames start just in time for the next refresh, a maximum frame rate also caps the uncapped present modes
+	FramePacer framePacer(device, swap);
+
+	std::cout << "Frame pacing " << (framePacer.IsPresentWaitEnabled() ? "waits for the presents" : "predicts the GPU") << std::endl;
+
+	Test1 test1(renderPass, swap, pipeline, geometryPool, meshLods, indirectBuffer, cullingPass, deferredLighting, clusteredLighting, instanceBuffer, imageUploader, textureIndex, textureStreamer, streamedTexture, uniformBuffer, descriptorAllocator, bindlessTable, framePacer, device, window, commandBuffers, *renderingRessources);
 	
 	test1.RenderingLoop();
 
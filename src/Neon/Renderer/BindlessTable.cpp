@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/DescriptorLayoutCache.hpp>
+#include <Neon/Renderer/BindlessTable.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates the table of every texture and buffer seen by the shaders, the table stays empty if the device has no descriptor indexing
+	@param : A reference to the Device
+	@param : The cache giving the layout of the table
+	@param : The number of textures the table can hold, clamped to the limits of the device
+	@param : The number of storage buffers the table can hold, clamped to the limits of the device
+	*/
+	BindlessTable::BindlessTable(Device& device, DescriptorLayoutCache& layoutCache, uint32_t maxTextures, uint32_t maxBuffers)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_bindlessTable = std::make_shared<BindlessTables>();
+
+		m_bindlessTable->textures.capacity = maxTextures;
+		m_bindlessTable->buffers.capacity = maxBuffers;
+
+		if (!m_device->GetDevice()->descriptorIndexing)
+			std::cout << "Descriptor indexing is not supported, bindless resources are disabled" << std::endl;
+		else if (!CreateDescriptorSet(layoutCache))
+			std::cout << "Failed to create bindless descriptor set" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the slots of the table
+	@param : A constant reference to the BindlessTable to copy
+	*/
+	BindlessTable::BindlessTable(const BindlessTable& bindlessTable) : m_device(bindlessTable.m_device), m_bindlessTable(bindlessTable.m_bindlessTable)
+	{}
+
+	/*
+	@brief : Destroys the pool of the table once its last owner goes away, the layout belongs to the cache
+	*/
+	BindlessTable::~BindlessTable()
+	{
+		if ((m_bindlessTable == nullptr) || (m_bindlessTable.use_count() > 1))
+			return;
+
+		if (m_bindlessTable->descriptorPool != VK_NULL_HANDLE)
+		{
+			vkDestroyDescriptorPool(m_device->GetDevice()->logicalDevice, m_bindlessTable->descriptorPool, nullptr);
+			m_bindlessTable->descriptorPool = VK_NULL_HANDLE;
+		}
+	}
+
+	/*
+	@brief : Gives back to the table the slots removed by frames which are now over, to call once the Device began the frame
+	*/
+	void BindlessTable::BeginFrame()
+	{
+		for (Slots* slots : { &m_bindlessTable->textures, &m_bindlessTable->buffers })
+		{
+			slots->retiredIndices.Release(m_device->GetDevice()->frameCounter, [slots](uint32_t index)
+			{
+				slots->freeIndices.push_back(index);
+			});
+		}
+	}
+
+	/*
+	@brief : Writes a texture in a free slot of the table
+	@param : The view of the texture
+	@param : The sampler of the texture
+	@param : The layout of the texture when the shaders read it
+	@return : Returns the index of the texture in the table, InvalidIndex if the table is full or unavailable
+	*/
+	uint32_t BindlessTable::AddTexture(VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout)
+	{
+		if (!IsAvailable())
+			return InvalidIndex;
+
+		uint32_t index = AcquireSlot(m_bindlessTable->textures);
+		if (index == InvalidIndex)
+		{
+			std::cout << "Bindless table is full of textures" << std::endl;
+			return InvalidIndex;
+		}
+
+		VkDescriptorImageInfo imageInfo =
+		{
+			sampler,
+			imageView,
+			imageLayout
+		};
+
+		VkWriteDescriptorSet writeDescriptorSet =
+		{
+			VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			nullptr,
+			m_bindlessTable->descriptorSet,
+			0,
+			index,
+			1,
+			VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+			&imageInfo,
+			nullptr,
+			nullptr
+		};
+
+		vkUpdateDescriptorSets(m_device->GetDevice()->logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
+
+		return index;
+	}
+
+	/*
+	@brief : Writes a storage buffer in a free slot of the table
+	@param : The buffer
+	@param : The offset of the range seen by the shaders
+	@param : The size of the range seen by the shaders
+	@return : Returns the index of the buffer in the table, InvalidIndex if the table is full or unavailable
+	*/
+	uint32_t BindlessTable::AddBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+	{
+		if (!IsAvailable())
+			return InvalidIndex;
+
+		uint32_t index = AcquireSlot(m_bindlessTable->buffers);
+		if (index == InvalidIndex)
+		{
+			std::cout << "Bindless table is full of buffers" << std::endl;
+			return InvalidIndex;
+		}
+
+		VkDescriptorBufferInfo bufferInfo =
+		{
+			buffer,
+			offset,
+			range
+		};
+
+		VkWriteDescriptorSet writeDescriptorSet =
+		{
+			VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			nullptr,
+			m_bindlessTable->descriptorSet,
+			1,
+			index,
+			1,
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			nullptr,
+			&bufferInfo,
+			nullptr
+		};
+
+		vkUpdateDescriptorSets(m_device->GetDevice()->logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
+
+		return index;
+	}
+
+	/*
+	@brief : Frees the slot of a texture, it is reused once the frames in flight are over
+	@param : The index given by AddTexture
+	*/
+	void BindlessTable::RemoveTexture(uint32_t index)
+	{
+		RetireSlot(m_bindlessTable->textures, index);
+	}
+
+	/*
+	@brief : Frees the slot of a buffer, it is reused once the frames in flight are over
+	@param : The index given by AddBuffer
+	*/
+	void BindlessTable::RemoveBuffer(uint32_t index)
+	{
+		RetireSlot(m_bindlessTable->buffers, index);
+	}
+
+	/*
+	@brief : Binds the table, it stays bound while materials change since they only push other indices
+	@param : The command buffer in recording state
+	@param : The layout of the bound pipeline
+	@param : The set number of the table in the pipeline layout
+	@param : The bind point of the pipeline
+	*/
+	void BindlessTable::Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, VkPipelineBindPoint bindPoint) const
+	{
+		vkCmdBindDescriptorSets(commandBuffer, bindPoint, pipelineLayout, set, 1, &m_bindlessTable->descriptorSet, 0, nullptr);
+	}
+
+	/*
+	@brief : Pushes the indices of the resources used by the next draws
+	@param : The command buffer in recording state
+	@param : The layout of the bound pipeline, created with GetPushConstantRange
+	@param : The indices in the table
+	@param : The number of indices
+	*/
+	void BindlessTable::PushIndices(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const uint32_t* indices, uint32_t indexCount) const
+	{
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_ALL, 0, indexCount * sizeof(uint32_t), indices);
+	}
+
+	/*
+	@brief : Gets the push constant range holding the indices of the resources
+	@param : The number of indices pushed for each draw
+	@return : Returns the range to add to the PipelineInfo
+	*/
+	VkPushConstantRange BindlessTable::GetPushConstantRange(uint32_t indexCount)
+	{
+		return { VK_SHADER_STAGE_ALL, 0, indexCount * static_cast<uint32_t>(sizeof(uint32_t)) };
+	}
+
+	/*
+	@brief : Assigns the table by move semantic
+	@param : The table to move
+	@return : A reference to this
+	*/
+	BindlessTable& BindlessTable::operator=(BindlessTable&& bindlessTable) noexcept
+	{
+		std::swap(m_device, bindlessTable.m_device);
+		std::swap(m_bindlessTable, bindlessTable.m_bindlessTable);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool BindlessTable::CreateDescriptorSet(DescriptorLayoutCache& layoutCache)
+	{
+		VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties = {};
+		indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+		VkPhysicalDeviceProperties2 deviceProperties = {};
+		deviceProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		deviceProperties.pNext = &indexingProperties;
+
+		vkGetPhysicalDeviceProperties2(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		Slots& textures = m_bindlessTable->textures;
+		Slots& buffers = m_bindlessTable->buffers;
+
+		textures.capacity = std::min({ textures.capacity, indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+			indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages });
+		buffers.capacity = std::min({ buffers.capacity, indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+			indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers });
+
+		std::vector<VkDescriptorSetLayoutBinding> layoutBindings =
+		{
+			{
+				0,
+				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+				textures.capacity,
+				VK_SHADER_STAGE_ALL,
+				nullptr
+			},
+			{
+				1,
+				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				buffers.capacity,
+				VK_SHADER_STAGE_ALL,
+				nullptr
+			}
+		};
+
+		// Slots may stay empty, and may be written while other slots are used by frames in flight
+		VkDescriptorBindingFlagsEXT bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT
+			| VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+		m_bindlessTable->descriptorSetLayout = layoutCache.GetLayout(layoutBindings, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+			{ bindingFlags, bindingFlags });
+
+		if (m_bindlessTable->descriptorSetLayout == VK_NULL_HANDLE)
+			return false;
+
+		std::vector<VkDescriptorPoolSize> poolSizes =
+		{
+			{
+				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+				textures.capacity
+			},
+			{
+				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				buffers.capacity
+			}
+		};
+
+		VkDescriptorPoolCreateInfo poolCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			nullptr,
+			VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT,
+			1,
+			static_cast<uint32_t>(poolSizes.size()),
+			poolSizes.data()
+		};
+
+		if (vkCreateDescriptorPool(m_device->GetDevice()->logicalDevice, &poolCreateInfo, nullptr, &m_bindlessTable->descriptorPool) != VK_SUCCESS)
+		{
+			std::cout << "Failed to create descriptor pool" << std::endl;
+			return false;
+		}
+
+		VkDescriptorSetAllocateInfo setAllocateInfo =
+		{
+			VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			nullptr,
+			m_bindlessTable->descriptorPool,
+			1,
+			&m_bindlessTable->descriptorSetLayout
+		};
+
+		if (vkAllocateDescriptorSets(m_device->GetDevice()->logicalDevice, &setAllocateInfo, &m_bindlessTable->descriptorSet) != VK_SUCCESS)
+		{
+			std::cout << "Failed to allocate descriptor set" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	uint32_t BindlessTable::AcquireSlot(Slots& slots)
+	{
+		if (!slots.freeIndices.empty())
+		{
+			uint32_t index = slots.freeIndices.back();
+			slots.freeIndices.pop_back();
+
+			return index;
+		}
+
+		if (slots.count == slots.capacity)
+			return InvalidIndex;
+
+		return slots.count++;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void BindlessTable::RetireSlot(Slots& slots, uint32_t index)
+	{
+		if (index >= slots.count)
+			return;
+
+		slots.retiredIndices.Push(m_device->GetDevice()->frameCounter, index);
+	}
+}
\ No newline at end of file
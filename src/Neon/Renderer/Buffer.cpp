@@ -0,0 +1,349 @@
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/Buffer.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a buffer, a host visible buffer stays mapped for all its life
+	@param : A reference to the Device
+	@param : The size of the buffer in bytes
+	@param : The usage of the buffer (vertex, index, uniform, storage, indirect...)
+	@param : The memory properties of the buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT alone for a buffer only written by transfers
+	@param : The data to upload in the buffer, nullptr to leave it uninitialized
+	@param : The queue families using the buffer, it is shared between them when they differ
+	*/
+	Buffer::Buffer(Device& device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties, const void* data,
+		const std::vector<uint32_t>& queueFamilies)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_buffer = std::make_shared<Buffers>();
+
+		m_buffer->size = size;
+		m_buffer->usage = usage;
+
+		// Device local memory is only reachable through a staging copy
+		if (!(memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+			m_buffer->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+		if (!CreateBuffer(memoryProperties, queueFamilies))
+			std::cout << "Failed to create buffer" << std::endl;
+		else if ((data != nullptr) && !Upload(data, size))
+			std::cout << "Failed to upload buffer data" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the buffer
+	@param : A constant reference to the Buffer to copy
+	*/
+	Buffer::Buffer(const Buffer& buffer) : m_device(buffer.m_device), m_buffer(buffer.m_buffer)
+	{}
+
+	/*
+	@brief : Destroys the buffer and frees its memory once its last owner goes away
+	*/
+	Buffer::~Buffer()
+	{
+		if ((m_buffer == nullptr) || (m_buffer.use_count() > 1))
+			return;
+
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		if (m_buffer->buffer != VK_NULL_HANDLE)
+		{
+			vkDestroyBuffer(logicalDevice, m_buffer->buffer, nullptr);
+			m_buffer->buffer = VK_NULL_HANDLE;
+		}
+
+		if (m_buffer->memory != VK_NULL_HANDLE)
+		{
+			if (m_buffer->data != nullptr)
+				vkUnmapMemory(logicalDevice, m_buffer->memory);
+
+			vkFreeMemory(logicalDevice, m_buffer->memory, nullptr);
+			m_buffer->memory = VK_NULL_HANDLE;
+			m_buffer->data = nullptr;
+		}
+	}
+
+	/*
+	@brief : Writes data in the buffer, directly when it is mapped, through a staging buffer otherwise
+	@param : The data to write
+	@param : The size of the data in bytes
+	@param : The offset in the buffer where the data is written
+	@return : Returns true if the upload is a success, false otherwise
+	*/
+	bool Buffer::Upload(const void* data, VkDeviceSize size, VkDeviceSize offset)
+	{
+		if (offset + size > m_buffer->size)
+		{
+			std::cout << "Upload of " << size << " bytes overflows the buffer" << std::endl;
+			return false;
+		}
+
+		if (m_buffer->data == nullptr)
+			return UploadStaged(data, size, offset);
+
+		std::memcpy(m_buffer->data + offset, data, static_cast<std::size_t>(size));
+
+		return Flush(offset, size);
+	}
+
+	/*
+	@brief : Makes the host writes of a range visible to the device, it does nothing on coherent memory
+	@param : The offset of the range
+	@param : The size of the range
+	@return : Returns true if the flush is a success, false otherwise
+	*/
+	bool Buffer::Flush(VkDeviceSize offset, VkDeviceSize size)
+	{
+		if ((m_buffer->data == nullptr) || (m_buffer->memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+			return true;
+
+		VkDeviceSize end = (size == VK_WHOLE_SIZE) ? m_buffer->allocationSize : offset + size;
+
+		// The range must be aligned on the atom size, or end with the memory
+		VkDeviceSize begin = (offset / m_buffer->atomSize) * m_buffer->atomSize;
+		end = ((end + m_buffer->atomSize - 1) / m_buffer->atomSize) * m_buffer->atomSize;
+
+		if (end > m_buffer->allocationSize)
+			end = m_buffer->allocationSize;
+
+		VkMappedMemoryRange mappedMemoryRange =
+		{
+			VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+			nullptr,
+			m_buffer->memory,
+			begin,
+			end - begin
+		};
+
+		if (vkFlushMappedMemoryRanges(m_device->GetDevice()->logicalDevice, 1, &mappedMemoryRange) != VK_SUCCESS)
+		{
+			std::cout << "Failed to flush buffer memory" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	/*
+	@brief : Assigns the buffer by move semantic
+	@param : The buffer to move
+	@return : A reference to this
+	*/
+	Buffer& Buffer::operator=(Buffer&& buffer) noexcept
+	{
+		std::swap(m_device, buffer.m_device);
+		std::swap(m_buffer, buffer.m_buffer);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool Buffer::CreateBuffer(VkMemoryPropertyFlags memoryProperties, const std::vector<uint32_t>& queueFamilies)
+	{
+		std::vector<uint32_t> sharingFamilies(queueFamilies);
+
+		std::sort(sharingFamilies.begin(), sharingFamilies.end());
+		sharingFamilies.erase(std::unique(sharingFamilies.begin(), sharingFamilies.end()), sharingFamilies.end());
+
+		// A concurrent buffer needs no ownership transfer between the queues
+		bool isConcurrent = sharingFamilies.size() > 1;
+
+		VkBufferCreateInfo bufferCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			nullptr,
+			0,
+			m_buffer->size,
+			m_buffer->usage,
+			isConcurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+			isConcurrent ? static_cast<uint32_t>(sharingFamilies.size()) : 0,
+			isConcurrent ? sharingFamilies.data() : nullptr
+		};
+
+		if (vkCreateBuffer(m_device->GetDevice()->logicalDevice, &bufferCreateInfo, nullptr, &m_buffer->buffer) != VK_SUCCESS)
+		{
+			std::cout << "Failed to create buffer" << std::endl;
+			return false;
+		}
+
+		if (!AllocateBufferMemory(memoryProperties))
+		{
+			std::cout << "Failed to allocate buffer memory" << std::endl;
+			return false;
+		}
+
+		if (vkBindBufferMemory(m_device->GetDevice()->logicalDevice, m_buffer->buffer, m_buffer->memory, 0) != VK_SUCCESS)
+		{
+			std::cout << "Failed to bind buffer memory" << std::endl;
+			return false;
+		}
+
+		if (!(m_buffer->memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+			return true;
+
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		m_buffer->atomSize = deviceProperties.limits.nonCoherentAtomSize;
+
+		void* data = nullptr;
+		if (vkMapMemory(m_device->GetDevice()->logicalDevice, m_buffer->memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS)
+		{
+			std::cout << "Failed to map buffer memory" << std::endl;
+			return false;
+		}
+
+		m_buffer->data = static_cast<char*>(data);
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool Buffer::AllocateBufferMemory(VkMemoryPropertyFlags memoryProperties)
+	{
+		VkMemoryRequirements memoryRequirements;
+		vkGetBufferMemoryRequirements(m_device->GetDevice()->logicalDevice, m_buffer->buffer, &memoryRequirements);
+
+		VkPhysicalDeviceMemoryProperties deviceMemoryProperties;
+		vkGetPhysicalDeviceMemoryProperties(m_device->GetDevice()->physicalDevice, &deviceMemoryProperties);
+
+		// Host coherent memory is preferred for mapped buffers, it saves the flushes
+		VkMemoryPropertyFlags preferredFlags[] =
+		{
+			(memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ? (memoryProperties | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) : memoryProperties,
+			memoryProperties
+		};
+
+		for (VkMemoryPropertyFlags flags : preferredFlags)
+		{
+			for (uint32_t i = 0; i < deviceMemoryProperties.memoryTypeCount; i++)
+			{
+				if ((memoryRequirements.memoryTypeBits & (1 << i)) && ((deviceMemoryProperties.memoryTypes[i].propertyFlags & flags) == flags))
+				{
+					VkMemoryAllocateInfo memoryAllocateInfo =
+					{
+						VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+						nullptr,
+						memoryRequirements.size,
+						i
+					};
+
+					if (vkAllocateMemory(m_device->GetDevice()->logicalDevice, &memoryAllocateInfo, nullptr, &m_buffer->memory) == VK_SUCCESS)
+					{
+						m_buffer->allocationSize = memoryRequirements.size;
+						m_buffer->memoryProperties = deviceMemoryProperties.memoryTypes[i].propertyFlags;
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool Buffer::UploadStaged(const void* data, VkDeviceSize size, VkDeviceSize offset)
+	{
+		Buffer stagingBuffer(*m_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, data);
+
+		if (!stagingBuffer.IsValid())
+			return false;
+
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		VkCommandPoolCreateInfo commandPoolInfo =
+		{
+			VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			nullptr,
+			VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+			m_device->GetDevice()->graphicsIndexFamily
+		};
+
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		if (vkCreateCommandPool(logicalDevice, &commandPoolInfo, nullptr, &commandPool) != VK_SUCCESS)
+		{
+			std::cout << "Failed to create command pool" << std::endl;
+			return false;
+		}
+
+		VkCommandBufferAllocateInfo commandBufferAllocate =
+		{
+			VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+			nullptr,
+			commandPool,
+			VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+			1
+		};
+
+		VkCommandBufferBeginInfo commandBufferBeginInfo =
+		{
+			VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			nullptr,
+			VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+			nullptr
+		};
+
+		VkFenceCreateInfo fenceCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+			nullptr,
+			0
+		};
+
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE;
+		bool result = false;
+
+		if ((vkAllocateCommandBuffers(logicalDevice, &commandBufferAllocate, &commandBuffer) == VK_SUCCESS)
+			&& (vkCreateFence(logicalDevice, &fenceCreateInfo, nullptr, &fence) == VK_SUCCESS)
+			&& (vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo) == VK_SUCCESS))
+		{
+			VkBufferCopy bufferCopy =
+			{
+				0,
+				offset,
+				size
+			};
+
+			vkCmdCopyBuffer(commandBuffer, stagingBuffer.GetBuffer(), m_buffer->buffer, 1, &bufferCopy);
+
+			VkSubmitInfo submitInfo =
+			{
+				VK_STRUCTURE_TYPE_SUBMIT_INFO,
+				nullptr,
+				0,
+				nullptr,
+				nullptr,
+				1,
+				&commandBuffer,
+				0,
+				nullptr
+			};
+
+			result = (vkEndCommandBuffer(commandBuffer) == VK_SUCCESS)
+				&& (vkQueueSubmit(m_device->GetDevice()->graphicsQueue, 1, &submitInfo, fence) == VK_SUCCESS)
+				&& (vkWaitForFences(logicalDevice, 1, &fence, VK_TRUE, UINT64_MAX) == VK_SUCCESS);
+		}
+
+		if (!result)
+			std::cout << "Failed to copy the staging buffer" << std::endl;
+
+		if (fence != VK_NULL_HANDLE)
+			vkDestroyFence(logicalDevice, fence, nullptr);
+
+		vkDestroyCommandPool(logicalDevice, commandPool, nullptr);
+
+		return result;
+	}
+}
\ No newline at end of file
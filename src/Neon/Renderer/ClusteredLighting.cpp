@@ -0,0 +1,514 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <thread>
+
+#include <Neon/Utils.hpp>
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/DescriptorLayoutCache.hpp>
+#include <Neon/Renderer/DescriptorAllocator.hpp>
+#include <Neon/Renderer/ClusteredLighting.hpp>
+
+#if defined(NEON_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace Zx
+{
+	namespace
+	{
+		// Below this many lights the binning costs less than starting the threads
+		const std::size_t ThreadedLightCount = 64;
+
+		inline uint32_t ClampTile(float tile, uint32_t tileCount)
+		{
+			return static_cast<uint32_t>(std::min(std::max(tile, 0.0f), static_cast<float>(tileCount - 1)));
+		}
+	}
+
+	/*
+	@brief : Creates the clustered light assignment of the forward path, the fragment shader reads the header and the clusters (binding 0), the lights (binding 1) and the light indices (binding 2)
+	@param : A reference to the Device
+	@param : The cache giving the layout of the descriptor set
+	@param : The allocator giving the descriptor set
+	@param : The description of the clusters
+	@param : The number of frames in flight
+	*/
+	ClusteredLighting::ClusteredLighting(Device& device, DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator, const ClusteredLightingInfo& info,
+		uint32_t frameCount)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_clusteredLighting = std::make_shared<ClusteredLightings>();
+
+		m_clusteredLighting->info = info;
+		m_clusteredLighting->info.tileCountX = std::max(info.tileCountX, 1u);
+		m_clusteredLighting->info.tileCountY = std::max(info.tileCountY, 1u);
+		m_clusteredLighting->info.sliceCount = std::max(info.sliceCount, 1u);
+		m_clusteredLighting->frameCount = frameCount;
+
+		m_clusteredLighting->lights.reserve(info.maxLights);
+		m_clusteredLighting->clusters.resize(GetClusterCount());
+		m_clusteredLighting->sliceDepths.resize(m_clusteredLighting->info.sliceCount + 1);
+
+		if (!CreateBuffer())
+			std::cout << "Failed to create cluster buffer" << std::endl;
+		else if (!CreateDescriptorSet(layoutCache, descriptorAllocator))
+			std::cout << "Failed to create cluster descriptor set" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the clusters
+	@param : A constant reference to the ClusteredLighting to copy
+	*/
+	ClusteredLighting::ClusteredLighting(const ClusteredLighting& clusteredLighting) : m_device(clusteredLighting.m_device), m_clusteredLighting(clusteredLighting.m_clusteredLighting)
+	{}
+
+	/*
+	@brief : Rewinds the light list on the region of a frame
+	@param : The index of the frame in flight, its fence must have been waited on
+	*/
+	void ClusteredLighting::BeginFrame(uint32_t frameIndex)
+	{
+		m_clusteredLighting->frameIndex = frameIndex % std::max(m_clusteredLighting->frameCount, 1u);
+		m_clusteredLighting->lights.clear();
+		m_clusteredLighting->lightIndexCount = 0;
+	}
+
+	/*
+	@brief : Appends a light to the list assigned to the clusters of the current frame
+	@param : The light, its position in world space
+	@return : Returns true if the light is added, false if the list is full
+	*/
+	bool ClusteredLighting::AddLight(const PointLight& light)
+	{
+		if (m_clusteredLighting->lights.size() >= m_clusteredLighting->info.maxLights)
+		{
+			std::cout << "Clustered lighting is full for this frame" << std::endl;
+			return false;
+		}
+
+		m_clusteredLighting->lights.push_back(light);
+
+		return true;
+	}
+
+	/*
+	@brief : Bins the lights of the current frame in the clusters of the view frustum and makes the lists visible to the device
+	@param : The view matrix, 16 floats in column major order
+	@param : The perspective of the camera
+	@param : The extent of the framebuffer, it gives the size of the tiles in pixels
+	@return : Returns true if the lists are uploaded, false otherwise
+	*/
+	bool ClusteredLighting::Assign(const float* view, const ClusterProjection& projection, VkExtent2D extent)
+	{
+		if (!IsValid())
+			return false;
+
+		if ((projection.nearPlane <= 0.0f) || (projection.farPlane <= projection.nearPlane))
+		{
+			std::cout << "The clusters need a near plane in front of the camera and behind the far plane" << std::endl;
+			return false;
+		}
+
+		const ClusteredLightingInfo& info = m_clusteredLighting->info;
+
+		// The slice k starts at near * (far / near)^(k / sliceCount)
+		float depthRatio = std::log(projection.farPlane / projection.nearPlane);
+
+		m_clusteredLighting->sliceScale = info.sliceCount / depthRatio;
+		m_clusteredLighting->sliceBias = -m_clusteredLighting->sliceScale * std::log(projection.nearPlane);
+
+		for (uint32_t k = 0; k <= info.sliceCount; k++)
+			m_clusteredLighting->sliceDepths[k] = projection.nearPlane * std::exp(depthRatio * k / info.sliceCount);
+
+		TransformLights(view);
+
+		float tanHalfY = std::tan(projection.verticalFov * 0.5f);
+		float tanHalfX = tanHalfY * projection.aspect;
+
+		uint32_t threadCount = (info.threadCount != 0) ? info.threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+
+		if (m_clusteredLighting->lights.size() < ThreadedLightCount)
+			threadCount = 1;
+
+		// Each thread bins a contiguous range of slices, no cluster is written by two threads
+		uint32_t chunkCount = std::min(threadCount, info.sliceCount);
+		m_clusteredLighting->chunks.resize(chunkCount);
+
+		for (uint32_t i = 0; i < chunkCount; i++)
+		{
+			m_clusteredLighting->chunks[i].firstSlice = i * info.sliceCount / chunkCount;
+			m_clusteredLighting->chunks[i].lastSlice = (i + 1) * info.sliceCount / chunkCount;
+		}
+
+		std::vector<std::future<void>> binnings;
+
+		for (uint32_t i = 1; i < chunkCount; i++)
+		{
+			SliceChunk* chunk = &m_clusteredLighting->chunks[i];
+
+			binnings.push_back(std::async(std::launch::async, [this, chunk, tanHalfX, tanHalfY]()
+			{
+				BinSlices(*chunk, tanHalfX, tanHalfY);
+			}));
+		}
+
+		BinSlices(m_clusteredLighting->chunks[0], tanHalfX, tanHalfY);
+
+		for (std::future<void>& binning : binnings)
+			binning.wait();
+
+		// The offsets of a chunk start at its first index in the shared list
+		uint32_t clustersPerSlice = info.tileCountX * info.tileCountY;
+		uint32_t base = 0;
+
+		for (const SliceChunk& chunk : m_clusteredLighting->chunks)
+		{
+			for (uint32_t cluster = chunk.firstSlice * clustersPerSlice; cluster < chunk.lastSlice * clustersPerSlice; cluster++)
+				m_clusteredLighting->clusters[cluster].offset += base;
+
+			base += static_cast<uint32_t>(chunk.indices.size());
+		}
+
+		m_clusteredLighting->lightIndexCount = base;
+
+		return Upload(extent);
+	}
+
+	/*
+	@brief : Binds the clusters of the current frame
+	@param : The command buffer in recording state
+	@param : The layout of the pipeline, created with GetDescriptorSetLayout at the index set
+	@param : The index of the set in the layout
+	@param : The bind point of the pipeline
+	*/
+	void ClusteredLighting::Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, VkPipelineBindPoint bindPoint) const
+	{
+		uint32_t dynamicOffset = static_cast<uint32_t>(m_clusteredLighting->frameIndex * m_clusteredLighting->frameSize);
+		uint32_t dynamicOffsets[3] = { dynamicOffset, dynamicOffset, dynamicOffset };
+
+		vkCmdBindDescriptorSets(commandBuffer, bindPoint, pipelineLayout, set, 1, &m_clusteredLighting->descriptorSet, 3, dynamicOffsets);
+	}
+
+	/*
+	@brief : Assigns the clustered lighting by move semantic
+	@param : The clustered lighting to move
+	@return : A reference to this
+	*/
+	ClusteredLighting& ClusteredLighting::operator=(ClusteredLighting&& clusteredLighting) noexcept
+	{
+		std::swap(m_device, clusteredLighting.m_device);
+		std::swap(m_clusteredLighting, clusteredLighting.m_clusteredLighting);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool ClusteredLighting::CreateBuffer()
+	{
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		VkDeviceSize alignment = deviceProperties.limits.minStorageBufferOffsetAlignment;
+		const ClusteredLightingInfo& info = m_clusteredLighting->info;
+
+		m_clusteredLighting->clusterRegion = AlignUp(sizeof(ClusterHeader) + GetClusterCount() * sizeof(ClusterRange), alignment);
+		m_clusteredLighting->lightRegion = AlignUp(std::max(info.maxLights, 1u) * sizeof(PointLight), alignment);
+		m_clusteredLighting->indexRegion = AlignUp(std::max(info.maxLightIndices, 1u) * sizeof(uint32_t), alignment);
+		m_clusteredLighting->frameSize = m_clusteredLighting->clusterRegion + m_clusteredLighting->lightRegion + m_clusteredLighting->indexRegion;
+
+		m_clusteredLighting->buffer = Buffer(*m_device, m_clusteredLighting->frameSize * m_clusteredLighting->frameCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+		return m_clusteredLighting->buffer.IsValid();
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool ClusteredLighting::CreateDescriptorSet(DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator)
+	{
+		std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
+
+		for (uint32_t binding = 0; binding < 3; binding++)
+			layoutBindings.push_back({ binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr });
+
+		m_clusteredLighting->descriptorSetLayout = layoutCache.GetLayout(layoutBindings);
+
+		if (m_clusteredLighting->descriptorSetLayout == VK_NULL_HANDLE)
+			return false;
+
+		const VkBuffer& buffer = m_clusteredLighting->buffer.GetBuffer();
+		VkDeviceSize clusterRegion = m_clusteredLighting->clusterRegion;
+		VkDeviceSize lightRegion = m_clusteredLighting->lightRegion;
+
+		// The dynamic offsets select the region of the frame
+		m_clusteredLighting->descriptorSet = descriptorAllocator.GetImmutableSet(m_clusteredLighting->descriptorSetLayout,
+			{
+				DescriptorAllocator::BufferWrite(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, buffer, 0, clusterRegion),
+				DescriptorAllocator::BufferWrite(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, buffer, clusterRegion, lightRegion),
+				DescriptorAllocator::BufferWrite(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, buffer, clusterRegion + lightRegion, m_clusteredLighting->indexRegion)
+			});
+
+		return m_clusteredLighting->descriptorSet != VK_NULL_HANDLE;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void ClusteredLighting::TransformLights(const float* view)
+	{
+		const std::vector<PointLight>& lights = m_clusteredLighting->lights;
+		std::size_t lightCount = lights.size();
+
+		std::vector<float>& lightX = m_clusteredLighting->lightX;
+		std::vector<float>& lightY = m_clusteredLighting->lightY;
+		std::vector<float>& lightDepth = m_clusteredLighting->lightDepth;
+
+		lightX.resize(lightCount);
+		lightY.resize(lightCount);
+		lightDepth.resize(lightCount);
+
+		std::size_t i = 0;
+
+#if defined(NEON_SSE2)
+		const __m128 m0 = _mm_set1_ps(view[0]), m1 = _mm_set1_ps(view[1]), m2 = _mm_set1_ps(view[2]);
+		const __m128 m4 = _mm_set1_ps(view[4]), m5 = _mm_set1_ps(view[5]), m6 = _mm_set1_ps(view[6]);
+		const __m128 m8 = _mm_set1_ps(view[8]), m9 = _mm_set1_ps(view[9]), m10 = _mm_set1_ps(view[10]);
+		const __m128 m12 = _mm_set1_ps(view[12]), m13 = _mm_set1_ps(view[13]), m14 = _mm_set1_ps(view[14]);
+
+		for (; i + 4 <= lightCount; i += 4)
+		{
+			__m128 x = _mm_setr_ps(lights[i].position[0], lights[i + 1].position[0], lights[i + 2].position[0], lights[i + 3].position[0]);
+			__m128 y = _mm_setr_ps(lights[i].position[1], lights[i + 1].position[1], lights[i + 2].position[1], lights[i + 3].position[1]);
+			__m128 z = _mm_setr_ps(lights[i].position[2], lights[i + 1].position[2], lights[i + 2].position[2], lights[i + 3].position[2]);
+
+			__m128 viewX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_add_ps(_mm_mul_ps(m8, z), m12));
+			__m128 viewY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_add_ps(_mm_mul_ps(m9, z), m13));
+			__m128 viewZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_add_ps(_mm_mul_ps(m10, z), m14));
+
+			_mm_storeu_ps(&lightX[i], viewX);
+			_mm_storeu_ps(&lightY[i], viewY);
+			_mm_storeu_ps(&lightDepth[i], _mm_sub_ps(_mm_setzero_ps(), viewZ));
+		}
+#endif
+
+		for (; i < lightCount; i++)
+		{
+			const float* position = lights[i].position;
+
+			lightX[i] = view[0] * position[0] + view[4] * position[1] + view[8] * position[2] + view[12];
+			lightY[i] = view[1] * position[0] + view[5] * position[1] + view[9] * position[2] + view[13];
+			lightDepth[i] = -(view[2] * position[0] + view[6] * position[1] + view[10] * position[2] + view[14]);
+		}
+
+		m_clusteredLighting->firstSlice.resize(lightCount);
+		m_clusteredLighting->lastSlice.resize(lightCount);
+
+		const std::vector<float>& sliceDepths = m_clusteredLighting->sliceDepths;
+		float nearPlane = sliceDepths.front();
+		float farPlane = sliceDepths.back();
+		float maxSlice = static_cast<float>(m_clusteredLighting->info.sliceCount - 1);
+
+		// A light outside of the depth range gets an empty slice range
+		for (i = 0; i < lightCount; i++)
+		{
+			float radius = lights[i].radius;
+			float minDepth = lightDepth[i] - radius;
+			float maxDepth = lightDepth[i] + radius;
+
+			if ((maxDepth < nearPlane) || (minDepth > farPlane))
+			{
+				m_clusteredLighting->firstSlice[i] = 1;
+				m_clusteredLighting->lastSlice[i] = 0;
+				continue;
+			}
+
+			float firstSlice = std::log(std::max(minDepth, nearPlane)) * m_clusteredLighting->sliceScale + m_clusteredLighting->sliceBias;
+			float lastSlice = std::log(std::min(maxDepth, farPlane)) * m_clusteredLighting->sliceScale + m_clusteredLighting->sliceBias;
+
+			m_clusteredLighting->firstSlice[i] = static_cast<uint32_t>(std::min(std::max(std::floor(firstSlice), 0.0f), maxSlice));
+			m_clusteredLighting->lastSlice[i] = static_cast<uint32_t>(std::min(std::max(std::floor(lastSlice), 0.0f), maxSlice));
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	void ClusteredLighting::BinSlices(SliceChunk& chunk, float tanHalfX, float tanHalfY)
+	{
+		const ClusteredLightingInfo& info = m_clusteredLighting->info;
+		uint32_t lightCount = static_cast<uint32_t>(m_clusteredLighting->lights.size());
+
+		chunk.indices.clear();
+
+		for (uint32_t slice = chunk.firstSlice; slice < chunk.lastSlice; slice++)
+		{
+			chunk.rects.clear();
+
+			for (uint32_t light = 0; light < lightCount; light++)
+			{
+				if ((slice < m_clusteredLighting->firstSlice[light]) || (slice > m_clusteredLighting->lastSlice[light]))
+					continue;
+
+				TileRect rect;
+
+				if (ComputeTileRect(light, m_clusteredLighting->sliceDepths[slice], m_clusteredLighting->sliceDepths[slice + 1], tanHalfX, tanHalfY, rect))
+					chunk.rects.push_back(rect);
+			}
+
+			// The lists are counted then filled, the lights of a cluster keep their order
+			ClusterRange* clusters = &m_clusteredLighting->clusters[slice * info.tileCountX * info.tileCountY];
+
+			for (uint32_t cluster = 0; cluster < info.tileCountX * info.tileCountY; cluster++)
+				clusters[cluster].count = 0;
+
+			for (const TileRect& rect : chunk.rects)
+			{
+				for (uint32_t y = rect.y0; y <= rect.y1; y++)
+				{
+					for (uint32_t x = rect.x0; x <= rect.x1; x++)
+						clusters[y * info.tileCountX + x].count++;
+				}
+			}
+
+			uint32_t offset = static_cast<uint32_t>(chunk.indices.size());
+
+			for (uint32_t cluster = 0; cluster < info.tileCountX * info.tileCountY; cluster++)
+			{
+				clusters[cluster].offset = offset;
+				offset += clusters[cluster].count;
+				clusters[cluster].count = 0;
+			}
+
+			chunk.indices.resize(offset);
+
+			for (const TileRect& rect : chunk.rects)
+			{
+				for (uint32_t y = rect.y0; y <= rect.y1; y++)
+				{
+					for (uint32_t x = rect.x0; x <= rect.x1; x++)
+					{
+						ClusterRange& cluster = clusters[y * info.tileCountX + x];
+						chunk.indices[cluster.offset + cluster.count++] = rect.light;
+					}
+				}
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool ClusteredLighting::ComputeTileRect(uint32_t light, float nearDepth, float farDepth, float tanHalfX, float tanHalfY, TileRect& rect) const
+	{
+		float radius = m_clusteredLighting->lights[light].radius;
+		float depth = m_clusteredLighting->lightDepth[light];
+
+		// The box of the sphere cut by the slice, its x / depth and y / depth bounds give a conservative tile range
+		float minDepth = std::max(nearDepth, depth - radius);
+		float maxDepth = std::min(farDepth, depth + radius);
+
+		if (minDepth > maxDepth)
+			return false;
+
+		float minX = m_clusteredLighting->lightX[light] - radius;
+		float maxX = m_clusteredLighting->lightX[light] + radius;
+		float minY = m_clusteredLighting->lightY[light] - radius;
+		float maxY = m_clusteredLighting->lightY[light] + radius;
+
+		float minSlopeX = minX / ((minX >= 0.0f) ? maxDepth : minDepth);
+		float maxSlopeX = maxX / ((maxX >= 0.0f) ? minDepth : maxDepth);
+		float minSlopeY = minY / ((minY >= 0.0f) ? maxDepth : minDepth);
+		float maxSlopeY = maxY / ((maxY >= 0.0f) ? minDepth : maxDepth);
+
+		if ((maxSlopeX < -tanHalfX) || (minSlopeX > tanHalfX) || (maxSlopeY < -tanHalfY) || (minSlopeY > tanHalfY))
+			return false;
+
+		const ClusteredLightingInfo& info = m_clusteredLighting->info;
+
+		// The first row of tiles is at the top of the framebuffer, where the view space y is the highest
+		rect.light = light;
+		rect.x0 = ClampTile(std::floor((minSlopeX / tanHalfX + 1.0f) * 0.5f * info.tileCountX), info.tileCountX);
+		rect.x1 = ClampTile(std::floor((maxSlopeX / tanHalfX + 1.0f) * 0.5f * info.tileCountX), info.tileCountX);
+		rect.y0 = ClampTile(std::floor((1.0f - maxSlopeY / tanHalfY) * 0.5f * info.tileCountY), info.tileCountY);
+		rect.y1 = ClampTile(std::floor((1.0f - minSlopeY / tanHalfY) * 0.5f * info.tileCountY), info.tileCountY);
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool ClusteredLighting::Upload(VkExtent2D extent)
+	{
+		const ClusteredLightingInfo& info = m_clusteredLighting->info;
+
+		char* frame = static_cast<char*>(m_clusteredLighting->buffer.GetData()) + m_clusteredLighting->frameIndex * m_clusteredLighting->frameSize;
+		char* lightData = frame + m_clusteredLighting->clusterRegion;
+		char* indexData = lightData + m_clusteredLighting->lightRegion;
+
+		uint32_t lightCount = static_cast<uint32_t>(m_clusteredLighting->lights.size());
+
+		ClusterHeader header =
+		{
+			info.tileCountX,
+			info.tileCountY,
+			info.sliceCount,
+			lightCount,
+			static_cast<float>(extent.width) / info.tileCountX,
+			static_cast<float>(extent.height) / info.tileCountY,
+			m_clusteredLighting->sliceScale,
+			m_clusteredLighting->sliceBias
+		};
+
+		std::memcpy(frame, &header, sizeof(ClusterHeader));
+
+		ClusterRange* clusters = reinterpret_cast<ClusterRange*>(frame + sizeof(ClusterHeader));
+		std::memcpy(clusters, m_clusteredLighting->clusters.data(), GetClusterCount() * sizeof(ClusterRange));
+
+		// The lists past the end of the index region are cut, the clusters keep the lights that fit
+		if (m_clusteredLighting->lightIndexCount > info.maxLightIndices)
+		{
+			std::cout << "The light lists need " << m_clusteredLighting->lightIndexCount << " indices, they are truncated to " << info.maxLightIndices << std::endl;
+
+			for (uint32_t cluster = 0; cluster < GetClusterCount(); cluster++)
+			{
+				uint32_t end = std::min(clusters[cluster].offset + clusters[cluster].count, info.maxLightIndices);
+				clusters[cluster].count = (end > clusters[cluster].offset) ? end - clusters[cluster].offset : 0;
+			}
+
+			m_clusteredLighting->lightIndexCount = info.maxLightIndices;
+		}
+
+		std::memcpy(lightData, m_clusteredLighting->lights.data(), lightCount * sizeof(PointLight));
+
+		uint32_t base = 0;
+
+		for (const SliceChunk& chunk : m_clusteredLighting->chunks)
+		{
+			uint32_t count = std::min(static_cast<uint32_t>(chunk.indices.size()), m_clusteredLighting->lightIndexCount - base);
+
+			if (count > 0)
+				std::memcpy(indexData + base * sizeof(uint32_t), chunk.indices.data(), count * sizeof(uint32_t));
+
+			base += count;
+		}
+
+		VkDeviceSize frameOffset = m_clusteredLighting->frameIndex * m_clusteredLighting->frameSize;
+
+		return m_clusteredLighting->buffer.Flush(frameOffset, sizeof(ClusterHeader) + GetClusterCount() * sizeof(ClusterRange))
+			&& ((lightCount == 0) || m_clusteredLighting->buffer.Flush(frameOffset + m_clusteredLighting->clusterRegion, lightCount * sizeof(PointLight)))
+			&& ((base == 0) || m_clusteredLighting->buffer.Flush(frameOffset + m_clusteredLighting->clusterRegion + m_clusteredLighting->lightRegion, base * sizeof(uint32_t)));
+	}
+
+	//-------------------------------------------------------------------------
+
+	VkDeviceSize ClusteredLighting::AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+	{
+		if (alignment <= 1)
+			return value;
+
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include <iostream>
+
+#include <Neon/Core/SmartDeleter.hpp>
+#include <Neon/Renderer/ShaderModule.hpp>
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/ComputePipeline.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a compute pipeline
+	@param : The device of the application
+	@param : The path of the SPIR-V compute shader
+	@param : The description of the pipeline, only its descriptor set layouts and push constant ranges are used
+	*/
+	ComputePipeline::ComputePipeline(Device& device, const String& filename, const PipelineInfo& info)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_computePipeline = std::make_shared<ComputePipelines>();
+
+		if (!CreatePipelineLayout(info) || !CreatePipeline(filename))
+			std::cout << "Failed to create compute pipeline" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the pipeline
+	@param : A constant reference to the ComputePipeline to copy
+	*/
+	ComputePipeline::ComputePipeline(const ComputePipeline& computePipeline) : m_device(computePipeline.m_device), m_computePipeline(computePipeline.m_computePipeline)
+	{}
+
+	/*
+	@brief : Destroys the pipeline and its layout once its last owner goes away
+	*/
+	ComputePipeline::~ComputePipeline()
+	{
+		if ((m_computePipeline == nullptr) || (m_computePipeline.use_count() > 1))
+			return;
+
+		if (m_computePipeline->pipeline != VK_NULL_HANDLE)
+		{
+			vkDestroyPipeline(m_device->GetDevice()->logicalDevice, m_computePipeline->pipeline, nullptr);
+			m_computePipeline->pipeline = VK_NULL_HANDLE;
+		}
+
+		if (m_computePipeline->pipelineLayout != VK_NULL_HANDLE)
+		{
+			vkDestroyPipelineLayout(m_device->GetDevice()->logicalDevice, m_computePipeline->pipelineLayout, nullptr);
+			m_computePipeline->pipelineLayout = VK_NULL_HANDLE;
+		}
+	}
+
+	/*
+	@brief : Binds the pipeline on the compute bind point
+	@param : The command buffer in recording state
+	*/
+	void ComputePipeline::Bind(VkCommandBuffer commandBuffer) const
+	{
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipeline->pipeline);
+	}
+
+	/*
+	@brief : Dispatches work groups on the bound pipeline
+	@param : The command buffer in recording state
+	@param : The number of work groups along x
+	@param : The number of work groups along y
+	@param : The number of work groups along z
+	*/
+	void ComputePipeline::Dispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) const
+	{
+		vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+	}
+
+	/*
+	@brief : Assigns the pipeline by move semantic
+	@param : The pipeline to move
+	@return : A reference to this
+	*/
+	ComputePipeline& ComputePipeline::operator=(ComputePipeline&& computePipeline) noexcept
+	{
+		std::swap(m_device, computePipeline.m_device);
+		std::swap(m_computePipeline, computePipeline.m_computePipeline);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool ComputePipeline::CreatePipeline(const String& filename)
+	{
+		SmartDeleter<VkShaderModule, PFN_vkDestroyShaderModule> compute = CreateShaderModule(filename, *m_device);
+
+		if (!compute)
+			return false;
+
+		VkComputePipelineCreateInfo computePipelineInfo =
+		{
+			VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+			nullptr,
+			0,
+			{
+				VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+				nullptr,
+				0,
+				VK_SHADER_STAGE_COMPUTE_BIT,
+				compute.GetObj(),
+				"main",
+				nullptr
+			},
+			m_computePipeline->pipelineLayout,
+			VK_NULL_HANDLE,
+			-1
+		};
+
+		if (vkCreateComputePipelines(m_device->GetDevice()->logicalDevice, VK_NULL_HANDLE, 1, &computePipelineInfo, nullptr, &m_computePipeline->pipeline) != VK_SUCCESS)
+		{
+			std::cout << "Failed to create compute pipeline" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool ComputePipeline::CreatePipelineLayout(const PipelineInfo& info)
+	{
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			nullptr,
+			0,
+			static_cast<uint32_t>(info.descriptorSetLayouts.size()),
+			info.descriptorSetLayouts.data(),
+			static_cast<uint32_t>(info.pushConstantRanges.size()),
+			info.pushConstantRanges.data()
+		};
+
+		if (vkCreatePipelineLayout(m_device->GetDevice()->logicalDevice, &pipelineLayoutInfo, nullptr, &m_computePipeline->pipelineLayout) != VK_SUCCESS)
+		{
+			std::cout << "Could not create pipeline layout" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
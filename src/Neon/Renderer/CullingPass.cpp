@@ -0,0 +1,393 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/DescriptorLayoutCache.hpp>
+#include <Neon/Renderer/DescriptorAllocator.hpp>
+#include <Neon/Renderer/GeometryPool.hpp>
+#include <Neon/Renderer/CullingPass.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a GPU culling pass, cull.comp tests the instances (binding 0) against the frustum and appends the visible ones to the commands (binding 2) with an atomicAdd on the count (binding 1)
+	@param : A reference to the Device
+	@param : The cache giving the layout of the descriptor set
+	@param : The allocator giving the descriptor set
+	@param : The indirect buffer receiving the visible draws, drawn with DrawCount
+	@param : The maximum number of instances of a frame
+	@param : The number of frames in flight
+	*/
+	CullingPass::CullingPass(Device& device, DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator, IndirectDrawBuffer& indirectBuffer,
+		uint32_t maxInstances, uint32_t frameCount)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_cullingPass = std::make_shared<CullingPasses>();
+
+		m_cullingPass->indirectBuffer = IndirectDrawBuffer(indirectBuffer);
+		m_cullingPass->maxInstances = std::min(maxInstances, indirectBuffer.GetMaxDraws());
+		m_cullingPass->frameCount = frameCount;
+
+		// The shader writes the first instance of the visible meshes in the commands, the binding cannot follow draws built on the device
+		if (!m_device->GetDevice()->drawIndirectFirstInstance)
+			std::cout << "The culling pass needs drawIndirectFirstInstance, the draws stay built on the CPU" << std::endl;
+		else if (!CreateInstanceBuffer())
+			std::cout << "Failed to create culling instance buffer" << std::endl;
+		else if (!CreateDescriptorSet(layoutCache, descriptorAllocator))
+			std::cout << "Failed to create culling descriptor set" << std::endl;
+		else if (!CreatePipeline())
+			std::cout << "Failed to create culling pipeline" << std::endl;
+		else if (!CreateAsyncResources())
+			std::cout << "Failed to create async compute resources" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the pass
+	@param : A constant reference to the CullingPass to copy
+	*/
+	CullingPass::CullingPass(const CullingPass& cullingPass) : m_device(cullingPass.m_device), m_cullingPass(cullingPass.m_cullingPass)
+	{}
+
+	/*
+	@brief : Destroys the async compute resources once the last owner of the pass goes away
+	*/
+	CullingPass::~CullingPass()
+	{
+		if ((m_cullingPass == nullptr) || (m_cullingPass.use_count() > 1))
+			return;
+
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		for (VkSemaphore& semaphore : m_cullingPass->semaphores)
+		{
+			if (semaphore != VK_NULL_HANDLE)
+			{
+				vkDestroySemaphore(logicalDevice, semaphore, nullptr);
+				semaphore = VK_NULL_HANDLE;
+			}
+		}
+
+		if (m_cullingPass->commandPool != VK_NULL_HANDLE)
+		{
+			vkDestroyCommandPool(logicalDevice, m_cullingPass->commandPool, nullptr);
+			m_cullingPass->commandPool = VK_NULL_HANDLE;
+		}
+	}
+
+	/*
+	@brief : Rewinds the instance list on the region of a frame, the indirect buffer must be on the same frame
+	@param : The index of the frame in flight, its fence must have been waited on
+	*/
+	void CullingPass::BeginFrame(uint32_t frameIndex)
+	{
+		m_cullingPass->frameIndex = frameIndex % m_cullingPass->frameCount;
+		m_cullingPass->instanceCount = 0;
+	}
+
+	/*
+	@brief : Appends an instance of a mesh of the geometry pool to the list tested by the current frame
+	@param : The range of the mesh in the geometry pool
+	@param : The center of the bounding sphere, 3 floats in world space
+	@param : The radius of the bounding sphere
+	@param : The first instance of the draw
+	@return : Returns true if the instance is added, false if the list is full
+	*/
+	bool CullingPass::AddInstance(const MeshRange& mesh, const float* center, float radius, uint32_t firstInstance)
+	{
+		if (m_cullingPass->instanceCount >= m_cullingPass->maxInstances)
+		{
+			std::cout << "Culling pass is full for this frame" << std::endl;
+			return false;
+		}
+
+		CullingInstance* instances = reinterpret_cast<CullingInstance*>(static_cast<char*>(m_cullingPass->instanceBuffer.GetData())
+			+ m_cullingPass->frameIndex * m_cullingPass->frameSize);
+
+		CullingInstance& instance = instances[m_cullingPass->instanceCount];
+
+		std::memcpy(instance.center, center, sizeof(instance.center));
+		instance.radius = radius;
+		instance.indexCount = mesh.indexCount;
+		instance.firstIndex = mesh.firstIndex;
+		instance.vertexOffset = static_cast<int32_t>(mesh.firstVertex);
+		instance.firstInstance = firstInstance;
+
+		m_cullingPass->instanceCount++;
+
+		return true;
+	}
+
+	/*
+	@brief : Makes the instances of the current frame visible to the device
+	@return : Returns true if the flush is a success, false otherwise
+	*/
+	bool CullingPass::Flush()
+	{
+		return m_cullingPass->instanceBuffer.Flush(m_cullingPass->frameIndex * m_cullingPass->frameSize, m_cullingPass->instanceCount * sizeof(CullingInstance));
+	}
+
+	/*
+	@brief : Records the culling in a command buffer of the graphics queue, the render graph orders the indirect draws after its writes to the indirect buffer
+	@param : The command buffer in recording state, outside of a render pass
+	@param : The view projection matrix, 16 floats in column major order
+	*/
+	void CullingPass::Record(VkCommandBuffer commandBuffer, const float* viewProjection) const
+	{
+		RecordCulling(commandBuffer, viewProjection);
+	}
+
+	/*
+	@brief : Submits the culling to the async compute queue, the graphics submission of the frame waits on GetSemaphore at VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT
+	@param : The view projection matrix, 16 floats in column major order
+	@return : Returns true if the submission is a success, false otherwise
+	*/
+	bool CullingPass::Submit(const float* viewProjection)
+	{
+		if (!IsAsync())
+			return false;
+
+		VkCommandBuffer commandBuffer = m_cullingPass->commandBuffers[m_cullingPass->frameIndex];
+
+		VkCommandBufferBeginInfo commandBufferBeginInfo =
+		{
+			VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			nullptr,
+			VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+			nullptr
+		};
+
+		if (vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo) != VK_SUCCESS)
+		{
+			std::cout << "Failed to begin culling command buffer" << std::endl;
+			return false;
+		}
+
+		RecordCulling(commandBuffer, viewProjection);
+
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+		{
+			std::cout << "Failed to end culling command buffer" << std::endl;
+			return false;
+		}
+
+		// The semaphore also makes the writes of the shader visible to the indirect draws
+		VkSubmitInfo submitInfo =
+		{
+			VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			nullptr,
+			0,
+			nullptr,
+			nullptr,
+			1,
+			&commandBuffer,
+			1,
+			&m_cullingPass->semaphores[m_cullingPass->frameIndex]
+		};
+
+		if (vkQueueSubmit(m_device->GetDevice()->computeQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+		{
+			std::cout << "Failed to submit culling command buffer" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	/*
+	@brief : Assigns the culling pass by move semantic
+	@param : The culling pass to move
+	@return : A reference to this
+	*/
+	CullingPass& CullingPass::operator=(CullingPass&& cullingPass) noexcept
+	{
+		std::swap(m_device, cullingPass.m_device);
+		std::swap(m_cullingPass, cullingPass.m_cullingPass);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool CullingPass::CreateInstanceBuffer()
+	{
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		m_cullingPass->frameSize = AlignUp(m_cullingPass->maxInstances * sizeof(CullingInstance), deviceProperties.limits.minStorageBufferOffsetAlignment);
+
+		m_cullingPass->instanceBuffer = Buffer(*m_device, m_cullingPass->frameSize * m_cullingPass->frameCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+		return m_cullingPass->instanceBuffer.IsValid();
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool CullingPass::CreateDescriptorSet(DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator)
+	{
+		std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
+
+		for (uint32_t binding = 0; binding < 3; binding++)
+			layoutBindings.push_back({ binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr });
+
+		m_cullingPass->descriptorSetLayout = layoutCache.GetLayout(layoutBindings);
+
+		if (m_cullingPass->descriptorSetLayout == VK_NULL_HANDLE)
+			return false;
+
+		// The dynamic offsets select the regions of the frame
+		m_cullingPass->descriptorSet = descriptorAllocator.GetImmutableSet(m_cullingPass->descriptorSetLayout,
+			{
+				DescriptorAllocator::BufferWrite(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, m_cullingPass->instanceBuffer.GetBuffer(), 0, m_cullingPass->frameSize),
+				DescriptorAllocator::BufferWrite(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, m_cullingPass->indirectBuffer.GetBuffer(), 0, sizeof(uint32_t)),
+				DescriptorAllocator::BufferWrite(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, m_cullingPass->indirectBuffer.GetBuffer(), 0,
+					m_cullingPass->indirectBuffer.GetCommandRange())
+			});
+
+		return m_cullingPass->descriptorSet != VK_NULL_HANDLE;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool CullingPass::CreatePipeline()
+	{
+		PipelineInfo pipelineInfo;
+		pipelineInfo.descriptorSetLayouts.push_back(m_cullingPass->descriptorSetLayout);
+		pipelineInfo.pushConstantRanges.push_back({ VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullingConstants) });
+
+		m_cullingPass->pipeline = ComputePipeline(*m_device, "C:/Users/Lucas/Documents/Neon/shaders/cull.spv", pipelineInfo);
+
+		return m_cullingPass->pipeline.IsValid();
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool CullingPass::CreateAsyncResources()
+	{
+		if (m_device->GetDevice()->computeIndexFamily == m_device->GetDevice()->graphicsIndexFamily)
+			return true;
+
+		VkCommandPoolCreateInfo commandPoolInfo =
+		{
+			VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			nullptr,
+			VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+			m_device->GetDevice()->computeIndexFamily
+		};
+
+		if (vkCreateCommandPool(m_device->GetDevice()->logicalDevice, &commandPoolInfo, nullptr, &m_cullingPass->commandPool) != VK_SUCCESS)
+			return false;
+
+		m_cullingPass->commandBuffers.resize(m_cullingPass->frameCount, VK_NULL_HANDLE);
+		m_cullingPass->semaphores.resize(m_cullingPass->frameCount, VK_NULL_HANDLE);
+
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo =
+		{
+			VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+			nullptr,
+			m_cullingPass->commandPool,
+			VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+			m_cullingPass->frameCount
+		};
+
+		if (vkAllocateCommandBuffers(m_device->GetDevice()->logicalDevice, &commandBufferAllocateInfo, m_cullingPass->commandBuffers.data()) != VK_SUCCESS)
+			return false;
+
+		VkSemaphoreCreateInfo semaphoreInfo =
+		{
+			VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+			nullptr,
+			0
+		};
+
+		for (VkSemaphore& semaphore : m_cullingPass->semaphores)
+		{
+			if (vkCreateSemaphore(m_device->GetDevice()->logicalDevice, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS)
+				return false;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void CullingPass::RecordCulling(VkCommandBuffer commandBuffer, const float* viewProjection) const
+	{
+		m_cullingPass->indirectBuffer.ResetCount(commandBuffer);
+
+		VkMemoryBarrier memoryBarrier =
+		{
+			VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			nullptr,
+			VK_ACCESS_TRANSFER_WRITE_BIT,
+			VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+		};
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		uint32_t dynamicOffsets[3] =
+		{
+			static_cast<uint32_t>(m_cullingPass->frameIndex * m_cullingPass->frameSize),
+			static_cast<uint32_t>(m_cullingPass->indirectBuffer.GetCountOffset()),
+			static_cast<uint32_t>(m_cullingPass->indirectBuffer.GetCommandOffset())
+		};
+
+		CullingConstants constants;
+		ExtractFrustumPlanes(viewProjection, constants.planes);
+		constants.instanceCount = m_cullingPass->instanceCount;
+
+		const VkPipelineLayout& pipelineLayout = m_cullingPass->pipeline.GetPipelineLayout();
+
+		m_cullingPass->pipeline.Bind(commandBuffer);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &m_cullingPass->descriptorSet, 3, dynamicOffsets);
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullingConstants), &constants);
+
+		// cull.comp runs 64 invocations per work group
+		m_cullingPass->pipeline.Dispatch(commandBuffer, (m_cullingPass->instanceCount + 63) / 64);
+	}
+
+	//-------------------------------------------------------------------------
+
+	void CullingPass::ExtractFrustumPlanes(const float* viewProjection, float* planes)
+	{
+		// Row i of a column major matrix, the clip space depth goes from 0 to w
+		auto row = [viewProjection](uint32_t i, uint32_t j) { return viewProjection[j * 4 + i]; };
+
+		for (uint32_t j = 0; j < 4; j++)
+		{
+			planes[0 + j] = row(3, j) + row(0, j);
+			planes[4 + j] = row(3, j) - row(0, j);
+			planes[8 + j] = row(3, j) + row(1, j);
+			planes[12 + j] = row(3, j) - row(1, j);
+			planes[16 + j] = row(2, j);
+			planes[20 + j] = row(3, j) - row(2, j);
+		}
+
+		// Normalized planes give the signed distance compared to the radius
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			float* plane = planes + i * 4;
+			float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+
+			if (length > 0.0f)
+			{
+				for (uint32_t j = 0; j < 4; j++)
+					plane[j] /= length;
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	VkDeviceSize CullingPass::AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+	{
+		if (alignment <= 1)
+			return value;
+
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+}
\ No newline at end of file
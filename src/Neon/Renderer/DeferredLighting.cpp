@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/SwapChain.hpp>
+#include <Neon/Renderer/RenderPass.hpp>
+#include <Neon/Renderer/ShaderModule.hpp>
+#include <Neon/Renderer/DescriptorLayoutCache.hpp>
+#include <Neon/Renderer/DeferredLighting.hpp>
+
+namespace Zx
+{
+	namespace
+	{
+		const char* VertexShader = "C:/Users/Lucas/Documents/Neon/shaders/fullscreen.spv";
+		const char* FragmentShader = "C:/Users/Lucas/Documents/Neon/shaders/lighting.spv";
+	}
+
+	/*
+	@brief : Creates the lighting subpass of a deferred render pass, lighting.frag reads the albedo, the normal and the depth as input attachments (bindings 0 to 2) and the lights (binding 3)
+	@param : A reference to the Device
+	@param : The deferred render pass, the lighting is invalid if the render pass is forward
+	@param : The swapChain of the application
+	@param : The cache giving the layout of the descriptor set
+	@param : The allocator giving the descriptor set
+	@param : The maximum number of lights of a frame
+	@param : The number of frames in flight
+	*/
+	DeferredLighting::DeferredLighting(Device& device, RenderPass& renderPass, SwapChain& swapChain, DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator,
+		uint32_t maxLights, uint32_t frameCount)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_renderPass = std::make_shared<RenderPass>(renderPass);
+		m_swapChain = std::make_shared<SwapChain>(swapChain);
+		m_lighting = std::make_shared<DeferredLightings>();
+
+		m_lighting->descriptorAllocator = DescriptorAllocator(descriptorAllocator);
+		m_lighting->maxLights = maxLights;
+		m_lighting->frameCount = frameCount;
+
+		if (!m_renderPass->IsDeferred())
+			std::cout << "The render pass is forward, it has no lighting subpass" << std::endl;
+		else if (!CreateLightBuffer())
+			std::cout << "Failed to create light buffer" << std::endl;
+		else if (!CreateDescriptorSetLayout(layoutCache))
+			std::cout << "Failed to create lighting descriptor set layout" << std::endl;
+		else if (!CreatePipeline())
+			std::cout << "Failed to create lighting pipeline" << std::endl;
+		else if (!UpdateInputAttachments())
+			std::cout << "Failed to create lighting descriptor set" << std::endl;
+
+		device = std::move(*m_device);
+		renderPass = std::move(*m_renderPass);
+		swapChain = std::move(*m_swapChain);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the lighting
+	@param : A constant reference to the DeferredLighting to copy
+	*/
+	DeferredLighting::DeferredLighting(const DeferredLighting& deferredLighting) : m_device(deferredLighting.m_device), m_renderPass(deferredLighting.m_renderPass)
+		, m_swapChain(deferredLighting.m_swapChain), m_lighting(deferredLighting.m_lighting)
+	{}
+
+	/*
+	@brief : Rewinds the light list on the region of a frame
+	@param : The index of the frame in flight, its fence must have been waited on
+	*/
+	void DeferredLighting::BeginFrame(uint32_t frameIndex)
+	{
+		m_lighting->frameIndex = frameIndex % std::max(m_lighting->frameCount, 1u);
+		m_lighting->lightCount = 0;
+	}
+
+	/*
+	@brief : Appends a light to the list shaded by the current frame
+	@param : The light, its position in world space
+	@return : Returns true if the light is added, false if the list is full or the lighting is invalid
+	*/
+	bool DeferredLighting::AddLight(const PointLight& light)
+	{
+		if (!IsValid())
+			return false;
+
+		if (m_lighting->lightCount >= m_lighting->maxLights)
+		{
+			std::cout << "Deferred lighting is full for this frame" << std::endl;
+			return false;
+		}
+
+		PointLight* lights = reinterpret_cast<PointLight*>(static_cast<char*>(m_lighting->lightBuffer.GetData()) + m_lighting->frameIndex * m_lighting->frameSize);
+
+		std::memcpy(&lights[m_lighting->lightCount], &light, sizeof(PointLight));
+		m_lighting->lightCount++;
+
+		return true;
+	}
+
+	/*
+	@brief : Makes the lights of the current frame visible to the device
+	@return : Returns true if the flush is a success, false otherwise
+	*/
+	bool DeferredLighting::Flush()
+	{
+		if (!IsValid() || (m_lighting->lightCount == 0))
+			return true;
+
+		return m_lighting->lightBuffer.Flush(m_lighting->frameIndex * m_lighting->frameSize, m_lighting->lightCount * sizeof(PointLight));
+	}
+
+	/*
+	@brief : Points the descriptor set at the G-buffer and the depth of the render pass, to call again once its attachments are recreated
+	@return : Returns true if the set is updated, false otherwise
+	*/
+	bool DeferredLighting::UpdateInputAttachments()
+	{
+		if (!m_renderPass->IsDeferred() || (m_lighting->descriptorSetLayout == VK_NULL_HANDLE))
+			return false;
+
+		// The old views are retired by the render pass, the set reading them is not looked up again
+		for (VkImageView inputView : m_lighting->inputViews)
+			m_lighting->descriptorAllocator.ReleaseImmutableSets(inputView);
+
+		m_lighting->inputViews.clear();
+
+		for (uint32_t i = 0; i < m_renderPass->GetGBufferCount(); i++)
+			m_lighting->inputViews.push_back(m_renderPass->GetGBufferImage(i).GetImageView());
+
+		m_lighting->inputViews.push_back(m_renderPass->GetDepthImage().GetDepthView());
+
+		std::vector<DescriptorWrite> writes;
+
+		for (uint32_t i = 0; i < m_renderPass->GetGBufferCount(); i++)
+			writes.push_back(DescriptorAllocator::ImageWrite(i, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, VK_NULL_HANDLE, m_lighting->inputViews[i], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+
+		writes.push_back(DescriptorAllocator::ImageWrite(m_renderPass->GetGBufferCount(), VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, VK_NULL_HANDLE, m_lighting->inputViews.back(),
+			VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL));
+
+		// The dynamic offset selects the lights of the frame
+		writes.push_back(DescriptorAllocator::BufferWrite(m_renderPass->GetGBufferCount() + 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, m_lighting->lightBuffer.GetBuffer(), 0,
+			m_lighting->frameSize));
+
+		m_lighting->descriptorSet = m_lighting->descriptorAllocator.GetImmutableSet(m_lighting->descriptorSetLayout, writes);
+
+		return m_lighting->descriptorSet != VK_NULL_HANDLE;
+	}
+
+	/*
+	@brief : Shades every pixel once with a full screen triangle, the command buffer must be in the lighting subpass
+	@param : The command buffer in recording state
+	@param : The inverse of the view projection matrix rebuilding the positions from the depth, 16 floats in column major order
+	*/
+	void DeferredLighting::Record(VkCommandBuffer commandBuffer, const float* inverseViewProjection) const
+	{
+		if (!IsValid())
+			return;
+
+		uint32_t dynamicOffset = static_cast<uint32_t>(m_lighting->frameIndex * m_lighting->frameSize);
+
+		LightingConstants constants;
+		std::memcpy(constants.inverseViewProjection, inverseViewProjection, sizeof(constants.inverseViewProjection));
+		constants.lightCount = m_lighting->lightCount;
+
+		const VkPipelineLayout& pipelineLayout = m_lighting->pipeline.GetPipelineLayout();
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_lighting->pipeline.GetPipeline());
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &m_lighting->descriptorSet, 1, &dynamicOffset);
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(LightingConstants), &constants);
+
+		// fullscreen.vert builds the triangle from gl_VertexIndex
+		vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+	}
+
+	/*
+	@brief : Assigns the deferred lighting by move semantic
+	@param : The deferred lighting to move
+	@return : A reference to this
+	*/
+	DeferredLighting& DeferredLighting::operator=(DeferredLighting&& deferredLighting) noexcept
+	{
+		std::swap(m_device, deferredLighting.m_device);
+		std::swap(m_renderPass, deferredLighting.m_renderPass);
+		std::swap(m_swapChain, deferredLighting.m_swapChain);
+		std::swap(m_lighting, deferredLighting.m_lighting);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool DeferredLighting::CreateLightBuffer()
+	{
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		m_lighting->frameSize = AlignUp(std::max(m_lighting->maxLights, 1u) * sizeof(PointLight), deviceProperties.limits.minStorageBufferOffsetAlignment);
+
+		m_lighting->lightBuffer = Buffer(*m_device, m_lighting->frameSize * m_lighting->frameCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+		return m_lighting->lightBuffer.IsValid();
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool DeferredLighting::CreateDescriptorSetLayout(DescriptorLayoutCache& layoutCache)
+	{
+		std::map<uint32_t, std::vector<VkDescriptorSetLayoutBinding>> sets;
+
+		if (!ReflectDescriptorBindings(VertexShader, VK_SHADER_STAGE_VERTEX_BIT, sets) || !ReflectDescriptorBindings(FragmentShader, VK_SHADER_STAGE_FRAGMENT_BIT, sets))
+			return false;
+
+		// The G-buffer, the depth and the lights
+		std::vector<VkDescriptorSetLayoutBinding>& layoutBindings = sets[0];
+
+		if (layoutBindings.size() != m_renderPass->GetGBufferCount() + 2)
+		{
+			std::cout << "The lighting shader does not read every G-buffer attachment" << std::endl;
+			return false;
+		}
+
+		// The SPIR-V cannot tell the lights are selected by a dynamic offset
+		for (VkDescriptorSetLayoutBinding& layoutBinding : layoutBindings)
+		{
+			if (layoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+				layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		}
+
+		m_lighting->descriptorSetLayout = layoutCache.GetLayout(layoutBindings);
+
+		return m_lighting->descriptorSetLayout != VK_NULL_HANDLE;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool DeferredLighting::CreatePipeline()
+	{
+		PipelineInfo pipelineInfo;
+		pipelineInfo.descriptorSetLayouts.push_back(m_lighting->descriptorSetLayout);
+		pipelineInfo.pushConstantRanges.push_back({ VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(LightingConstants) });
+		pipelineInfo.vertexBindings.clear();
+		pipelineInfo.vertexAttributes.clear();
+		pipelineInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		pipelineInfo.vertexShader = VertexShader;
+		pipelineInfo.fragmentShader = FragmentShader;
+		pipelineInfo.lighting = true;
+
+		m_lighting->pipeline = Pipeline(*m_device, *m_renderPass, *m_swapChain, pipelineInfo);
+
+		return m_lighting->pipeline.GetPipeline() != VK_NULL_HANDLE;
+	}
+
+	//-------------------------------------------------------------------------
+
+	VkDeviceSize DeferredLighting::AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+	{
+		if (alignment <= 1)
+			return value;
+
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+}
\ No newline at end of file
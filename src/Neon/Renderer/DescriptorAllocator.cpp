@@ -0,0 +1,394 @@
+#include <iostream>
+
+#include <Neon/Core/Hash.hpp>
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/DescriptorAllocator.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a descriptor allocator with one list of pools per frame in flight
+	@param : A reference to the Device
+	@param : The number of frames in flight
+	@param : The number of sets every pool can hold, the descriptor counts are scaled on it
+	*/
+	DescriptorAllocator::DescriptorAllocator(Device& device, uint32_t frameCount, uint32_t setsPerPool)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_allocator = std::make_shared<DescriptorAllocators>();
+
+		m_allocator->framePools.resize(frameCount);
+		m_allocator->setsPerPool = setsPerPool;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the pools of the allocator
+	@param : A constant reference to the DescriptorAllocator to copy
+	*/
+	DescriptorAllocator::DescriptorAllocator(const DescriptorAllocator& descriptorAllocator) : m_device(descriptorAllocator.m_device), m_allocator(descriptorAllocator.m_allocator)
+	{}
+
+	/*
+	@brief : Destroys every pool, and so every set, once the last owner of the allocator goes away
+	*/
+	DescriptorAllocator::~DescriptorAllocator()
+	{
+		if ((m_allocator == nullptr) || (m_allocator.use_count() > 1))
+			return;
+
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		for (std::vector<VkDescriptorPool>& pools : m_allocator->framePools)
+		{
+			for (VkDescriptorPool pool : pools)
+				vkDestroyDescriptorPool(logicalDevice, pool, nullptr);
+		}
+
+		for (VkDescriptorPool pool : m_allocator->persistentPools)
+			vkDestroyDescriptorPool(logicalDevice, pool, nullptr);
+
+		for (VkDescriptorPool pool : m_allocator->freePools)
+			vkDestroyDescriptorPool(logicalDevice, pool, nullptr);
+
+		m_allocator->framePools.clear();
+		m_allocator->persistentPools.clear();
+		m_allocator->freePools.clear();
+		m_allocator->immutableSets.clear();
+		// The sets are freed with their pools
+		m_allocator->releasedSets.ReleaseAll([](ImmutableSet&) {});
+	}
+
+	/*
+	@brief : Resets at once every pool used by a frame and gives them back to the free list
+	@param : The index of the frame in flight, its fence must have been waited on
+	*/
+	void DescriptorAllocator::BeginFrame(uint32_t frameIndex)
+	{
+		m_allocator->frameIndex = frameIndex % static_cast<uint32_t>(m_allocator->framePools.size());
+
+		std::vector<VkDescriptorPool>& pools = m_allocator->framePools[m_allocator->frameIndex];
+
+		for (VkDescriptorPool pool : pools)
+		{
+			vkResetDescriptorPool(m_device->GetDevice()->logicalDevice, pool, 0);
+			m_allocator->freePools.push_back(pool);
+		}
+
+		pools.clear();
+	}
+
+	/*
+	@brief : Allocates a set which only lives until the same frame index begins again
+	@param : The layout of the set
+	@param : The allocated set
+	@return : Returns true if the allocation is a success, false otherwise
+	*/
+	bool DescriptorAllocator::Allocate(VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet)
+	{
+		return AllocateFromPools(m_allocator->framePools[m_allocator->frameIndex], layout, descriptorSet);
+	}
+
+	/*
+	@brief : Gets a set whose content never changes, it is allocated and written the first time it is asked
+	@param : The layout of the set
+	@param : The resources written in the set
+	@return : Returns the set, VK_NULL_HANDLE if it could not be allocated
+	*/
+	VkDescriptorSet DescriptorAllocator::GetImmutableSet(VkDescriptorSetLayout layout, const std::vector<DescriptorWrite>& writes)
+	{
+		std::size_t hash = HashWrites(layout, writes);
+
+		auto range = m_allocator->immutableSets.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			const ImmutableSet& immutableSet = it->second;
+
+			if ((immutableSet.layout != layout) || (immutableSet.writes.size() != writes.size()))
+				continue;
+
+			bool isSame = true;
+			for (std::size_t i = 0; (i < writes.size()) && isSame; i++)
+				isSame = IsSameWrite(immutableSet.writes[i], writes[i]);
+
+			if (isSame)
+				return immutableSet.descriptorSet;
+		}
+
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		if (!ReuseReleasedSet(layout, descriptorSet) && !AllocateFromPools(m_allocator->persistentPools, layout, descriptorSet))
+			return VK_NULL_HANDLE;
+
+		std::vector<VkWriteDescriptorSet> writeDescriptorSets;
+		writeDescriptorSets.reserve(writes.size());
+
+		for (const DescriptorWrite& write : writes)
+		{
+			bool isImage = IsImageDescriptor(write.type);
+
+			writeDescriptorSets.push_back(
+			{
+				VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+				nullptr,
+				descriptorSet,
+				write.binding,
+				write.arrayElement,
+				1,
+				write.type,
+				isImage ? &write.imageInfo : nullptr,
+				isImage ? nullptr : &write.bufferInfo,
+				nullptr
+			});
+		}
+
+		vkUpdateDescriptorSets(m_device->GetDevice()->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+
+		m_allocator->immutableSets.emplace(hash, ImmutableSet{ layout, writes, descriptorSet });
+
+		return descriptorSet;
+	}
+
+	/*
+	@brief : Removes from the cache every immutable set reading an image view, to call before the view is destroyed
+	@param : The image view
+	*/
+	void DescriptorAllocator::ReleaseImmutableSets(VkImageView imageView)
+	{
+		for (auto it = m_allocator->immutableSets.begin(); it != m_allocator->immutableSets.end();)
+		{
+			bool readsView = false;
+
+			for (const DescriptorWrite& write : it->second.writes)
+				readsView = readsView || (IsImageDescriptor(write.type) && (write.imageInfo.imageView == imageView));
+
+			if (!readsView)
+			{
+				++it;
+				continue;
+			}
+
+			// The frames in flight may still bind the set
+			m_allocator->releasedSets.Push(m_device->GetDevice()->frameCounter, it->second);
+			it = m_allocator->immutableSets.erase(it);
+		}
+	}
+
+	/*
+	@brief : Describes a buffer written in a set
+	@param : The binding of the buffer in the set
+	@param : The type of the descriptor
+	@param : The buffer
+	@param : The offset of the range seen by the shader
+	@param : The size of the range seen by the shader
+	@return : Returns the write
+	*/
+	DescriptorWrite DescriptorAllocator::BufferWrite(uint32_t binding, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+	{
+		DescriptorWrite write;
+		write.binding = binding;
+		write.type = type;
+		write.bufferInfo = { buffer, offset, range };
+
+		return write;
+	}
+
+	/*
+	@brief : Describes an image or a sampler written in a set
+	@param : The binding of the image in the set
+	@param : The type of the descriptor
+	@param : The sampler, VK_NULL_HANDLE for the types without one
+	@param : The image view, VK_NULL_HANDLE for a lone sampler
+	@param : The layout of the image when the shader reads it
+	@return : Returns the write
+	*/
+	DescriptorWrite DescriptorAllocator::ImageWrite(uint32_t binding, VkDescriptorType type, VkSampler sampler, VkImageView imageView, VkImageLayout imageLayout)
+	{
+		DescriptorWrite write;
+		write.binding = binding;
+		write.type = type;
+		write.imageInfo = { sampler, imageView, imageLayout };
+
+		return write;
+	}
+
+	/*
+	@brief : Assigns the allocator by move semantic
+	@param : The allocator to move
+	@return : A reference to this
+	*/
+	DescriptorAllocator& DescriptorAllocator::operator=(DescriptorAllocator&& descriptorAllocator) noexcept
+	{
+		std::swap(m_device, descriptorAllocator.m_device);
+		std::swap(m_allocator, descriptorAllocator.m_allocator);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool DescriptorAllocator::AllocateFromPools(std::vector<VkDescriptorPool>& pools, VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet)
+	{
+		if (pools.empty())
+		{
+			VkDescriptorPool pool = VK_NULL_HANDLE;
+			if (!GrabPool(pool))
+				return false;
+
+			pools.push_back(pool);
+		}
+
+		VkDescriptorSetAllocateInfo setAllocateInfo =
+		{
+			VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			nullptr,
+			pools.back(),
+			1,
+			&layout
+		};
+
+		VkResult result = vkAllocateDescriptorSets(m_device->GetDevice()->logicalDevice, &setAllocateInfo, &descriptorSet);
+
+		// A full pool is left as it is, the list grows with another one
+		if ((result == VK_ERROR_OUT_OF_POOL_MEMORY) || (result == VK_ERROR_FRAGMENTED_POOL))
+		{
+			VkDescriptorPool pool = VK_NULL_HANDLE;
+			if (!GrabPool(pool))
+				return false;
+
+			pools.push_back(pool);
+			setAllocateInfo.descriptorPool = pool;
+
+			result = vkAllocateDescriptorSets(m_device->GetDevice()->logicalDevice, &setAllocateInfo, &descriptorSet);
+		}
+
+		if (result != VK_SUCCESS)
+		{
+			std::cout << "Failed to allocate descriptor set" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool DescriptorAllocator::GrabPool(VkDescriptorPool& pool)
+	{
+		if (!m_allocator->freePools.empty())
+		{
+			pool = m_allocator->freePools.back();
+			m_allocator->freePools.pop_back();
+
+			return true;
+		}
+
+		// Average number of descriptors of each type in a set
+		const std::pair<VkDescriptorType, float> poolRatios[] =
+		{
+			{ VK_DESCRIPTOR_TYPE_SAMPLER, 0.5f },
+			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 4.0f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 0.5f }
+		};
+
+		std::vector<VkDescriptorPoolSize> poolSizes;
+		for (const auto& poolRatio : poolRatios)
+			poolSizes.push_back({ poolRatio.first, static_cast<uint32_t>(poolRatio.second * m_allocator->setsPerPool) + 1 });
+
+		VkDescriptorPoolCreateInfo poolCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			nullptr,
+			0,
+			m_allocator->setsPerPool,
+			static_cast<uint32_t>(poolSizes.size()),
+			poolSizes.data()
+		};
+
+		if (vkCreateDescriptorPool(m_device->GetDevice()->logicalDevice, &poolCreateInfo, nullptr, &pool) != VK_SUCCESS)
+		{
+			std::cout << "Failed to create descriptor pool" << std::endl;
+			return false;
+		}
+
+		m_allocator->poolCount++;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool DescriptorAllocator::ReuseReleasedSet(VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet)
+	{
+		ImmutableSet releasedSet = {};
+
+		bool reused = m_allocator->releasedSets.Take(m_device->GetDevice()->frameCounter, [layout](const ImmutableSet& set)
+		{
+			return set.layout == layout;
+		}, releasedSet);
+
+		if (reused)
+			descriptorSet = releasedSet.descriptorSet;
+
+		return reused;
+	}
+
+	//-------------------------------------------------------------------------
+
+	std::size_t DescriptorAllocator::HashWrites(VkDescriptorSetLayout layout, const std::vector<DescriptorWrite>& writes)
+	{
+		std::size_t seed = 0;
+		HashCombine(seed, layout);
+
+		for (const DescriptorWrite& write : writes)
+		{
+			HashCombine(seed, write.binding);
+			HashCombine(seed, write.arrayElement);
+			HashCombine(seed, static_cast<uint32_t>(write.type));
+
+			if (IsImageDescriptor(write.type))
+			{
+				HashCombine(seed, write.imageInfo.sampler);
+				HashCombine(seed, write.imageInfo.imageView);
+				HashCombine(seed, static_cast<uint32_t>(write.imageInfo.imageLayout));
+			}
+			else
+			{
+				HashCombine(seed, write.bufferInfo.buffer);
+				HashCombine(seed, write.bufferInfo.offset);
+				HashCombine(seed, write.bufferInfo.range);
+			}
+		}
+
+		return seed;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool DescriptorAllocator::IsSameWrite(const DescriptorWrite& a, const DescriptorWrite& b)
+	{
+		if ((a.binding != b.binding) || (a.arrayElement != b.arrayElement) || (a.type != b.type))
+			return false;
+
+		if (IsImageDescriptor(a.type))
+			return (a.imageInfo.sampler == b.imageInfo.sampler) && (a.imageInfo.imageView == b.imageInfo.imageView) && (a.imageInfo.imageLayout == b.imageInfo.imageLayout);
+
+		return (a.bufferInfo.buffer == b.bufferInfo.buffer) && (a.bufferInfo.offset == b.bufferInfo.offset) && (a.bufferInfo.range == b.bufferInfo.range);
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool DescriptorAllocator::IsImageDescriptor(VkDescriptorType type)
+	{
+		return (type == VK_DESCRIPTOR_TYPE_SAMPLER) || (type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) || (type == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE)
+			|| (type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE) || (type == VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT);
+	}
+}
\ No newline at end of file
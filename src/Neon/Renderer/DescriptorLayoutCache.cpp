@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <iostream>
+
+#include <Neon/Core/Hash.hpp>
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/DescriptorLayoutCache.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates an empty cache of descriptor set layouts
+	@param : A reference to the Device
+	*/
+	DescriptorLayoutCache::DescriptorLayoutCache(Device& device)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_layoutCache = std::make_shared<DescriptorLayoutCaches>();
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the layouts of the cache
+	@param : A constant reference to the DescriptorLayoutCache to copy
+	*/
+	DescriptorLayoutCache::DescriptorLayoutCache(const DescriptorLayoutCache& layoutCache) : m_device(layoutCache.m_device), m_layoutCache(layoutCache.m_layoutCache)
+	{}
+
+	/*
+	@brief : Destroys every cached layout once the last owner of the cache goes away
+	*/
+	DescriptorLayoutCache::~DescriptorLayoutCache()
+	{
+		if ((m_layoutCache == nullptr) || (m_layoutCache.use_count() > 1))
+			return;
+
+		for (auto& layout : m_layoutCache->layouts)
+			vkDestroyDescriptorSetLayout(m_device->GetDevice()->logicalDevice, layout.second, nullptr);
+
+		m_layoutCache->layouts.clear();
+	}
+
+	/*
+	@brief : Gets the layout matching some bindings, it is only created the first time it is asked
+	@param : The bindings of the layout, declared or reflected from the shaders, in any order
+	@param : The creation flags of the layout
+	@param : The descriptor indexing flags of each binding, in the order of the bindings, empty if there is none
+	@return : Returns the layout, VK_NULL_HANDLE if it could not be created
+	*/
+	VkDescriptorSetLayout DescriptorLayoutCache::GetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags,
+		const std::vector<VkDescriptorBindingFlagsEXT>& bindingFlags)
+	{
+		if (!bindingFlags.empty() && (bindingFlags.size() != bindings.size()))
+		{
+			std::cout << "Descriptor binding flags do not match the bindings of the layout" << std::endl;
+			return VK_NULL_HANDLE;
+		}
+
+		LayoutKey key = CreateKey(bindings, flags, bindingFlags);
+
+		auto it = m_layoutCache->layouts.find(key);
+		if (it != m_layoutCache->layouts.end())
+			return it->second;
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT,
+			nullptr,
+			static_cast<uint32_t>(bindingFlags.size()),
+			bindingFlags.data()
+		};
+
+		VkDescriptorSetLayoutCreateInfo layoutCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			bindingFlags.empty() ? nullptr : &bindingFlagsCreateInfo,
+			flags,
+			static_cast<uint32_t>(bindings.size()),
+			bindings.data()
+		};
+
+		VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+		if (vkCreateDescriptorSetLayout(m_device->GetDevice()->logicalDevice, &layoutCreateInfo, nullptr, &layout) != VK_SUCCESS)
+		{
+			std::cout << "Failed to create descriptor set layout" << std::endl;
+			return VK_NULL_HANDLE;
+		}
+
+		m_layoutCache->layouts.emplace(std::move(key), layout);
+
+		return layout;
+	}
+
+	/*
+	@brief : Assigns the cache by move semantic
+	@param : The cache to move
+	@return : A reference to this
+	*/
+	DescriptorLayoutCache& DescriptorLayoutCache::operator=(DescriptorLayoutCache&& layoutCache) noexcept
+	{
+		std::swap(m_device, layoutCache.m_device);
+		std::swap(m_layoutCache, layoutCache.m_layoutCache);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	DescriptorLayoutCache::LayoutKey DescriptorLayoutCache::CreateKey(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags,
+		const std::vector<VkDescriptorBindingFlagsEXT>& bindingFlags)
+	{
+		// Two declarations of the same layout must give the same key whatever the order of their bindings
+		std::vector<std::size_t> order(bindings.size());
+		for (std::size_t i = 0; i < order.size(); i++)
+			order[i] = i;
+
+		std::sort(order.begin(), order.end(), [&bindings](std::size_t a, std::size_t b)
+		{
+			return bindings[a].binding < bindings[b].binding;
+		});
+
+		LayoutKey key;
+		key.flags = flags;
+
+		for (std::size_t i : order)
+		{
+			VkDescriptorSetLayoutBinding binding = bindings[i];
+
+			// The key does not keep the pointers of the caller, the immutable samplers are copied instead
+			if (binding.pImmutableSamplers != nullptr)
+			{
+				key.immutableBindings.push_back(binding.binding);
+				key.immutableSamplers.insert(key.immutableSamplers.end(), binding.pImmutableSamplers, binding.pImmutableSamplers + binding.descriptorCount);
+				binding.pImmutableSamplers = nullptr;
+			}
+
+			key.bindings.push_back(binding);
+
+			if (!bindingFlags.empty())
+				key.bindingFlags.push_back(bindingFlags[i]);
+		}
+
+		return key;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool DescriptorLayoutCache::LayoutKey::operator==(const LayoutKey& key) const
+	{
+		if ((flags != key.flags) || (bindings.size() != key.bindings.size()) || (bindingFlags != key.bindingFlags) || (immutableBindings != key.immutableBindings)
+			|| (immutableSamplers != key.immutableSamplers))
+			return false;
+
+		for (std::size_t i = 0; i < bindings.size(); i++)
+		{
+			const VkDescriptorSetLayoutBinding& a = bindings[i];
+			const VkDescriptorSetLayoutBinding& b = key.bindings[i];
+
+			if ((a.binding != b.binding) || (a.descriptorType != b.descriptorType) || (a.descriptorCount != b.descriptorCount) || (a.stageFlags != b.stageFlags))
+				return false;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	std::size_t DescriptorLayoutCache::LayoutKeyHash::operator()(const LayoutKey& key) const
+	{
+		std::size_t seed = 0;
+		HashCombine(seed, key.flags);
+
+		for (const VkDescriptorSetLayoutBinding& binding : key.bindings)
+		{
+			HashCombine(seed, binding.binding);
+			HashCombine(seed, static_cast<uint32_t>(binding.descriptorType));
+			HashCombine(seed, binding.descriptorCount);
+			HashCombine(seed, binding.stageFlags);
+		}
+
+		for (VkDescriptorBindingFlagsEXT bindingFlags : key.bindingFlags)
+			HashCombine(seed, bindingFlags);
+
+		for (const VkSampler& sampler : key.immutableSamplers)
+			HashCombine(seed, sampler);
+
+		return seed;
+	}
+}
\ No newline at end of file
@@ -46,10 +46,13 @@ namespace Zx
 	}
 
 	/*
-	@brief : Destroys the device
+	@brief : Destroys the device with the last owner of its state, the buffers and images keep their own copy of the Device
 	*/
 	Device::~Device()
 	{
+		if ((m_device == nullptr) || (m_device.use_count() > 1))
+			return;
+
 		vkDestroyDevice(m_device->logicalDevice, nullptr);
 		m_device->logicalDevice = VK_NULL_HANDLE;
 	}
@@ -70,6 +73,14 @@ namespace Zx
 
 		return true;
 	}
+
+	/*
+	@brief : Begins a new frame for every retire queue of the device, to call once per frame once its fence is waited
+	*/
+	void Device::BeginFrame()
+	{
+		m_device->frameCounter.Advance();
+	}
 	
 
 	/*
@@ -93,6 +104,7 @@ namespace Zx
 	{
 		vkGetDeviceQueue(m_device->logicalDevice, m_device->graphicsIndexFamily, 0, &m_device->graphicsQueue);
 		vkGetDeviceQueue(m_device->logicalDevice, m_device->presentIndexFamily, 0, &m_device->presentQueue);
+		vkGetDeviceQueue(m_device->logicalDevice, m_device->computeIndexFamily, 0, &m_device->computeQueue);
 	}
 
 	//--------------------------------------------------------------------------
@@ -208,11 +220,38 @@ namespace Zx
 
 	//--------------------------------------------------------------------------
 
+	void Device::FindComputeFamily()
+	{
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(m_device->physicalDevice, &queueFamilyCount, nullptr);
+
+		std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(m_device->physicalDevice, &queueFamilyCount, queueFamilyProperties.data());
+
+		// A family without graphics runs the compute work asynchronously, beside the graphics queue
+		for (uint32_t i = 0; i < queueFamilyCount; ++i)
+		{
+			if ((queueFamilyProperties[i].queueCount > 0) && (queueFamilyProperties[i].queueFlags & VK_QUEUE_COMPUTE_BIT)
+				&& !(queueFamilyProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+			{
+				m_device->computeIndexFamily = i;
+				return;
+			}
+		}
+
+		// The graphics family always supports compute
+		m_device->computeIndexFamily = m_device->graphicsIndexFamily;
+	}
+
+	//--------------------------------------------------------------------------
+
 	bool Device::CreateLogicalDevice()
 	{	
 		std::vector<VkDeviceQueueCreateInfo> deviceQueueInfo;
 		std::vector<float> queuePriorities = { 1.0f };
 
+		FindComputeFamily();
+
 		deviceQueueInfo.push_back(
 		{
 			VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
@@ -236,15 +275,92 @@ namespace Zx
 			});
 		}
 
+		if ((m_device->computeIndexFamily != m_device->graphicsIndexFamily) && (m_device->computeIndexFamily != m_device->presentIndexFamily))
+		{
+			deviceQueueInfo.push_back(
+			{
+				VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+				nullptr,
+				0,
+				m_device->computeIndexFamily,
+				static_cast<uint32_t>(queuePriorities.size()),
+				queuePriorities.data()
+			});
+		}
+
 		std::vector<const char*> extensions =
 		{
 			VK_KHR_SWAPCHAIN_EXTENSION_NAME
 		};
 
+		// Bindless resources are optional, they are only enabled when every needed feature is there
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures = {};
+		m_device->descriptorIndexing = QueryDescriptorIndexing(descriptorIndexingFeatures);
+
+		if (m_device->descriptorIndexing)
+		{
+			if (IsExtensionSupported(VK_KHR_MAINTENANCE3_EXTENSION_NAME))
+				extensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+
+			extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+		}
+
+		// Indirect draws read their commands from buffers, several of them per call when multiDrawIndirect is there
+		VkPhysicalDeviceFeatures supportedFeatures;
+		vkGetPhysicalDeviceFeatures(m_device->physicalDevice, &supportedFeatures);
+
+		VkPhysicalDeviceFeatures enabledFeatures = {};
+		enabledFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+		enabledFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+		enabledFeatures.samplerAnisotropy = supportedFeatures.samplerAnisotropy;
+		enabledFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+		enabledFeatures.textureCompressionETC2 = supportedFeatures.textureCompressionETC2;
+		enabledFeatures.textureCompressionASTC_LDR = supportedFeatures.textureCompressionASTC_LDR;
+
+		m_device->multiDrawIndirect = (supportedFeatures.multiDrawIndirect == VK_TRUE);
+		m_device->drawIndirectFirstInstance = (supportedFeatures.drawIndirectFirstInstance == VK_TRUE);
+		m_device->samplerAnisotropy = (supportedFeatures.samplerAnisotropy == VK_TRUE);
+		m_device->textureCompressionBC = (supportedFeatures.textureCompressionBC == VK_TRUE);
+		m_device->textureCompressionETC2 = (supportedFeatures.textureCompressionETC2 == VK_TRUE);
+		m_device->textureCompressionASTC = (supportedFeatures.textureCompressionASTC_LDR == VK_TRUE);
+
+		bool drawIndirectCount = IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+		if (drawIndirectCount)
+			extensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+		// The budget of the heaps bounds the streamed resources, without it the allocators only know their own usage
+		m_device->memoryBudget = IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+		if (m_device->memoryBudget)
+			extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+		// The ids of the presents let the frame pacer wait for an image to be displayed before starting the next frame
+		VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+		VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+		m_device->presentWait = QueryPresentWait(presentIdFeatures, presentWaitFeatures);
+
+		void* features = nullptr;
+
+		if (m_device->presentWait)
+		{
+			extensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+			extensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+			presentIdFeatures.pNext = &presentWaitFeatures;
+			features = &presentIdFeatures;
+		}
+
+		if (m_device->descriptorIndexing)
+		{
+			descriptorIndexingFeatures.pNext = features;
+			features = &descriptorIndexingFeatures;
+		}
+
 		VkDeviceCreateInfo deviceInfo =
 		{
 			VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-			nullptr,
+			features,
 			0,
 			static_cast<uint32_t>(deviceQueueInfo.size()),
 			deviceQueueInfo.data(),
@@ -252,12 +368,24 @@ namespace Zx
 			nullptr,
 			static_cast<uint32_t>(extensions.size()),
 			extensions.data(),
-			nullptr
+			&enabledFeatures
 		};
 
 		if (vkCreateDevice(m_device->physicalDevice, &deviceInfo, nullptr, &m_device->logicalDevice) != VK_SUCCESS)
 			return false;
 
+		if (drawIndirectCount)
+		{
+			m_device->drawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(vkGetDeviceProcAddr(m_device->logicalDevice,
+				"vkCmdDrawIndexedIndirectCountKHR"));
+		}
+
+		if (m_device->presentWait)
+		{
+			m_device->waitForPresent = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(m_device->logicalDevice, "vkWaitForPresentKHR"));
+			m_device->presentWait = (m_device->waitForPresent != nullptr);
+		}
+
 		return true;
 	}
 
@@ -289,4 +417,95 @@ namespace Zx
 	}
 
 	//-------------------------------------------------------------------------
+
+	bool Device::IsExtensionSupported(const char* extensionName) const
+	{
+		uint32_t extensionsCount = 0;
+		if (vkEnumerateDeviceExtensionProperties(m_device->physicalDevice, nullptr, &extensionsCount, nullptr) != VK_SUCCESS)
+			return false;
+
+		std::vector<VkExtensionProperties> extensionsAvailable(extensionsCount);
+		if (vkEnumerateDeviceExtensionProperties(m_device->physicalDevice, nullptr, &extensionsCount, extensionsAvailable.data()) != VK_SUCCESS)
+			return false;
+
+		for (const auto& extension : extensionsAvailable)
+		{
+			if (std::strcmp(extension.extensionName, extensionName) == 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool Device::QueryDescriptorIndexing(VkPhysicalDeviceDescriptorIndexingFeaturesEXT& enabledFeatures) const
+	{
+		if (!IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+			return false;
+
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT supportedFeatures = {};
+		supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+		VkPhysicalDeviceFeatures2 features =
+		{
+			VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+			&supportedFeatures
+		};
+
+		vkGetPhysicalDeviceFeatures2(m_device->physicalDevice, &features);
+
+		if (!supportedFeatures.shaderSampledImageArrayNonUniformIndexing || !supportedFeatures.shaderStorageBufferArrayNonUniformIndexing
+			|| !supportedFeatures.descriptorBindingSampledImageUpdateAfterBind || !supportedFeatures.descriptorBindingStorageBufferUpdateAfterBind
+			|| !supportedFeatures.descriptorBindingUpdateUnusedWhilePending || !supportedFeatures.descriptorBindingPartiallyBound
+			|| !supportedFeatures.runtimeDescriptorArray)
+			return false;
+
+		// Only the features used by the bindless table are enabled
+		enabledFeatures = {};
+		enabledFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+		enabledFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+		enabledFeatures.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+		enabledFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		enabledFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+		enabledFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		enabledFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+		enabledFeatures.runtimeDescriptorArray = VK_TRUE;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool Device::QueryPresentWait(VkPhysicalDevicePresentIdFeaturesKHR& presentIdFeatures, VkPhysicalDevicePresentWaitFeaturesKHR& presentWaitFeatures) const
+	{
+		if (!IsExtensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME) || !IsExtensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+			return false;
+
+		presentWaitFeatures = {};
+		presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+		presentIdFeatures = {};
+		presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+		presentIdFeatures.pNext = &presentWaitFeatures;
+
+		VkPhysicalDeviceFeatures2 features =
+		{
+			VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+			&presentIdFeatures
+		};
+
+		vkGetPhysicalDeviceFeatures2(m_device->physicalDevice, &features);
+
+		if (!presentIdFeatures.presentId || !presentWaitFeatures.presentWait)
+			return false;
+
+		// The structures are chained again by CreateLogicalDevice
+		presentIdFeatures.pNext = nullptr;
+		presentWaitFeatures.pNext = nullptr;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
 }
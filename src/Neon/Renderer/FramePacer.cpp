@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/SwapChain.hpp>
+#include <Neon/Renderer/FramePacer.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a frame pacer, the GPU time of the frames is measured when the graphics queue supports timestamps
+	@param : A reference to the Device
+	@param : The swapChain of the application
+	@param : The frame rate cap and the scheduling of the frames
+	@param : The number of frames in flight
+	*/
+	FramePacer::FramePacer(Device& device, SwapChain& swapChain, const FramePacerInfo& info, uint32_t frameCount)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_swapChain = std::make_shared<SwapChain>(swapChain);
+		m_framePacer = std::make_shared<FramePacers>();
+
+		m_framePacer->info = info;
+		m_framePacer->frameCount = std::max(frameCount, 1u);
+		m_framePacer->written.resize(m_framePacer->frameCount, false);
+		m_framePacer->presentWait = m_device->GetDevice()->presentWait;
+		m_framePacer->frameStart = Clock::now();
+		m_framePacer->capTime = m_framePacer->frameStart;
+		m_framePacer->gpuBusyUntil = m_framePacer->frameStart;
+
+		// Without timestamps the frames are scheduled from the CPU time and the presents only
+		if (!CreateQueryPool())
+			std::cout << "Failed to create frame pacer query pool" << std::endl;
+
+		device = std::move(*m_device);
+		swapChain = std::move(*m_swapChain);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the pacer
+	@param : A constant reference to the FramePacer to copy
+	*/
+	FramePacer::FramePacer(const FramePacer& framePacer) : m_device(framePacer.m_device), m_swapChain(framePacer.m_swapChain), m_framePacer(framePacer.m_framePacer)
+	{}
+
+	/*
+	@brief : Destroys the query pool with the last owner of the pacer
+	*/
+	FramePacer::~FramePacer()
+	{
+		if ((m_framePacer == nullptr) || (m_framePacer.use_count() > 1))
+			return;
+
+		if (m_framePacer->queryPool != VK_NULL_HANDLE)
+		{
+			vkDestroyQueryPool(m_device->GetDevice()->logicalDevice, m_framePacer->queryPool, nullptr);
+			m_framePacer->queryPool = VK_NULL_HANDLE;
+		}
+	}
+
+	/*
+	@brief : Blocks until the next frame should start, to call before the input of the frame is read
+	*/
+	void FramePacer::Wait()
+	{
+		const FramePacerInfo& info = m_framePacer->info;
+
+		// The previous images are on the screen once this returns, the frame then starts from the refresh they were shown at
+		bool presented = info.justInTime && WaitForPresent();
+
+		Clock::time_point now = Clock::now();
+		Clock::time_point target = now;
+
+		// The cap spaces the frames from their scheduled start, the oversleeping of a frame is not carried over to the next ones
+		if (info.maxFrameRate > 0.0)
+		{
+			Clock::duration interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / info.maxFrameRate));
+
+			m_framePacer->capTime = (now - m_framePacer->capTime > interval) ? now : m_framePacer->capTime + interval;
+			target = m_framePacer->capTime;
+		}
+
+		if (info.justInTime)
+		{
+			Clock::time_point deadline;
+
+			if (presented && (m_framePacer->displayInterval > 0.0))
+			{
+				// The frame is shown at the refresh following the images still queued
+				double refreshes = static_cast<double>(m_framePacer->presentId + 1 - m_framePacer->presentedId);
+				deadline = m_framePacer->presentTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(refreshes * m_framePacer->displayInterval));
+				deadline -= std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_framePacer->gpuTime));
+			}
+			else
+			{
+				// The submission of the frame should reach the GPU as it is done with the previous ones, the queue never holds more than the frames in flight
+				Clock::duration queued = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_framePacer->frameCount * m_framePacer->gpuTime));
+				deadline = std::min(m_framePacer->gpuBusyUntil, now + queued);
+			}
+
+			deadline -= std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_framePacer->cpuTime + info.safetyMargin));
+			target = std::max(target, deadline);
+		}
+
+		SleepUntil(target);
+
+		m_framePacer->frameStart = Clock::now();
+	}
+
+	/*
+	@brief : Reads the GPU time of the previous frame run with the resources of this one
+	@param : The index of the frame in flight, its fence must have been waited on
+	*/
+	void FramePacer::BeginFrame(uint32_t frameIndex)
+	{
+		m_framePacer->frameIndex = frameIndex % m_framePacer->frameCount;
+
+		if ((m_framePacer->queryPool == VK_NULL_HANDLE) || !m_framePacer->written[m_framePacer->frameIndex])
+			return;
+
+		m_framePacer->written[m_framePacer->frameIndex] = false;
+
+		uint64_t timestamps[2] = {};
+
+		if (vkGetQueryPoolResults(m_device->GetDevice()->logicalDevice, m_framePacer->queryPool, m_framePacer->frameIndex * 2, 2, sizeof(timestamps), timestamps,
+			sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+			return;
+
+		uint64_t ticks = (timestamps[1] - timestamps[0]) & m_framePacer->timestampMask;
+
+		m_framePacer->gpuTime = Track(m_framePacer->gpuTime, static_cast<double>(ticks) * m_framePacer->timestampPeriod * 1e-9);
+	}
+
+	/*
+	@brief : Measures the CPU time of the frame, to call once its commands are submitted
+	*/
+	void FramePacer::EndFrame()
+	{
+		Clock::time_point now = Clock::now();
+
+		m_framePacer->cpuTime = Track(m_framePacer->cpuTime, std::chrono::duration<double>(now - m_framePacer->frameStart).count());
+
+		// The GPU starts the frame once it is done with the previous ones
+		Clock::duration gpuTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_framePacer->gpuTime));
+		m_framePacer->gpuBusyUntil = std::max(m_framePacer->gpuBusyUntil, now) + gpuTime;
+	}
+
+	/*
+	@brief : Writes the timestamp starting the frame, the command buffer must be outside of a render pass
+	@param : The command buffer in recording state
+	*/
+	void FramePacer::WriteBeginTimestamp(VkCommandBuffer commandBuffer)
+	{
+		if (m_framePacer->queryPool == VK_NULL_HANDLE)
+			return;
+
+		vkCmdResetQueryPool(commandBuffer, m_framePacer->queryPool, m_framePacer->frameIndex * 2, 2);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_framePacer->queryPool, m_framePacer->frameIndex * 2);
+	}
+
+	/*
+	@brief : Writes the timestamp ending the frame, once every command of the frame is recorded
+	@param : The command buffer in recording state
+	*/
+	void FramePacer::WriteEndTimestamp(VkCommandBuffer commandBuffer)
+	{
+		if (m_framePacer->queryPool == VK_NULL_HANDLE)
+			return;
+
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_framePacer->queryPool, m_framePacer->frameIndex * 2 + 1);
+		m_framePacer->written[m_framePacer->frameIndex] = true;
+	}
+
+	/*
+	@brief : Gives an id to the coming present, Wait then knows when its image reaches the screen
+	@return : Returns the VkPresentIdKHR to chain to VkPresentInfoKHR, nullptr without VK_KHR_present_wait
+	*/
+	const void* FramePacer::NextPresentId()
+	{
+		if (!m_framePacer->presentWait)
+			return nullptr;
+
+		// The ids only have to increase, they keep counting when the swap chain is recreated
+		m_framePacer->presentId++;
+		m_framePacer->presentSwapChain = m_swapChain->GetSwapChain()->swapChain;
+
+		m_framePacer->presentInfo =
+		{
+			VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+			nullptr,
+			1,
+			&m_framePacer->presentId
+		};
+
+		return &m_framePacer->presentInfo;
+	}
+
+	/*
+	@brief : Assigns the frame pacer by move semantic
+	@param : The frame pacer to move
+	@return : A reference to this
+	*/
+	FramePacer& FramePacer::operator=(FramePacer&& framePacer) noexcept
+	{
+		std::swap(m_device, framePacer.m_device);
+		std::swap(m_swapChain, framePacer.m_swapChain);
+		std::swap(m_framePacer, framePacer.m_framePacer);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool FramePacer::CreateQueryPool()
+	{
+		const VkPhysicalDevice& physicalDevice = m_device->GetDevice()->physicalDevice;
+
+		uint32_t familyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+
+		std::vector<VkQueueFamilyProperties> families(familyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+		uint32_t graphicsFamily = m_device->GetDevice()->graphicsIndexFamily;
+
+		if ((graphicsFamily >= familyCount) || (families[graphicsFamily].timestampValidBits == 0))
+			return false;
+
+		uint32_t validBits = families[graphicsFamily].timestampValidBits;
+		m_framePacer->timestampMask = (validBits >= 64) ? UINT64_MAX : ((1ull << validBits) - 1);
+
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+
+		m_framePacer->timestampPeriod = static_cast<double>(deviceProperties.limits.timestampPeriod);
+
+		VkQueryPoolCreateInfo queryPoolInfo =
+		{
+			VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+			nullptr,
+			0,
+			VK_QUERY_TYPE_TIMESTAMP,
+			m_framePacer->frameCount * 2,
+			0
+		};
+
+		return vkCreateQueryPool(m_device->GetDevice()->logicalDevice, &queryPoolInfo, nullptr, &m_framePacer->queryPool) == VK_SUCCESS;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool FramePacer::WaitForPresent()
+	{
+		// A present of a retired swap chain is never waited on, its images may never be shown
+		if (!m_framePacer->presentWait || (m_framePacer->presentSwapChain != m_swapChain->GetSwapChain()->swapChain))
+			return false;
+
+		// One frame is queued behind the one on the screen when the CPU and the GPU cannot both fit in a refresh
+		double frameTime = m_framePacer->cpuTime + m_framePacer->gpuTime + m_framePacer->info.safetyMargin;
+		uint64_t latency = (frameTime > m_framePacer->displayInterval) ? 2 : 1;
+
+		if (m_framePacer->presentId < latency)
+			return m_framePacer->presentedId != 0;
+
+		uint64_t waitId = m_framePacer->presentId + 1 - latency;
+
+		if (waitId <= m_framePacer->presentedId)
+			return true;
+
+		Clock::time_point before = Clock::now();
+
+		if (m_device->GetDevice()->waitForPresent(m_device->GetDevice()->logicalDevice, m_framePacer->presentSwapChain, waitId, 100000000) != VK_SUCCESS)
+			return m_framePacer->presentedId != 0;
+
+		Clock::time_point after = Clock::now();
+
+		// A present already on the screen returns at once, the time it was shown at is unknown
+		if (after - before < std::chrono::microseconds(100))
+			return m_framePacer->presentedId != 0;
+
+		if (m_framePacer->presentedId != 0)
+		{
+			double interval = std::chrono::duration<double>(after - m_framePacer->presentTime).count() / static_cast<double>(waitId - m_framePacer->presentedId);
+
+			// A gap in the presents, a minimized window for instance, is not a refresh
+			if (interval < 0.1)
+				m_framePacer->displayInterval = (m_framePacer->displayInterval == 0.0) ? interval : m_framePacer->displayInterval + (interval - m_framePacer->displayInterval) * 0.05;
+		}
+
+		m_framePacer->presentTime = after;
+		m_framePacer->presentedId = waitId;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void FramePacer::SleepUntil(Clock::time_point target) const
+	{
+		Clock::duration spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_framePacer->info.spinTime));
+
+		for (Clock::time_point now = Clock::now(); now < target; now = Clock::now())
+		{
+			if (target - now > spin)
+				std::this_thread::sleep_for(target - now - spin);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	double FramePacer::Track(double average, double sample)
+	{
+		if (sample > average)
+			return sample;
+
+		return average + (sample - average) * 0.05;
+	}
+}
\ No newline at end of file
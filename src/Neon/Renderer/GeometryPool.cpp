@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/GeometryPool.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a shared vertex buffer and a shared index buffer, the meshes are sub-allocated in them
+	@param : A reference to the Device
+	@param : The number of vertices of the pool
+	@param : The number of indices of the pool
+	@param : The size of one vertex in bytes
+	@param : The type of the indices, VK_INDEX_TYPE_UINT16 limits the meshes to 65536 vertices
+	*/
+	GeometryPool::GeometryPool(Device& device, uint32_t vertexCapacity, uint32_t indexCapacity, uint32_t stride, VkIndexType indexType)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_geometryPool = std::make_shared<GeometryPools>();
+
+		m_geometryPool->stride = stride;
+		m_geometryPool->indexType = indexType;
+
+		VkDeviceSize indexSize = (indexType == VK_INDEX_TYPE_UINT16) ? sizeof(uint16_t) : sizeof(uint32_t);
+
+		m_geometryPool->vertexBuffer = Buffer(*m_device, static_cast<VkDeviceSize>(vertexCapacity) * stride, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		m_geometryPool->indexBuffer = Buffer(*m_device, static_cast<VkDeviceSize>(indexCapacity) * indexSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		if (!IsValid())
+			std::cout << "Failed to create geometry pool" << std::endl;
+		else
+		{
+			m_geometryPool->vertexRanges = RangeAllocator(vertexCapacity);
+			m_geometryPool->indexRanges = RangeAllocator(indexCapacity);
+		}
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the pool
+	@param : A constant reference to the GeometryPool to copy
+	*/
+	GeometryPool::GeometryPool(const GeometryPool& geometryPool) : m_device(geometryPool.m_device), m_geometryPool(geometryPool.m_geometryPool)
+	{}
+
+	/*
+	@brief : Destroys a geometry pool, the buffers are freed with the last owner of the pool
+	*/
+	GeometryPool::~GeometryPool()
+	{}
+
+	/*
+	@brief : Starts a new frame, the ranges of the meshes removed by the frames which are over are reused, to call once the Device began the frame
+	*/
+	void GeometryPool::BeginFrame()
+	{
+		m_geometryPool->retiredMeshes.Release(m_device->GetDevice()->frameCounter, [this](const MeshRange& mesh)
+		{
+			FreeMesh(mesh);
+		});
+	}
+
+	/*
+	@brief : Sub-allocates a mesh in the pool and uploads its geometry
+	@param : The vertices of the mesh
+	@param : The number of vertices of the mesh
+	@param : The indices of the mesh, relative to its first vertex
+	@param : The range of the mesh in the pool, to give to Draw
+	@return : Returns true if the mesh is added, false if the pool is full or the upload failed
+	*/
+	bool GeometryPool::AddMesh(const void* vertices, uint32_t vertexCount, const std::vector<uint32_t>& indices, MeshRange& mesh)
+	{
+		if ((vertexCount == 0) || indices.empty())
+			return false;
+
+		if ((m_geometryPool->indexType == VK_INDEX_TYPE_UINT16) && (vertexCount > UINT16_MAX + 1))
+		{
+			std::cout << "Mesh of " << vertexCount << " vertices does not fit 16 bits indices" << std::endl;
+			return false;
+		}
+
+		uint64_t firstVertex = 0;
+		uint64_t firstIndex = 0;
+
+		if (!m_geometryPool->vertexRanges.Allocate(vertexCount, 1, firstVertex))
+		{
+			std::cout << "Geometry pool is out of vertices" << std::endl;
+			return false;
+		}
+
+		if (!m_geometryPool->indexRanges.Allocate(indices.size(), 1, firstIndex))
+		{
+			m_geometryPool->vertexRanges.Free(firstVertex, vertexCount);
+			std::cout << "Geometry pool is out of indices" << std::endl;
+			return false;
+		}
+
+		mesh.firstVertex = static_cast<uint32_t>(firstVertex);
+		mesh.vertexCount = vertexCount;
+		mesh.firstIndex = static_cast<uint32_t>(firstIndex);
+		mesh.indexCount = static_cast<uint32_t>(indices.size());
+
+		VkDeviceSize stride = m_geometryPool->stride;
+
+		if (!m_geometryPool->vertexBuffer.Upload(vertices, vertexCount * stride, mesh.firstVertex * stride) || !UploadIndices(indices, mesh.firstIndex))
+		{
+			FreeMesh(mesh);
+			return false;
+		}
+
+		return true;
+	}
+
+	/*
+	@brief : Sub-allocates a mesh in the pool and uploads its geometry
+	@param : The vertices of the mesh
+	@param : The indices of the mesh, relative to its first vertex
+	@param : The range of the mesh in the pool, to give to Draw
+	@return : Returns true if the mesh is added, false if the pool is full or the upload failed
+	*/
+	bool GeometryPool::AddMesh(const std::vector<VertexData>& vertices, const std::vector<uint32_t>& indices, MeshRange& mesh)
+	{
+		if (m_geometryPool->stride != sizeof(VertexData))
+			return false;
+
+		return AddMesh(vertices.data(), static_cast<uint32_t>(vertices.size()), indices, mesh);
+	}
+
+	/*
+	@brief : Sub-allocates the indices of a level of detail of a mesh, it draws the vertices of the mesh
+	@param : The range of the mesh given by AddMesh
+	@param : The indices of the level of detail, relative to the first vertex of the mesh
+	@param : The range of the level of detail, to give to Draw, it owns no vertices so removing it only frees its indices
+	@return : Returns true if the level of detail is added, false if the pool is full or the upload failed
+	*/
+	bool GeometryPool::AddLod(const MeshRange& mesh, const std::vector<uint32_t>& indices, MeshRange& lod)
+	{
+		if (indices.empty())
+			return false;
+
+		uint64_t firstIndex = 0;
+
+		if (!m_geometryPool->indexRanges.Allocate(indices.size(), 1, firstIndex))
+		{
+			std::cout << "Geometry pool is out of indices" << std::endl;
+			return false;
+		}
+
+		lod.firstVertex = mesh.firstVertex;
+		lod.vertexCount = 0;
+		lod.firstIndex = static_cast<uint32_t>(firstIndex);
+		lod.indexCount = static_cast<uint32_t>(indices.size());
+
+		if (!UploadIndices(indices, lod.firstIndex))
+		{
+			FreeMesh(lod);
+			return false;
+		}
+
+		return true;
+	}
+
+	/*
+	@brief : Removes a mesh, its ranges are reused once the frames in flight are over
+	@param : The range given by AddMesh
+	*/
+	void GeometryPool::RemoveMesh(const MeshRange& mesh)
+	{
+		m_geometryPool->retiredMeshes.Push(m_device->GetDevice()->frameCounter, mesh);
+	}
+
+	/*
+	@brief : Binds the vertex and index buffers of the pool, once for every mesh it holds
+	@param : The command buffer in recording state
+	@param : The binding of the vertex input
+	*/
+	void GeometryPool::Bind(VkCommandBuffer commandBuffer, uint32_t binding) const
+	{
+		VkDeviceSize offset = 0;
+
+		vkCmdBindVertexBuffers(commandBuffer, binding, 1, &m_geometryPool->vertexBuffer.GetBuffer(), &offset);
+		vkCmdBindIndexBuffer(commandBuffer, m_geometryPool->indexBuffer.GetBuffer(), 0, m_geometryPool->indexType);
+	}
+
+	/*
+	@brief : Draws a mesh of the pool, the pool must be bound
+	@param : The command buffer in recording state
+	@param : The range given by AddMesh
+	@param : The number of instances
+	@param : The first instance
+	*/
+	void GeometryPool::Draw(VkCommandBuffer commandBuffer, const MeshRange& mesh, uint32_t instanceCount, uint32_t firstInstance) const
+	{
+		vkCmdDrawIndexed(commandBuffer, mesh.indexCount, instanceCount, mesh.firstIndex, static_cast<int32_t>(mesh.firstVertex), firstInstance);
+	}
+
+	/*
+	@brief : Assigns the geometry pool by move semantic
+	@param : The geometry pool to move
+	@return : A reference to this
+	*/
+	GeometryPool& GeometryPool::operator=(GeometryPool&& geometryPool) noexcept
+	{
+		std::swap(m_device, geometryPool.m_device);
+		std::swap(m_geometryPool, geometryPool.m_geometryPool);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool GeometryPool::UploadIndices(const std::vector<uint32_t>& indices, uint32_t firstIndex)
+	{
+		if (m_geometryPool->indexType == VK_INDEX_TYPE_UINT32)
+			return m_geometryPool->indexBuffer.Upload(indices.data(), indices.size() * sizeof(uint32_t), firstIndex * sizeof(uint32_t));
+
+		std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+
+		return m_geometryPool->indexBuffer.Upload(shortIndices.data(), shortIndices.size() * sizeof(uint16_t), firstIndex * sizeof(uint16_t));
+	}
+
+	//-------------------------------------------------------------------------
+
+	void GeometryPool::FreeMesh(const MeshRange& mesh)
+	{
+		m_geometryPool->vertexRanges.Free(mesh.firstVertex, mesh.vertexCount);
+		m_geometryPool->indexRanges.Free(mesh.firstIndex, mesh.indexCount);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/Image.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a 2D image in device local memory given by a shared allocator, and a view on all its mip levels
+	@param : A reference to the Device
+	@param : The allocator giving the memory of the image
+	@param : The width of the image
+	@param : The height of the image
+	@param : The format of the image
+	@param : The usage of the image (sampled, attachment, transfer...)
+	@param : The number of mip levels, GetMipLevelCount gives the full chain
+	@param : The aspect of the view (color, depth...)
+	@param : The number of samples per texel, multisampled images are attachments with a single mip level
+	*/
+	Image::Image(Device& device, MemoryAllocator& allocator, uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, uint32_t mipLevels,
+		VkImageAspectFlags aspect, VkSampleCountFlagBits samples)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_image = std::make_shared<Images>();
+
+		m_image->allocator = MemoryAllocator(allocator);
+		m_image->format = format;
+		m_image->extent = { width, height };
+		m_image->mipLevels = std::max(std::min(mipLevels, GetMipLevelCount(width, height)), 1u);
+		m_image->aspect = aspect;
+		m_image->usage = usage;
+		m_image->samples = samples;
+
+		if (!CreateImage() || !CreateImageView())
+			std::cout << "Failed to create image" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the image and its layout
+	@param : A constant reference to the Image to copy
+	*/
+	Image::Image(const Image& image) : m_device(image.m_device), m_image(image.m_image)
+	{}
+
+	/*
+	@brief : Destroys the image and gives its memory back to the allocator once its last owner goes away
+	*/
+	Image::~Image()
+	{
+		if ((m_image == nullptr) || (m_image.use_count() > 1))
+			return;
+
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		if (m_image->depthView != VK_NULL_HANDLE)
+		{
+			vkDestroyImageView(logicalDevice, m_image->depthView, nullptr);
+			m_image->depthView = VK_NULL_HANDLE;
+		}
+
+		if (m_image->imageView != VK_NULL_HANDLE)
+		{
+			vkDestroyImageView(logicalDevice, m_image->imageView, nullptr);
+			m_image->imageView = VK_NULL_HANDLE;
+		}
+
+		if (m_image->image != VK_NULL_HANDLE)
+		{
+			vkDestroyImage(logicalDevice, m_image->image, nullptr);
+			m_image->image = VK_NULL_HANDLE;
+		}
+
+		if (m_image->allocation.memory != VK_NULL_HANDLE)
+		{
+			m_image->allocator.Free(m_image->allocation);
+			m_image->allocation = MemoryAllocation();
+		}
+	}
+
+	/*
+	@brief : Records the barrier moving every mip level from the tracked layout to a new one, nothing is recorded if the layout is the same
+	@param : The command buffer in recording state
+	@param : The new layout
+	*/
+	void Image::Transition(VkCommandBuffer commandBuffer, VkImageLayout layout)
+	{
+		if (m_image->layout == layout)
+			return;
+
+		Barrier(commandBuffer, m_image->layout, layout, 0, m_image->mipLevels);
+		m_image->layout = layout;
+	}
+
+	/*
+	@brief : Records the generation of the mip chain from the first level by successive linear blits, the image ends in the shader read layout
+	@param : The command buffer in recording state
+	@return : Returns true if the chain is generated, false if the format cannot be blitted with a linear filter
+	*/
+	bool Image::GenerateMips(VkCommandBuffer commandBuffer)
+	{
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(m_device->GetDevice()->physicalDevice, m_image->format, &formatProperties);
+
+		VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+		if ((formatProperties.optimalTilingFeatures & blitFeatures) != blitFeatures)
+		{
+			std::cout << "Image format does not support mip generation by linear blits" << std::endl;
+			Transition(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			return false;
+		}
+
+		Transition(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+		int32_t width = static_cast<int32_t>(m_image->extent.width);
+		int32_t height = static_cast<int32_t>(m_image->extent.height);
+
+		// Each level is read once the previous blit wrote it, then handed to the shaders
+		for (uint32_t i = 1; i < m_image->mipLevels; i++)
+		{
+			Barrier(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, i - 1, 1);
+
+			int32_t mipWidth = std::max(width / 2, 1);
+			int32_t mipHeight = std::max(height / 2, 1);
+
+			VkImageBlit imageBlit =
+			{
+				{ m_image->aspect, i - 1, 0, 1 },
+				{ { 0, 0, 0 }, { width, height, 1 } },
+				{ m_image->aspect, i, 0, 1 },
+				{ { 0, 0, 0 }, { mipWidth, mipHeight, 1 } }
+			};
+
+			vkCmdBlitImage(commandBuffer, m_image->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_image->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR);
+
+			Barrier(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, i - 1, 1);
+
+			width = mipWidth;
+			height = mipHeight;
+		}
+
+		Barrier(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_image->mipLevels - 1, 1);
+		m_image->layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		return true;
+	}
+
+	/*
+	@brief : Gives the number of levels of a full mip chain
+	@param : The width of the first level
+	@param : The height of the first level
+	@return : The number of levels down to 1x1
+	*/
+	uint32_t Image::GetMipLevelCount(uint32_t width, uint32_t height)
+	{
+		uint32_t levels = 1;
+
+		for (uint32_t size = std::max(width, height); size > 1; size /= 2)
+			levels++;
+
+		return levels;
+	}
+
+	/*
+	@brief : Assigns the image by move semantic
+	@param : The image to move
+	@return : A reference to this
+	*/
+	Image& Image::operator=(Image&& image) noexcept
+	{
+		std::swap(m_device, image.m_device);
+		std::swap(m_image, image.m_image);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool Image::CreateImage()
+	{
+		VkImageCreateInfo imageCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+			nullptr,
+			0,
+			VK_IMAGE_TYPE_2D,
+			m_image->format,
+			{ m_image->extent.width, m_image->extent.height, 1 },
+			m_image->mipLevels,
+			1,
+			m_image->samples,
+			VK_IMAGE_TILING_OPTIMAL,
+			m_image->usage,
+			VK_SHARING_MODE_EXCLUSIVE,
+			0,
+			nullptr,
+			VK_IMAGE_LAYOUT_UNDEFINED
+		};
+
+		if (vkCreateImage(m_device->GetDevice()->logicalDevice, &imageCreateInfo, nullptr, &m_image->image) != VK_SUCCESS)
+			return false;
+
+		VkMemoryRequirements memoryRequirements;
+		vkGetImageMemoryRequirements(m_device->GetDevice()->logicalDevice, m_image->image, &memoryRequirements);
+
+		// Transient attachments never leave the tile memory of tiled GPUs, the device only backs them with lazily allocated memory when it has to
+		VkMemoryPropertyFlags memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+		if (((m_image->usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0)
+			&& m_image->allocator.IsMemoryTypeAvailable(memoryRequirements.memoryTypeBits, memoryProperties | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT))
+			memoryProperties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+		if (!m_image->allocator.Allocate(memoryRequirements, memoryProperties, m_image->allocation))
+			return false;
+
+		return vkBindImageMemory(m_device->GetDevice()->logicalDevice, m_image->image, m_image->allocation.memory, m_image->allocation.offset) == VK_SUCCESS;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool Image::CreateImageView()
+	{
+		VkImageViewCreateInfo imageViewInfo =
+		{
+			VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+			nullptr,
+			0,
+			m_image->image,
+			VK_IMAGE_VIEW_TYPE_2D,
+			m_image->format,
+			{
+				VK_COMPONENT_SWIZZLE_IDENTITY,
+				VK_COMPONENT_SWIZZLE_IDENTITY,
+				VK_COMPONENT_SWIZZLE_IDENTITY,
+				VK_COMPONENT_SWIZZLE_IDENTITY
+			},
+			{
+				m_image->aspect,
+				0,
+				m_image->mipLevels,
+				0,
+				1
+			}
+		};
+
+		if (vkCreateImageView(m_device->GetDevice()->logicalDevice, &imageViewInfo, nullptr, &m_image->imageView) != VK_SUCCESS)
+			return false;
+
+		bool depthStencil = (m_image->aspect & VK_IMAGE_ASPECT_DEPTH_BIT) && (m_image->aspect & VK_IMAGE_ASPECT_STENCIL_BIT);
+
+		if (!depthStencil || !(m_image->usage & (VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)))
+			return true;
+
+		imageViewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+		return vkCreateImageView(m_device->GetDevice()->logicalDevice, &imageViewInfo, nullptr, &m_image->depthView) == VK_SUCCESS;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void Image::Barrier(VkCommandBuffer commandBuffer, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t baseMipLevel, uint32_t mipLevelCount) const
+	{
+		VkAccessFlags srcAccess = 0;
+		VkAccessFlags dstAccess = 0;
+		VkPipelineStageFlags srcStages = 0;
+		VkPipelineStageFlags dstStages = 0;
+
+		GetLayoutAccess(oldLayout, srcAccess, srcStages);
+		GetLayoutAccess(newLayout, dstAccess, dstStages);
+
+		VkImageMemoryBarrier imageMemoryBarrier =
+		{
+			VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			nullptr,
+			srcAccess,
+			dstAccess,
+			oldLayout,
+			newLayout,
+			VK_QUEUE_FAMILY_IGNORED,
+			VK_QUEUE_FAMILY_IGNORED,
+			m_image->image,
+			{
+				m_image->aspect,
+				baseMipLevel,
+				mipLevelCount,
+				0,
+				1
+			}
+		};
+
+		vkCmdPipelineBarrier(commandBuffer, srcStages, dstStages, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+	}
+
+	//-------------------------------------------------------------------------
+
+	void Image::GetLayoutAccess(VkImageLayout layout, VkAccessFlags& access, VkPipelineStageFlags& stages)
+	{
+		switch (layout)
+		{
+		case VK_IMAGE_LAYOUT_UNDEFINED:
+			access = 0;
+			stages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+			access = VK_ACCESS_TRANSFER_WRITE_BIT;
+			stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+			access = VK_ACCESS_TRANSFER_READ_BIT;
+			stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+			access = VK_ACCESS_SHADER_READ_BIT;
+			stages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+			access = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+			access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+			access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+			stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+			access = 0;
+			stages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+			break;
+		default:
+			access = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+			stages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+			break;
+		}
+	}
+}
\ No newline at end of file
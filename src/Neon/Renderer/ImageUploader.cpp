@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/ImageUploader.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a persistently mapped staging buffer split in one region per frame in flight, the uploads of a frame are recorded together
+	@param : A reference to the Device
+	@param : The size in bytes of the staging region of each frame
+	@param : The number of frames in flight
+	*/
+	ImageUploader::ImageUploader(Device& device, VkDeviceSize frameSize, uint32_t frameCount)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_imageUploader = std::make_shared<ImageUploaders>();
+
+		m_imageUploader->frameSize = frameSize;
+		m_imageUploader->frameCount = frameCount;
+
+		if (!CreateStagingBuffer())
+			std::cout << "Failed to create image uploader" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the staging buffer and the pending uploads
+	@param : A constant reference to the ImageUploader to copy
+	*/
+	ImageUploader::ImageUploader(const ImageUploader& imageUploader) : m_device(imageUploader.m_device), m_imageUploader(imageUploader.m_imageUploader)
+	{}
+
+	/*
+	@brief : Destroys an uploader, the staging buffers are freed with its last owner
+	*/
+	ImageUploader::~ImageUploader()
+	{}
+
+	/*
+	@brief : Rewinds the uploader on the staging region of a frame, the dedicated staging buffers of the frames over are released
+	@param : The index of the frame in flight, its fence must have been waited on and the Device must have begun the frame
+	*/
+	void ImageUploader::BeginFrame(uint32_t frameIndex)
+	{
+		m_imageUploader->frameBegin = (frameIndex % m_imageUploader->frameCount) * m_imageUploader->frameSize;
+		m_imageUploader->head = m_imageUploader->frameBegin;
+		m_imageUploader->frameOpen = true;
+
+		// The buffers are destroyed with their last copy
+		m_imageUploader->retiredBuffers.Release(m_device->GetDevice()->frameCounter, [](Buffer&) {});
+	}
+
+	/*
+	@brief : Stages the data of a mip level of an image, the copy is recorded by the next call to Record
+	@param : The image, with the transfer destination usage
+	@param : The texels of the level, tightly packed
+	@param : The size of the texels in bytes
+	@param : The mip level to write
+	@return : Returns true if the data is staged, false if the region of the frame is full or the level does not exist
+	*/
+	bool ImageUploader::Upload(const Image& image, const void* data, VkDeviceSize size, uint32_t mipLevel)
+	{
+		if (mipLevel >= image.GetMipLevels())
+		{
+			std::cout << "Image has no mip level " << mipLevel << std::endl;
+			return false;
+		}
+
+		Buffer stagingBuffer = m_imageUploader->stagingBuffer;
+		VkDeviceSize offset = ((m_imageUploader->head + m_imageUploader->alignment - 1) / m_imageUploader->alignment) * m_imageUploader->alignment;
+
+		// Uploads outside of a frame, at load time, or larger than a region get their own staging buffer
+		if (!m_imageUploader->frameOpen || (size > m_imageUploader->frameSize))
+		{
+			stagingBuffer = Buffer(*m_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, data);
+			offset = 0;
+
+			if (!stagingBuffer.IsValid())
+				return false;
+		}
+		else if (offset + size > m_imageUploader->frameBegin + m_imageUploader->frameSize)
+		{
+			std::cout << "Image uploader is full for this frame" << std::endl;
+			return false;
+		}
+		else
+		{
+			std::memcpy(static_cast<char*>(stagingBuffer.GetData()) + offset, data, static_cast<std::size_t>(size));
+			m_imageUploader->head = offset + size;
+		}
+
+		VkExtent2D extent = image.GetExtent();
+
+		VkBufferImageCopy bufferImageCopy =
+		{
+			offset,
+			0,
+			0,
+			{
+				image.GetAspect(),
+				mipLevel,
+				0,
+				1
+			},
+			{ 0, 0, 0 },
+			{ std::max(extent.width >> mipLevel, 1u), std::max(extent.height >> mipLevel, 1u), 1 }
+		};
+
+		GetPendingUpload(image, stagingBuffer).copies.push_back(bufferImageCopy);
+
+		return true;
+	}
+
+	/*
+	@brief : Asks for the mip chain of an image to be generated from its first level once its pending copies are recorded
+	@param : The image, with the transfer source and destination usages
+	*/
+	void ImageUploader::GenerateMips(const Image& image)
+	{
+		for (PendingUpload& pendingUpload : m_imageUploader->pendingUploads)
+		{
+			if (pendingUpload.image.GetImage() == image.GetImage())
+			{
+				pendingUpload.generateMips = true;
+				return;
+			}
+		}
+
+		GetPendingUpload(image, Buffer()).generateMips = true;
+	}
+
+	/*
+	@brief : Records every pending upload, the images end in the shader read layout
+	@param : The command buffer of the frame in recording state, outside of a render pass
+	@return : Returns true if the uploads are recorded, false if the staged data could not be flushed
+	*/
+	bool ImageUploader::Record(VkCommandBuffer commandBuffer)
+	{
+		m_imageUploader->frameOpen = false;
+
+		if (m_imageUploader->pendingUploads.empty())
+			return true;
+
+		if ((m_imageUploader->head > m_imageUploader->frameBegin)
+			&& !m_imageUploader->stagingBuffer.Flush(m_imageUploader->frameBegin, m_imageUploader->head - m_imageUploader->frameBegin))
+			return false;
+
+		std::vector<PendingUpload>& pendingUploads = m_imageUploader->pendingUploads;
+
+		for (PendingUpload& pendingUpload : pendingUploads)
+		{
+			pendingUpload.image.Transition(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+			if (!pendingUpload.copies.empty())
+			{
+				vkCmdCopyBufferToImage(commandBuffer, pendingUpload.stagingBuffer.GetBuffer(), pendingUpload.image.GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					static_cast<uint32_t>(pendingUpload.copies.size()), pendingUpload.copies.data());
+			}
+
+			if (pendingUpload.stagingBuffer.IsValid() && (pendingUpload.stagingBuffer.GetBuffer() != m_imageUploader->stagingBuffer.GetBuffer()))
+				m_imageUploader->retiredBuffers.Push(m_device->GetDevice()->frameCounter, pendingUpload.stagingBuffer);
+		}
+
+		// An image staged in several buffers is finished once, after all its copies
+		for (PendingUpload& pendingUpload : pendingUploads)
+		{
+			if (pendingUpload.image.GetLayout() != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+				continue;
+
+			bool generateMips = std::any_of(pendingUploads.begin(), pendingUploads.end(), [&pendingUpload](const PendingUpload& upload)
+			{
+				return upload.generateMips && (upload.image.GetImage() == pendingUpload.image.GetImage());
+			});
+
+			if (generateMips)
+				pendingUpload.image.GenerateMips(commandBuffer);
+			else
+				pendingUpload.image.Transition(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		}
+
+		pendingUploads.clear();
+
+		return true;
+	}
+
+	/*
+	@brief : Assigns the uploader by move semantic
+	@param : The uploader to move
+	@return : A reference to this
+	*/
+	ImageUploader& ImageUploader::operator=(ImageUploader&& imageUploader) noexcept
+	{
+		std::swap(m_device, imageUploader.m_device);
+		std::swap(m_imageUploader, imageUploader.m_imageUploader);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool ImageUploader::CreateStagingBuffer()
+	{
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		// Copy offsets must be multiples of the texel block size, 16 bytes covers every compressed format
+		m_imageUploader->alignment = std::max<VkDeviceSize>(deviceProperties.limits.optimalBufferCopyOffsetAlignment, 16);
+		m_imageUploader->frameSize = ((m_imageUploader->frameSize + m_imageUploader->alignment - 1) / m_imageUploader->alignment) * m_imageUploader->alignment;
+
+		m_imageUploader->stagingBuffer = Buffer(*m_device, m_imageUploader->frameSize * m_imageUploader->frameCount, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+		return m_imageUploader->stagingBuffer.IsValid();
+	}
+
+	//-------------------------------------------------------------------------
+
+	ImageUploader::PendingUpload& ImageUploader::GetPendingUpload(const Image& image, const Buffer& stagingBuffer)
+	{
+		VkBuffer buffer = stagingBuffer.IsValid() ? stagingBuffer.GetBuffer() : VK_NULL_HANDLE;
+
+		for (PendingUpload& pendingUpload : m_imageUploader->pendingUploads)
+		{
+			VkBuffer pendingBuffer = pendingUpload.stagingBuffer.IsValid() ? pendingUpload.stagingBuffer.GetBuffer() : VK_NULL_HANDLE;
+
+			if ((pendingUpload.image.GetImage() == image.GetImage()) && ((pendingBuffer == buffer) || (pendingBuffer == VK_NULL_HANDLE)))
+			{
+				if (pendingBuffer == VK_NULL_HANDLE)
+					pendingUpload.stagingBuffer = Buffer(stagingBuffer);
+
+				return pendingUpload;
+			}
+		}
+
+		m_imageUploader->pendingUploads.emplace_back();
+
+		PendingUpload& pendingUpload = m_imageUploader->pendingUploads.back();
+		pendingUpload.image = Image(image);
+		pendingUpload.stagingBuffer = Buffer(stagingBuffer);
+
+		return pendingUpload;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/IndexBuffer.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Constructs a device local buffer of 16 bits indices
+	@param : A reference to the Device
+	@param : The indices
+	*/
+	IndexBuffer::IndexBuffer(Device& device, const std::vector<uint16_t>& indices) : m_indexType(VK_INDEX_TYPE_UINT16), m_indexCount(static_cast<uint32_t>(indices.size()))
+	{
+		CreateIndexBuffer(device, indices.data(), indices.size() * sizeof(uint16_t));
+	}
+
+	/*
+	@brief : Constructs a device local buffer of indices, stored on 16 bits when every index fits in them
+	@param : A reference to the Device
+	@param : The indices
+	*/
+	IndexBuffer::IndexBuffer(Device& device, const std::vector<uint32_t>& indices) : m_indexType(VK_INDEX_TYPE_UINT32), m_indexCount(static_cast<uint32_t>(indices.size()))
+	{
+		// Half the memory and bandwidth for the meshes with less than 65536 vertices
+		if (!indices.empty() && (*std::max_element(indices.begin(), indices.end()) <= UINT16_MAX))
+		{
+			std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+
+			m_indexType = VK_INDEX_TYPE_UINT16;
+			CreateIndexBuffer(device, shortIndices.data(), shortIndices.size() * sizeof(uint16_t));
+		}
+		else
+			CreateIndexBuffer(device, indices.data(), indices.size() * sizeof(uint32_t));
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the buffer
+	@param : A constant reference to the IndexBuffer to copy
+	*/
+	IndexBuffer::IndexBuffer(const IndexBuffer& indexBuffer) : m_buffer(indexBuffer.m_buffer), m_indexType(indexBuffer.m_indexType), m_indexCount(indexBuffer.m_indexCount)
+	{}
+
+	/*
+	@brief : Destroys an index buffer, the memory is freed with the last owner of the buffer
+	*/
+	IndexBuffer::~IndexBuffer()
+	{}
+
+	/*
+	@brief : Binds the index buffer with its index type
+	@param : The command buffer in recording state
+	*/
+	void IndexBuffer::Bind(VkCommandBuffer commandBuffer) const
+	{
+		vkCmdBindIndexBuffer(commandBuffer, m_buffer.GetBuffer(), 0, m_indexType);
+	}
+
+	/*
+	@brief : Assigns the index buffer by move semantic
+	@param : The index buffer to move
+	@return : A reference to this
+	*/
+	IndexBuffer& IndexBuffer::operator=(IndexBuffer&& indexBuffer) noexcept
+	{
+		std::swap(m_buffer, indexBuffer.m_buffer);
+		std::swap(m_indexType, indexBuffer.m_indexType);
+		std::swap(m_indexCount, indexBuffer.m_indexCount);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	void IndexBuffer::CreateIndexBuffer(Device& device, const void* indices, VkDeviceSize size)
+	{
+		m_buffer = Buffer(device, size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indices);
+
+		if (!m_buffer.IsValid())
+			std::cout << "Failed to create index buffer" << std::endl;
+	}
+}
\ No newline at end of file
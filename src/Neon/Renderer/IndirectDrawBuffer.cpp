@@ -0,0 +1,212 @@
+#include <iostream>
+#include <vector>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/GeometryPool.hpp>
+#include <Neon/Renderer/IndirectDrawBuffer.hpp>
+#include <Neon/Renderer/InstanceBuffer.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a persistently mapped buffer of indexed draw commands, split in one region per frame in flight
+	@param : A reference to the Device
+	@param : The maximum number of draws of a frame
+	@param : The number of frames in flight
+	*/
+	IndirectDrawBuffer::IndirectDrawBuffer(Device& device, uint32_t maxDraws, uint32_t frameCount)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_indirectBuffer = std::make_shared<IndirectDrawBuffers>();
+
+		m_indirectBuffer->maxDraws = maxDraws;
+		m_indirectBuffer->frameCount = frameCount;
+		m_indirectBuffer->countSupported = (m_device->GetDevice()->drawIndexedIndirectCount != nullptr);
+
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		// A region starts with the draw count then the commands, both can be bound as storage buffers by a culling shader
+		VkDeviceSize alignment = deviceProperties.limits.minStorageBufferOffsetAlignment;
+
+		m_indirectBuffer->countStride = AlignUp(sizeof(uint32_t), alignment);
+		m_indirectBuffer->frameSize = AlignUp(m_indirectBuffer->countStride + maxDraws * sizeof(VkDrawIndexedIndirectCommand), alignment);
+
+		// The list can be built on the compute queue and drawn on the graphics queue
+		std::vector<uint32_t> queueFamilies = { m_device->GetDevice()->graphicsIndexFamily, m_device->GetDevice()->computeIndexFamily };
+
+		m_indirectBuffer->buffer = Buffer(*m_device, m_indirectBuffer->frameSize * frameCount,
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, nullptr,
+			queueFamilies);
+
+		if (!IsValid())
+			std::cout << "Failed to create indirect draw buffer" << std::endl;
+		else
+			BeginFrame(0);
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the buffer
+	@param : A constant reference to the IndirectDrawBuffer to copy
+	*/
+	IndirectDrawBuffer::IndirectDrawBuffer(const IndirectDrawBuffer& indirectDrawBuffer) : m_device(indirectDrawBuffer.m_device), m_indirectBuffer(indirectDrawBuffer.m_indirectBuffer)
+	{}
+
+	/*
+	@brief : Destroys an indirect draw buffer, the memory is freed with the last owner of the buffer
+	*/
+	IndirectDrawBuffer::~IndirectDrawBuffer()
+	{}
+
+	/*
+	@brief : Rewinds the draw list on the region of a frame
+	@param : The index of the frame in flight, its fence must have been waited on
+	*/
+	void IndirectDrawBuffer::BeginFrame(uint32_t frameIndex)
+	{
+		m_indirectBuffer->frameBegin = (frameIndex % m_indirectBuffer->frameCount) * m_indirectBuffer->frameSize;
+		m_indirectBuffer->drawCount = 0;
+		m_indirectBuffer->firstInstances.clear();
+	}
+
+	/*
+	@brief : Appends the draw of a mesh of the geometry pool to the list of the current frame
+	@param : The range of the mesh in the geometry pool
+	@param : The number of instances
+	@param : The first instance, Draw binds the instance buffer at it when the device lacks drawIndirectFirstInstance
+	@return : Returns true if the draw is added, false if the list is full
+	*/
+	bool IndirectDrawBuffer::AddDraw(const MeshRange& mesh, uint32_t instanceCount, uint32_t firstInstance)
+	{
+		if (m_indirectBuffer->drawCount >= m_indirectBuffer->maxDraws)
+		{
+			std::cout << "Indirect draw buffer is full for this frame" << std::endl;
+			return false;
+		}
+
+		VkDrawIndexedIndirectCommand* commands = reinterpret_cast<VkDrawIndexedIndirectCommand*>(static_cast<char*>(m_indirectBuffer->buffer.GetData())
+			+ GetCommandOffset());
+
+		commands[m_indirectBuffer->drawCount] =
+		{
+			mesh.indexCount,
+			instanceCount,
+			mesh.firstIndex,
+			static_cast<int32_t>(mesh.firstVertex),
+			m_device->GetDevice()->drawIndirectFirstInstance ? firstInstance : 0
+		};
+
+		m_indirectBuffer->firstInstances.push_back(firstInstance);
+		m_indirectBuffer->drawCount++;
+
+		return true;
+	}
+
+	/*
+	@brief : Writes the draw count of the list built by AddDraw and makes it visible to the device, a list built by a culling shader must not be flushed, the host count would overwrite the one the shader appends to
+	@return : Returns true if the flush is a success, false otherwise
+	*/
+	bool IndirectDrawBuffer::Flush()
+	{
+		*reinterpret_cast<uint32_t*>(static_cast<char*>(m_indirectBuffer->buffer.GetData()) + GetCountOffset()) = m_indirectBuffer->drawCount;
+
+		return m_indirectBuffer->buffer.Flush(m_indirectBuffer->frameBegin, m_indirectBuffer->countStride
+			+ m_indirectBuffer->drawCount * sizeof(VkDrawIndexedIndirectCommand));
+	}
+
+	/*
+	@brief : Clears the draw count of the current frame on the device, before a culling shader appends its draws
+	@param : The command buffer in recording state, outside of a render pass
+	*/
+	void IndirectDrawBuffer::ResetCount(VkCommandBuffer commandBuffer) const
+	{
+		vkCmdFillBuffer(commandBuffer, m_indirectBuffer->buffer.GetBuffer(), GetCountOffset(), sizeof(uint32_t), 0);
+
+		// DrawCount issues every command without the count extension, the ones left unwritten must not draw
+		if (!m_indirectBuffer->countSupported)
+			vkCmdFillBuffer(commandBuffer, m_indirectBuffer->buffer.GetBuffer(), GetCommandOffset(), GetCommandRange(), 0);
+	}
+
+	/*
+	@brief : Draws the list built on the CPU by AddDraw, the geometry pool and the instance buffer must be bound
+	@param : The command buffer in recording state
+	@param : The instance buffer the first instances of the draws index
+	@param : The binding of the per instance vertex input
+	*/
+	void IndirectDrawBuffer::Draw(VkCommandBuffer commandBuffer, const InstanceBuffer& instanceBuffer, uint32_t binding) const
+	{
+		if (m_device->GetDevice()->drawIndirectFirstInstance)
+		{
+			DrawCommands(commandBuffer, m_indirectBuffer->drawCount);
+			return;
+		}
+
+		// The commands start at the instance 0, the instance binding is moved to the first instance of each draw
+		for (uint32_t i = 0; i < m_indirectBuffer->drawCount; i++)
+		{
+			instanceBuffer.Bind(commandBuffer, binding, m_indirectBuffer->firstInstances[i]);
+			vkCmdDrawIndexedIndirect(commandBuffer, m_indirectBuffer->buffer.GetBuffer(), GetCommandOffset() + i * sizeof(VkDrawIndexedIndirectCommand), 1, 0);
+		}
+
+		instanceBuffer.Bind(commandBuffer, binding);
+	}
+
+	/*
+	@brief : Draws the list built on the device, without VK_KHR_draw_indirect_count all the commands are issued and the ones left cleared by ResetCount draw nothing
+	@param : The command buffer in recording state
+	*/
+	void IndirectDrawBuffer::DrawCount(VkCommandBuffer commandBuffer) const
+	{
+		if (!IsCountSupported())
+		{
+			DrawCommands(commandBuffer, m_indirectBuffer->maxDraws);
+			return;
+		}
+
+		m_device->GetDevice()->drawIndexedIndirectCount(commandBuffer, m_indirectBuffer->buffer.GetBuffer(), GetCommandOffset(), m_indirectBuffer->buffer.GetBuffer(),
+			GetCountOffset(), m_indirectBuffer->maxDraws, sizeof(VkDrawIndexedIndirectCommand));
+	}
+
+	/*
+	@brief : Assigns the indirect draw buffer by move semantic
+	@param : The indirect draw buffer to move
+	@return : A reference to this
+	*/
+	IndirectDrawBuffer& IndirectDrawBuffer::operator=(IndirectDrawBuffer&& indirectDrawBuffer) noexcept
+	{
+		std::swap(m_device, indirectDrawBuffer.m_device);
+		std::swap(m_indirectBuffer, indirectDrawBuffer.m_indirectBuffer);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	void IndirectDrawBuffer::DrawCommands(VkCommandBuffer commandBuffer, uint32_t drawCount) const
+	{
+		if (drawCount == 0)
+			return;
+
+		// Without multiDrawIndirect a call reads a single command
+		if (m_device->GetDevice()->multiDrawIndirect)
+		{
+			vkCmdDrawIndexedIndirect(commandBuffer, m_indirectBuffer->buffer.GetBuffer(), GetCommandOffset(), drawCount, sizeof(VkDrawIndexedIndirectCommand));
+			return;
+		}
+
+		for (uint32_t i = 0; i < drawCount; i++)
+			vkCmdDrawIndexedIndirect(commandBuffer, m_indirectBuffer->buffer.GetBuffer(), GetCommandOffset() + i * sizeof(VkDrawIndexedIndirectCommand), 1, 0);
+	}
+
+	//-------------------------------------------------------------------------
+
+	VkDeviceSize IndirectDrawBuffer::AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+	{
+		if (alignment <= 1)
+			return value;
+
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+}
\ No newline at end of file
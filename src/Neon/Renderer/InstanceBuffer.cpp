@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/Pipeline.hpp>
+#include <Neon/Renderer/InstanceBuffer.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a persistently mapped ring of per instance data, split in one region per frame in flight
+	@param : A reference to the Device
+	@param : The maximum number of instances of a frame
+	@param : The number of frames in flight
+	*/
+	InstanceBuffer::InstanceBuffer(Device& device, uint32_t maxInstances, uint32_t frameCount)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_instanceBuffer = std::make_shared<InstanceBuffers>();
+
+		m_instanceBuffer->maxInstances = maxInstances;
+		m_instanceBuffer->frameCount = frameCount;
+
+		m_instanceBuffer->buffer = Buffer(*m_device, static_cast<VkDeviceSize>(maxInstances) * frameCount * sizeof(InstanceData), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+		if (!IsValid())
+			std::cout << "Failed to create instance buffer" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the buffer
+	@param : A constant reference to the InstanceBuffer to copy
+	*/
+	InstanceBuffer::InstanceBuffer(const InstanceBuffer& instanceBuffer) : m_device(instanceBuffer.m_device), m_instanceBuffer(instanceBuffer.m_instanceBuffer)
+	{}
+
+	/*
+	@brief : Destroys an instance buffer, the memory is freed with the last owner of the buffer
+	*/
+	InstanceBuffer::~InstanceBuffer()
+	{}
+
+	/*
+	@brief : Rewinds the ring on the region of a frame
+	@param : The index of the frame in flight, its fence must have been waited on
+	*/
+	void InstanceBuffer::BeginFrame(uint32_t frameIndex)
+	{
+		m_instanceBuffer->frameIndex = frameIndex % m_instanceBuffer->frameCount;
+		m_instanceBuffer->instanceCount = 0;
+	}
+
+	/*
+	@brief : Allocates consecutive instances in the region of the current frame
+	@param : The number of instances
+	@param : The first instance to give to the draw, relative to the region bound by Bind
+	@return : Returns a pointer to the mapped memory of the instances, nullptr if the frame is full
+	*/
+	InstanceData* InstanceBuffer::Allocate(uint32_t instanceCount, uint32_t& firstInstance)
+	{
+		if (m_instanceBuffer->instanceCount + instanceCount > m_instanceBuffer->maxInstances)
+		{
+			std::cout << "Instance buffer is full for this frame" << std::endl;
+			return nullptr;
+		}
+
+		firstInstance = m_instanceBuffer->instanceCount;
+		m_instanceBuffer->instanceCount += instanceCount;
+
+		InstanceData* instances = static_cast<InstanceData*>(m_instanceBuffer->buffer.GetData());
+
+		return instances + m_instanceBuffer->frameIndex * m_instanceBuffer->maxInstances + firstInstance;
+	}
+
+	/*
+	@brief : Makes the instances of the current frame visible to the device
+	@return : Returns true if the flush is a success, false otherwise
+	*/
+	bool InstanceBuffer::Flush()
+	{
+		VkDeviceSize frameBegin = static_cast<VkDeviceSize>(m_instanceBuffer->frameIndex) * m_instanceBuffer->maxInstances * sizeof(InstanceData);
+
+		return m_instanceBuffer->buffer.Flush(frameBegin, m_instanceBuffer->instanceCount * sizeof(InstanceData));
+	}
+
+	/*
+	@brief : Binds the region of the current frame, the first allocation of the frame is the instance 0
+	@param : The command buffer in recording state
+	@param : The binding of the per instance vertex input
+	@param : The instance bound as the instance 0, for the draws starting at the instance 0 without drawIndirectFirstInstance
+	*/
+	void InstanceBuffer::Bind(VkCommandBuffer commandBuffer, uint32_t binding, uint32_t firstInstance) const
+	{
+		// Binding the frame region keeps firstInstance small, the draws of another allocation than the first one still need drawIndirectFirstInstance or a binding at their first instance
+		VkDeviceSize offset = (static_cast<VkDeviceSize>(m_instanceBuffer->frameIndex) * m_instanceBuffer->maxInstances + firstInstance) * sizeof(InstanceData);
+
+		vkCmdBindVertexBuffers(commandBuffer, binding, 1, &m_instanceBuffer->buffer.GetBuffer(), &offset);
+	}
+
+	/*
+	@brief : Adds the per instance binding of InstanceData to the vertex input of a pipeline, the transform takes four locations
+	@param : The description of the pipeline
+	@param : The binding of the per instance vertex input
+	@param : The location of the first row of the transform, the color follows the transform
+	*/
+	void InstanceBuffer::AddVertexInput(PipelineInfo& info, uint32_t binding, uint32_t firstLocation)
+	{
+		info.vertexBindings.push_back({ binding, sizeof(InstanceData), VK_VERTEX_INPUT_RATE_INSTANCE });
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			info.vertexAttributes.push_back({ firstLocation + i, binding, VK_FORMAT_R32G32B32A32_SFLOAT,
+				static_cast<uint32_t>(offsetof(InstanceData, transform) + i * 4 * sizeof(float)) });
+		}
+
+		info.vertexAttributes.push_back({ firstLocation + 4, binding, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<uint32_t>(offsetof(InstanceData, color)) });
+	}
+
+	/*
+	@brief : Assigns the instance buffer by move semantic
+	@param : The instance buffer to move
+	@return : A reference to this
+	*/
+	InstanceBuffer& InstanceBuffer::operator=(InstanceBuffer&& instanceBuffer) noexcept
+	{
+		std::swap(m_device, instanceBuffer.m_device);
+		std::swap(m_instanceBuffer, instanceBuffer.m_instanceBuffer);
+
+		return (*this);
+	}
+}
\ No newline at end of file
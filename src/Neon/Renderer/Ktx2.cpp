@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <Neon/Core/File.hpp>
+#include <Neon/Renderer/Ktx2.hpp>
+#include <Neon/Renderer/TextureCompression.hpp>
+
+namespace Zx
+{
+	namespace
+	{
+		const unsigned char Ktx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+		// Identifier, 9 header fields of 4 bytes, then the offsets of the data format, key values and supercompression data
+		const std::size_t Ktx2HeaderSize = 80;
+		const std::size_t Ktx2LevelSize = 24;
+
+		template <typename T>
+		T Read(const std::vector<char>& content, std::size_t offset)
+		{
+			T value;
+			std::memcpy(&value, content.data() + offset, sizeof(T));
+
+			return value;
+		}
+	}
+
+	/*
+	@brief : Reads a KTX2 container holding a 2D image, its levels are checked against the size of their format
+	@param : The file of the container
+	@param : The image, its levels point in its content
+	@return : Returns true if the container is read, false if it is invalid or uses a feature that is not supported (supercompression, arrays, cube maps, 3D)
+	*/
+	bool LoadKtx2(const File& file, Ktx2Image& image)
+	{
+		image = Ktx2Image();
+
+		if (!file.IsExist())
+		{
+			std::cout << "KTX2 file doesn't exist" << std::endl;
+			return false;
+		}
+
+		image.content = file.GetBinaryFileContent();
+		const std::vector<char>& content = image.content;
+
+		if ((content.size() < Ktx2HeaderSize) || (std::memcmp(content.data(), Ktx2Identifier, sizeof(Ktx2Identifier)) != 0))
+		{
+			std::cout << "Failed to read KTX2 file, the identifier is invalid" << std::endl;
+			return false;
+		}
+
+		uint32_t format = Read<uint32_t>(content, 12);
+		uint32_t pixelWidth = Read<uint32_t>(content, 20);
+		uint32_t pixelHeight = Read<uint32_t>(content, 24);
+		uint32_t pixelDepth = Read<uint32_t>(content, 28);
+		uint32_t layerCount = Read<uint32_t>(content, 32);
+		uint32_t faceCount = Read<uint32_t>(content, 36);
+		uint32_t levelCount = Read<uint32_t>(content, 40);
+		uint32_t supercompressionScheme = Read<uint32_t>(content, 44);
+
+		// Basis Universal payloads have no Vulkan format and need their own transcoder
+		if ((format == VK_FORMAT_UNDEFINED) || (supercompressionScheme != 0))
+		{
+			std::cout << "KTX2 supercompression is not supported" << std::endl;
+			return false;
+		}
+
+		if ((pixelWidth == 0) || (pixelHeight == 0) || (pixelDepth > 1) || (layerCount > 1) || (faceCount != 1))
+		{
+			std::cout << "Only 2D KTX2 textures are supported" << std::endl;
+			return false;
+		}
+
+		image.format = static_cast<VkFormat>(format);
+		image.width = pixelWidth;
+		image.height = pixelHeight;
+		image.generateMips = (levelCount == 0);
+
+		levelCount = std::max(levelCount, 1u);
+
+		if (levelCount > 32)
+		{
+			std::cout << "KTX2 file has too many levels" << std::endl;
+			return false;
+		}
+
+		if (content.size() < Ktx2HeaderSize + levelCount * Ktx2LevelSize)
+		{
+			std::cout << "Failed to read KTX2 file, the level index is truncated" << std::endl;
+			return false;
+		}
+
+		image.levels.resize(levelCount);
+
+		for (uint32_t i = 0; i < levelCount; i++)
+		{
+			uint64_t byteOffset = Read<uint64_t>(content, Ktx2HeaderSize + i * Ktx2LevelSize);
+			uint64_t byteLength = Read<uint64_t>(content, Ktx2HeaderSize + i * Ktx2LevelSize + 8);
+
+			VkDeviceSize levelSize = GetImageSize(image.format, std::max(pixelWidth >> i, 1u), std::max(pixelHeight >> i, 1u));
+
+			if (levelSize == 0)
+			{
+				std::cout << "KTX2 texture format " << format << " is not supported" << std::endl;
+				return false;
+			}
+
+			if ((byteLength < levelSize) || (byteOffset > content.size()) || (byteLength > content.size() - byteOffset))
+			{
+				std::cout << "Failed to read KTX2 file, the level " << i << " is truncated" << std::endl;
+				return false;
+			}
+
+			image.levels[i].offset = static_cast<std::size_t>(byteOffset);
+			image.levels[i].size = static_cast<std::size_t>(levelSize);
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
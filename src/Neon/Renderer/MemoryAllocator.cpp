@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/MemoryAllocator.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates an allocator sub-allocating resources in large blocks of device memory, one kind of block per memory type
+	@param : A reference to the Device
+	@param : The size of a block, resources larger than half a block get a dedicated allocation
+	*/
+	MemoryAllocator::MemoryAllocator(Device& device, VkDeviceSize blockSize)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_allocator = std::make_shared<MemoryAllocators>();
+
+		m_allocator->blockSize = blockSize;
+
+		vkGetPhysicalDeviceMemoryProperties(m_device->GetDevice()->physicalDevice, &m_allocator->memoryProperties);
+
+		// Linear and optimal resources sharing a block must be granularity apart, every offset is aligned on it
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		m_allocator->granularity = std::max<VkDeviceSize>(deviceProperties.limits.bufferImageGranularity, 1);
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the blocks of the allocator
+	@param : A constant reference to the MemoryAllocator to copy
+	*/
+	MemoryAllocator::MemoryAllocator(const MemoryAllocator& allocator) : m_device(allocator.m_device), m_allocator(allocator.m_allocator)
+	{}
+
+	/*
+	@brief : Frees every block once the last owner of the allocator goes away
+	*/
+	MemoryAllocator::~MemoryAllocator()
+	{
+		if ((m_allocator == nullptr) || (m_allocator.use_count() > 1))
+			return;
+
+		for (uint32_t i = 0; i < m_allocator->blocks.size(); i++)
+			FreeBlock(i);
+
+		m_allocator->blocks.clear();
+	}
+
+	/*
+	@brief : Allocates memory for a resource in the first block of a matching memory type with enough room
+	@param : The memory requirements of the resource
+	@param : The memory properties the resource needs
+	@param : The allocation, to bind the resource to its memory at its offset
+	@return : Returns true if the allocation is a success, false if no memory type matches or the device is out of memory
+	*/
+	bool MemoryAllocator::Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags memoryProperties, MemoryAllocation& allocation)
+	{
+		uint32_t memoryType = FindMemoryType(requirements.memoryTypeBits, memoryProperties);
+
+		if (memoryType == UINT32_MAX)
+		{
+			std::cout << "No memory type matches the resource" << std::endl;
+			return false;
+		}
+
+		VkDeviceSize alignment = std::max(requirements.alignment, m_allocator->granularity);
+		VkDeviceSize size = ((requirements.size + m_allocator->granularity - 1) / m_allocator->granularity) * m_allocator->granularity;
+
+		uint32_t block = UINT32_MAX;
+		uint64_t offset = 0;
+
+		// Large resources would waste most of a block, they get their own memory
+		bool dedicated = size > m_allocator->blockSize / 2;
+
+		for (uint32_t i = 0; (i < m_allocator->blocks.size()) && !dedicated; i++)
+		{
+			MemoryBlock& memoryBlock = m_allocator->blocks[i];
+
+			if ((memoryBlock.memory != VK_NULL_HANDLE) && !memoryBlock.dedicated && (memoryBlock.memoryType == memoryType)
+				&& memoryBlock.ranges.Allocate(size, alignment, offset))
+			{
+				block = i;
+				break;
+			}
+		}
+
+		if (block == UINT32_MAX)
+		{
+			if (!AllocateBlock(memoryType, dedicated ? size : m_allocator->blockSize, dedicated, block))
+			{
+				std::cout << "Failed to allocate a memory block" << std::endl;
+				return false;
+			}
+
+			m_allocator->blocks[block].ranges.Allocate(size, alignment, offset);
+		}
+
+		allocation.memory = m_allocator->blocks[block].memory;
+		allocation.offset = offset;
+		allocation.size = size;
+		allocation.memoryType = memoryType;
+		allocation.block = block;
+
+		m_allocator->usedSize += size;
+
+		return true;
+	}
+
+	/*
+	@brief : Gives back the memory of a resource, the resource must not be in use by the device anymore
+	@param : The allocation given by Allocate
+	*/
+	void MemoryAllocator::Free(const MemoryAllocation& allocation)
+	{
+		if (allocation.block >= m_allocator->blocks.size())
+			return;
+
+		MemoryBlock& memoryBlock = m_allocator->blocks[allocation.block];
+
+		memoryBlock.ranges.Free(allocation.offset, allocation.size);
+		m_allocator->usedSize -= allocation.size;
+
+		// Shared blocks stay allocated for the next resources, dedicated ones go back to the device at once
+		if (memoryBlock.dedicated)
+			FreeBlock(allocation.block);
+	}
+
+	/*
+	@brief : Tells if a memory type allowed for a resource has the given properties
+	@param : The memory types allowed by the requirements of the resource
+	@param : The memory properties the resource would use
+	@return : Returns true if Allocate can give such memory, false otherwise
+	*/
+	bool MemoryAllocator::IsMemoryTypeAvailable(uint32_t memoryTypeBits, VkMemoryPropertyFlags memoryProperties) const
+	{
+		return FindMemoryType(memoryTypeBits, memoryProperties) != UINT32_MAX;
+	}
+
+	/*
+	@brief : Gives the budget and the usage of the device local heaps, shared with the other processes and allocators
+	@param : The size the process can allocate in the device local heaps
+	@param : The size the process has allocated in the device local heaps
+	@return : Returns true if the sizes come from VK_EXT_memory_budget, false if they are estimated from the heap sizes and the usage of this allocator
+	*/
+	bool MemoryAllocator::GetMemoryBudget(VkDeviceSize& budget, VkDeviceSize& usage) const
+	{
+		budget = 0;
+		usage = 0;
+
+		const VkPhysicalDeviceMemoryProperties& memoryProperties = m_allocator->memoryProperties;
+
+		if (m_device->GetDevice()->memoryBudget)
+		{
+			VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties = {};
+			budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+			VkPhysicalDeviceMemoryProperties2 memoryProperties2 =
+			{
+				VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+				&budgetProperties
+			};
+
+			vkGetPhysicalDeviceMemoryProperties2(m_device->GetDevice()->physicalDevice, &memoryProperties2);
+
+			for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+			{
+				if ((memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0)
+				{
+					budget += budgetProperties.heapBudget[i];
+					usage += budgetProperties.heapUsage[i];
+				}
+			}
+
+			return true;
+		}
+
+		// Other processes use the heaps too, only a part of them is counted on
+		for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+		{
+			if ((memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0)
+				budget += memoryProperties.memoryHeaps[i].size / 10 * 8;
+		}
+
+		usage = m_allocator->allocatedSize;
+
+		return false;
+	}
+
+	/*
+	@brief : Assigns the allocator by move semantic
+	@param : The allocator to move
+	@return : A reference to this
+	*/
+	MemoryAllocator& MemoryAllocator::operator=(MemoryAllocator&& allocator) noexcept
+	{
+		std::swap(m_device, allocator.m_device);
+		std::swap(m_allocator, allocator.m_allocator);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	uint32_t MemoryAllocator::FindMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags memoryProperties) const
+	{
+		for (uint32_t i = 0; i < m_allocator->memoryProperties.memoryTypeCount; i++)
+		{
+			if ((memoryTypeBits & (1 << i)) && ((m_allocator->memoryProperties.memoryTypes[i].propertyFlags & memoryProperties) == memoryProperties))
+				return i;
+		}
+
+		return UINT32_MAX;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool MemoryAllocator::AllocateBlock(uint32_t memoryType, VkDeviceSize size, bool dedicated, uint32_t& block)
+	{
+		VkMemoryAllocateInfo memoryAllocateInfo =
+		{
+			VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+			nullptr,
+			size,
+			memoryType
+		};
+
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		if (vkAllocateMemory(m_device->GetDevice()->logicalDevice, &memoryAllocateInfo, nullptr, &memory) != VK_SUCCESS)
+			return false;
+
+		// The slots of the freed dedicated blocks are reused, the allocations keep their block index
+		auto it = std::find_if(m_allocator->blocks.begin(), m_allocator->blocks.end(), [](const MemoryBlock& memoryBlock)
+		{
+			return memoryBlock.memory == VK_NULL_HANDLE;
+		});
+
+		block = static_cast<uint32_t>(it - m_allocator->blocks.begin());
+
+		if (it == m_allocator->blocks.end())
+			m_allocator->blocks.emplace_back();
+
+		MemoryBlock& memoryBlock = m_allocator->blocks[block];
+
+		memoryBlock.memory = memory;
+		memoryBlock.size = size;
+		memoryBlock.memoryType = memoryType;
+		memoryBlock.dedicated = dedicated;
+		memoryBlock.ranges = RangeAllocator(size);
+
+		m_allocator->allocatedSize += size;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void MemoryAllocator::FreeBlock(uint32_t block)
+	{
+		MemoryBlock& memoryBlock = m_allocator->blocks[block];
+
+		if (memoryBlock.memory == VK_NULL_HANDLE)
+			return;
+
+		vkFreeMemory(m_device->GetDevice()->logicalDevice, memoryBlock.memory, nullptr);
+		m_allocator->allocatedSize -= memoryBlock.size;
+
+		memoryBlock = MemoryBlock();
+	}
+}
\ No newline at end of file
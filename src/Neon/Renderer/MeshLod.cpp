@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <Neon/Renderer/MeshLod.hpp>
+#include <Neon/Renderer/MeshOptimizer.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Builds the levels of detail of a mesh of a pool, they share the vertices of the mesh and only add indices to the pool
+	@param : The geometry pool holding the mesh
+	@param : The range of the mesh given by AddMesh
+	@param : The indices of the mesh, relative to its first vertex
+	@param : The positions of the vertices of the mesh, 3 floats each
+	@param : The distance in bytes between two positions
+	@param : The levels of detail, the first one is the mesh itself with an error of 0 and the errors never decrease
+	@param : The maximum number of levels of detail, the mesh included
+	@param : The part of the indices of a level of detail kept in the next one
+	@return : Returns true if the levels are built, false if the pool is out of indices
+	*/
+	bool BuildMeshLods(GeometryPool& geometryPool, const MeshRange& mesh, const std::vector<uint32_t>& indices, const float* positions, uint32_t positionStride,
+		std::vector<MeshLod>& lods, uint32_t maxLodCount, float reduction)
+	{
+		lods.clear();
+
+		MeshLod lod;
+		lod.mesh = mesh;
+		lods.push_back(lod);
+
+		std::vector<uint32_t> lodIndices;
+		std::size_t targetIndexCount = indices.size();
+
+		while (lods.size() < maxLodCount)
+		{
+			targetIndexCount = static_cast<std::size_t>(static_cast<float>(targetIndexCount) * reduction) / 3 * 3;
+
+			// Every level is simplified from the full mesh, its error is measured against the real surface
+			float error = SimplifyMesh(indices, positions, mesh.vertexCount, positionStride, targetIndexCount, FLT_MAX, lodIndices);
+
+			// The chain ends when the simplifier cannot remove a meaningful part of the previous level anymore
+			if (lodIndices.empty() || lodIndices.size() + lodIndices.size() / 8 >= lods.back().mesh.indexCount)
+				break;
+
+			OptimizeVertexCache(lodIndices, mesh.vertexCount);
+
+			lod.error = std::max(error, lods.back().error);
+
+			if (!geometryPool.AddLod(mesh, lodIndices, lod.mesh))
+				return false;
+
+			lods.push_back(lod);
+			targetIndexCount = lodIndices.size();
+		}
+
+		return true;
+	}
+
+	/*
+	@brief : Selects the coarsest level of detail whose error stays under a size in pixels once projected on the screen
+	@param : The levels of detail given by BuildMeshLods
+	@param : The center of the bounding sphere of the object, in world space
+	@param : The radius of the bounding sphere of the object
+	@param : The view projection matrix, column major
+	@param : The height of the viewport in pixels
+	@param : The largest error allowed on the screen, in pixels
+	@return : The index of the level of detail to draw
+	*/
+	uint32_t SelectMeshLod(const std::vector<MeshLod>& lods, const float* center, float radius, const float* viewProjection, float viewportHeight, float maxPixelError)
+	{
+		auto row = [viewProjection](uint32_t i, uint32_t j) { return viewProjection[j * 4 + i]; };
+
+		// The last row gives the view depth of a point with a perspective projection and stays (0, 0, 0, w) with an orthographic one
+		bool perspective = (row(3, 0) != 0.0f) || (row(3, 1) != 0.0f) || (row(3, 2) != 0.0f);
+		float depth = row(3, 0) * center[0] + row(3, 1) * center[1] + row(3, 2) * center[2] + row(3, 3);
+
+		// The closest point of the sphere has the largest projected error, a camera inside it gets the full mesh
+		if (perspective)
+			depth -= radius;
+
+		if (depth <= 0.0f)
+			return 0;
+
+		// The view only rotates the vertical axis, the length of the second row is the vertical scale of the projection
+		float projectionScale = std::sqrt(row(1, 0) * row(1, 0) + row(1, 1) * row(1, 1) + row(1, 2) * row(1, 2));
+		float pixelsPerUnit = projectionScale * viewportHeight * 0.5f / depth;
+
+		uint32_t lod = 0;
+
+		while ((lod + 1 < lods.size()) && (lods[lod + 1].error * pixelsPerUnit <= maxPixelError))
+			lod++;
+
+		return lod;
+	}
+}
\ No newline at end of file
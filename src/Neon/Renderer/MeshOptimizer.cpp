@@ -0,0 +1,830 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_set>
+
+#include <Neon/Renderer/MeshOptimizer.hpp>
+
+namespace Zx
+{
+	namespace
+	{
+		const uint32_t InvalidVertex = UINT32_MAX;
+
+		const uint32_t OverdrawGridSize = 256;
+		const uint32_t FetchCacheLineSize = 64;
+		const uint32_t FetchCacheLineCount = 64;
+
+		// Triangles using each vertex, the triangles of vertex v are triangles[offsets[v]] to triangles[offsets[v] + counts[v] - 1]
+		struct Adjacency
+		{
+			std::vector<uint32_t> offsets;
+			std::vector<uint32_t> counts;
+			std::vector<uint32_t> triangles;
+		};
+
+		void BuildAdjacency(const std::vector<uint32_t>& indices, std::size_t triangleCount, uint32_t vertexCount, Adjacency& adjacency)
+		{
+			adjacency.offsets.assign(vertexCount, 0);
+			adjacency.counts.assign(vertexCount, 0);
+			adjacency.triangles.resize(triangleCount * 3);
+
+			for (std::size_t i = 0; i < triangleCount * 3; i++)
+				adjacency.counts[indices[i]]++;
+
+			uint32_t offset = 0;
+
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				adjacency.offsets[i] = offset;
+				offset += adjacency.counts[i];
+			}
+
+			std::vector<uint32_t> cursors(adjacency.offsets);
+
+			for (std::size_t i = 0; i < triangleCount * 3; i++)
+				adjacency.triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+
+		// FIFO post transform cache, a vertex stays cached until cacheSize other vertices are loaded after it
+		uint32_t SimulateCache(const uint32_t* indices, std::size_t count, uint32_t cacheSize, std::vector<uint32_t>& timestamps, uint32_t& time)
+		{
+			uint32_t misses = 0;
+
+			for (std::size_t i = 0; i < count; i++)
+			{
+				if (time - timestamps[indices[i]] > cacheSize)
+				{
+					timestamps[indices[i]] = time++;
+					misses++;
+				}
+			}
+
+			return misses;
+		}
+
+		inline const float* GetPosition(const float* positions, uint32_t positionStride, uint32_t vertex)
+		{
+			return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + static_cast<std::size_t>(vertex) * positionStride);
+		}
+
+		// Sum of squared distances to weighted planes, p^T A p + 2 b.p + c with A symmetric
+		struct Quadric
+		{
+			float a00, a11, a22, a01, a02, a12;
+			float b0, b1, b2;
+			float c;
+			float weight;
+		};
+
+		Quadric MakeQuadric(const float* normal, float distance, float weight)
+		{
+			Quadric quadric;
+
+			quadric.a00 = weight * normal[0] * normal[0];
+			quadric.a11 = weight * normal[1] * normal[1];
+			quadric.a22 = weight * normal[2] * normal[2];
+			quadric.a01 = weight * normal[0] * normal[1];
+			quadric.a02 = weight * normal[0] * normal[2];
+			quadric.a12 = weight * normal[1] * normal[2];
+			quadric.b0 = weight * normal[0] * distance;
+			quadric.b1 = weight * normal[1] * distance;
+			quadric.b2 = weight * normal[2] * distance;
+			quadric.c = weight * distance * distance;
+			quadric.weight = weight;
+
+			return quadric;
+		}
+
+		void AddQuadric(Quadric& quadric, const Quadric& other)
+		{
+			quadric.a00 += other.a00;
+			quadric.a11 += other.a11;
+			quadric.a22 += other.a22;
+			quadric.a01 += other.a01;
+			quadric.a02 += other.a02;
+			quadric.a12 += other.a12;
+			quadric.b0 += other.b0;
+			quadric.b1 += other.b1;
+			quadric.b2 += other.b2;
+			quadric.c += other.c;
+			quadric.weight += other.weight;
+		}
+
+		// Mean squared distance of a point to the planes of the quadric
+		float EvaluateQuadric(const Quadric& quadric, const float* point)
+		{
+			float x = point[0];
+			float y = point[1];
+			float z = point[2];
+
+			float error = quadric.a00 * x * x + quadric.a11 * y * y + quadric.a22 * z * z
+				+ 2.0f * (quadric.a01 * x * y + quadric.a02 * x * z + quadric.a12 * y * z)
+				+ 2.0f * (quadric.b0 * x + quadric.b1 * y + quadric.b2 * z) + quadric.c;
+
+			return (quadric.weight > 0.0f) ? std::max(error / quadric.weight, 0.0f) : 0.0f;
+		}
+
+		inline void TriangleNormal(const float* a, const float* b, const float* c, float* normal)
+		{
+			float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+			float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+
+			normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+			normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+			normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+		}
+
+		// Moving a vertex on another one must not turn any of the remaining triangles around it over
+		bool CollapseFlips(const std::vector<uint32_t>& indices, const Adjacency& adjacency, const float* positions, uint32_t positionStride, uint32_t from, uint32_t to)
+		{
+			const float* target = GetPosition(positions, positionStride, to);
+
+			for (uint32_t i = 0; i < adjacency.counts[from]; i++)
+			{
+				const uint32_t* triangle = &indices[adjacency.triangles[adjacency.offsets[from] + i] * 3];
+
+				if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+					continue;
+
+				const float* before[3];
+				const float* after[3];
+
+				for (uint32_t j = 0; j < 3; j++)
+				{
+					before[j] = GetPosition(positions, positionStride, triangle[j]);
+					after[j] = (triangle[j] == from) ? target : before[j];
+				}
+
+				float normalBefore[3];
+				float normalAfter[3];
+
+				TriangleNormal(before[0], before[1], before[2], normalBefore);
+				TriangleNormal(after[0], after[1], after[2], normalAfter);
+
+				if (normalBefore[0] * normalAfter[0] + normalBefore[1] * normalAfter[1] + normalBefore[2] * normalAfter[2] <= 0.0f)
+					return true;
+			}
+
+			return false;
+		}
+
+		inline float EdgeFunction(float ax, float ay, float bx, float by, float px, float py)
+		{
+			return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+		}
+
+		// Rasterizes a triangle in a depth buffer with a less test and returns the number of pixels passing it
+		uint32_t RasterizeTriangle(std::vector<float>& depth, const float (&triangle)[3][3])
+		{
+			const float (&a)[3] = triangle[0];
+			const float (&b)[3] = triangle[1];
+			const float (&c)[3] = triangle[2];
+
+			float area = EdgeFunction(a[0], a[1], b[0], b[1], c[0], c[1]);
+
+			// Back faces are culled, the view from the opposite direction rasterizes them
+			if (area <= 0.0f)
+				return 0;
+
+			int32_t maxCoordinate = static_cast<int32_t>(OverdrawGridSize) - 1;
+
+			int32_t minX = std::max(static_cast<int32_t>(std::floor(std::min({ a[0], b[0], c[0] }))), 0);
+			int32_t minY = std::max(static_cast<int32_t>(std::floor(std::min({ a[1], b[1], c[1] }))), 0);
+			int32_t maxX = std::min(static_cast<int32_t>(std::ceil(std::max({ a[0], b[0], c[0] }))), maxCoordinate);
+			int32_t maxY = std::min(static_cast<int32_t>(std::ceil(std::max({ a[1], b[1], c[1] }))), maxCoordinate);
+
+			uint32_t shaded = 0;
+
+			for (int32_t y = minY; y <= maxY; y++)
+			{
+				for (int32_t x = minX; x <= maxX; x++)
+				{
+					float px = static_cast<float>(x) + 0.5f;
+					float py = static_cast<float>(y) + 0.5f;
+
+					float wa = EdgeFunction(b[0], b[1], c[0], c[1], px, py);
+					float wb = EdgeFunction(c[0], c[1], a[0], a[1], px, py);
+					float wc = EdgeFunction(a[0], a[1], b[0], b[1], px, py);
+
+					if (wa < 0.0f || wb < 0.0f || wc < 0.0f)
+						continue;
+
+					float z = (wa * a[2] + wb * b[2] + wc * c[2]) / area;
+					float& stored = depth[static_cast<std::size_t>(y) * OverdrawGridSize + x];
+
+					if (z < stored)
+					{
+						stored = z;
+						shaded++;
+					}
+				}
+			}
+
+			return shaded;
+		}
+
+		float MeasureOverdraw(const float* positions, uint32_t vertexCount, uint32_t positionStride, const std::vector<uint32_t>& indices, std::size_t triangleCount)
+		{
+			float boundsMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+			float boundsMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				const float* position = GetPosition(positions, positionStride, i);
+
+				for (uint32_t j = 0; j < 3; j++)
+				{
+					boundsMin[j] = std::min(boundsMin[j], position[j]);
+					boundsMax[j] = std::max(boundsMax[j], position[j]);
+				}
+			}
+
+			float extent = std::max({ boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2] });
+			float scale = (extent > 0.0f) ? 1.0f / extent : 0.0f;
+
+			std::vector<float> depth(OverdrawGridSize * OverdrawGridSize);
+
+			uint64_t shaded = 0;
+			uint64_t covered = 0;
+
+			// Orthographic views of the mesh along the 6 axis directions, the first one of each axis looks from its positive side
+			for (uint32_t axis = 0; axis < 3; axis++)
+			{
+				for (uint32_t direction = 0; direction < 2; direction++)
+				{
+					std::fill(depth.begin(), depth.end(), FLT_MAX);
+
+					for (std::size_t i = 0; i < triangleCount; i++)
+					{
+						float triangle[3][3];
+
+						for (uint32_t j = 0; j < 3; j++)
+						{
+							const float* position = GetPosition(positions, positionStride, indices[i * 3 + j]);
+
+							float x = (position[(axis + 1) % 3] - boundsMin[(axis + 1) % 3]) * scale;
+							float y = (position[(axis + 2) % 3] - boundsMin[(axis + 2) % 3]) * scale;
+							float z = 1.0f - (position[axis] - boundsMin[axis]) * scale;
+
+							// Looking from the other side mirrors the image, which keeps the winding of the triangles facing the viewer
+							if (direction == 1)
+							{
+								x = 1.0f - x;
+								z = 1.0f - z;
+							}
+
+							triangle[j][0] = x * static_cast<float>(OverdrawGridSize);
+							triangle[j][1] = y * static_cast<float>(OverdrawGridSize);
+							triangle[j][2] = z;
+						}
+
+						shaded += RasterizeTriangle(depth, triangle);
+					}
+
+					covered += std::count_if(depth.begin(), depth.end(), [](float value)
+					{
+						return value != FLT_MAX;
+					});
+				}
+			}
+
+			return (covered > 0) ? static_cast<float>(shaded) / static_cast<float>(covered) : 0.0f;
+		}
+	}
+
+	/*
+	@brief : Reorders the triangles of a triangle list for the post transform vertex cache, with the Tipsify algorithm
+	@param : The indices of the triangle list
+	@param : The number of vertices referenced by the indices
+	@param : The number of vertices the cache is assumed to hold
+	*/
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize)
+	{
+		std::size_t triangleCount = indices.size() / 3;
+
+		if (triangleCount == 0 || vertexCount == 0)
+			return;
+
+		Adjacency adjacency;
+		BuildAdjacency(indices, triangleCount, vertexCount, adjacency);
+
+		std::vector<uint32_t> liveTriangles(adjacency.counts);
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		std::vector<bool> emitted(triangleCount, false);
+
+		std::vector<uint32_t> deadEnds;
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> result;
+
+		deadEnds.reserve(triangleCount * 3);
+		result.reserve(triangleCount * 3);
+
+		uint32_t time = cacheSize + 1;
+		uint32_t cursor = 0;
+		uint32_t fanning = 0;
+
+		while (fanning < vertexCount && liveTriangles[fanning] == 0)
+			fanning++;
+
+		while (fanning < vertexCount)
+		{
+			candidates.clear();
+
+			// Emits the whole fan of triangles around the vertex
+			for (uint32_t i = 0; i < adjacency.counts[fanning]; i++)
+			{
+				uint32_t triangle = adjacency.triangles[adjacency.offsets[fanning] + i];
+
+				if (emitted[triangle])
+					continue;
+
+				for (uint32_t j = 0; j < 3; j++)
+				{
+					uint32_t vertex = indices[triangle * 3 + j];
+
+					result.push_back(vertex);
+					deadEnds.push_back(vertex);
+					candidates.push_back(vertex);
+
+					liveTriangles[vertex]--;
+
+					if (time - timestamps[vertex] > cacheSize)
+						timestamps[vertex] = time++;
+				}
+
+				emitted[triangle] = true;
+			}
+
+			// The next fan is the oldest vertex of the last one that is still cached after its own fan is emitted
+			uint32_t next = InvalidVertex;
+			int64_t nextPriority = -1;
+
+			for (uint32_t vertex : candidates)
+			{
+				if (liveTriangles[vertex] == 0)
+					continue;
+
+				int64_t priority = 0;
+
+				if (time - timestamps[vertex] + 2 * liveTriangles[vertex] <= cacheSize)
+					priority = time - timestamps[vertex];
+
+				if (priority > nextPriority)
+				{
+					next = vertex;
+					nextPriority = priority;
+				}
+			}
+
+			// Dead end, the most recent vertex with triangles left, else the next one in the index order
+			while (next == InvalidVertex && !deadEnds.empty())
+			{
+				uint32_t vertex = deadEnds.back();
+				deadEnds.pop_back();
+
+				if (liveTriangles[vertex] > 0)
+					next = vertex;
+			}
+
+			for (; next == InvalidVertex && cursor < vertexCount; cursor++)
+			{
+				if (liveTriangles[cursor] > 0)
+					next = cursor;
+			}
+
+			fanning = next;
+		}
+
+		indices.swap(result);
+	}
+
+	/*
+	@brief : Reorders clusters of a cache optimized triangle list so the triangles likely to occlude the others are drawn first
+	@param : The indices of the triangle list, ordered by OptimizeVertexCache
+	@param : The positions of the vertices, 3 floats each
+	@param : The number of vertices
+	@param : The distance in bytes between two positions
+	@param : The number of vertices the cache is assumed to hold
+	@param : The ACMR a cluster can lose over its unsplit cluster, 1.05 allows 5%
+	*/
+	void OptimizeOverdraw(std::vector<uint32_t>& indices, const float* positions, uint32_t vertexCount, uint32_t positionStride, uint32_t cacheSize, float threshold)
+	{
+		std::size_t triangleCount = indices.size() / 3;
+
+		if (triangleCount == 0 || vertexCount == 0 || positions == nullptr)
+			return;
+
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		uint32_t time = cacheSize + 1;
+
+		// Triangles missing the cache on their 3 vertices start a new cluster, the order before them does not matter
+		std::vector<uint32_t> hardClusters;
+
+		for (std::size_t i = 0; i < triangleCount; i++)
+		{
+			if (SimulateCache(&indices[i * 3], 3, cacheSize, timestamps, time) == 3 || i == 0)
+				hardClusters.push_back(static_cast<uint32_t>(i));
+		}
+
+		// The clusters are split further as soon as their beginning is almost as cache efficient as the whole cluster
+		std::vector<uint32_t> clusters;
+
+		for (std::size_t i = 0; i < hardClusters.size(); i++)
+		{
+			uint32_t begin = hardClusters[i];
+			uint32_t end = (i + 1 < hardClusters.size()) ? hardClusters[i + 1] : static_cast<uint32_t>(triangleCount);
+
+			time += cacheSize + 1;
+			float clusterAcmr = static_cast<float>(SimulateCache(&indices[begin * 3], (end - begin) * 3, cacheSize, timestamps, time)) / (end - begin);
+
+			uint32_t start = begin;
+			uint32_t misses = 0;
+
+			time += cacheSize + 1;
+			clusters.push_back(begin);
+
+			for (uint32_t triangle = begin; triangle + 1 < end; triangle++)
+			{
+				misses += SimulateCache(&indices[triangle * 3], 3, cacheSize, timestamps, time);
+
+				if (static_cast<float>(misses) / (triangle + 1 - start) <= clusterAcmr * threshold)
+				{
+					start = triangle + 1;
+					misses = 0;
+
+					time += cacheSize + 1;
+					clusters.push_back(start);
+				}
+			}
+		}
+
+		// Area weighted centroid and normal of each cluster
+		std::vector<float> clusterCentroids(clusters.size() * 3, 0.0f);
+		std::vector<float> clusterNormals(clusters.size() * 3, 0.0f);
+		std::vector<float> clusterAreas(clusters.size(), 0.0f);
+
+		float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+		float meshArea = 0.0f;
+
+		for (std::size_t i = 0; i < clusters.size(); i++)
+		{
+			uint32_t end = (i + 1 < clusters.size()) ? clusters[i + 1] : static_cast<uint32_t>(triangleCount);
+
+			for (uint32_t triangle = clusters[i]; triangle < end; triangle++)
+			{
+				const float* a = GetPosition(positions, positionStride, indices[triangle * 3]);
+				const float* b = GetPosition(positions, positionStride, indices[triangle * 3 + 1]);
+				const float* c = GetPosition(positions, positionStride, indices[triangle * 3 + 2]);
+
+				float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+				float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+				float normal[3] = { ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0] };
+
+				float area = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+				for (uint32_t j = 0; j < 3; j++)
+				{
+					float centroid = (a[j] + b[j] + c[j]) / 3.0f;
+
+					clusterCentroids[i * 3 + j] += centroid * area;
+					clusterNormals[i * 3 + j] += normal[j];
+					meshCentroid[j] += centroid * area;
+				}
+
+				clusterAreas[i] += area;
+				meshArea += area;
+			}
+		}
+
+		for (uint32_t j = 0; j < 3; j++)
+			meshCentroid[j] /= std::max(meshArea, FLT_MIN);
+
+		// Clusters far from the center and facing away from it hide the rest of the mesh from most points of view
+		std::vector<float> sortKeys(clusters.size());
+
+		for (std::size_t i = 0; i < clusters.size(); i++)
+		{
+			const float* normal = &clusterNormals[i * 3];
+			float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+			float key = 0.0f;
+
+			for (uint32_t j = 0; j < 3; j++)
+				key += (clusterCentroids[i * 3 + j] / std::max(clusterAreas[i], FLT_MIN) - meshCentroid[j]) * normal[j];
+
+			sortKeys[i] = key / std::max(normalLength, FLT_MIN);
+		}
+
+		std::vector<uint32_t> order(clusters.size());
+		std::iota(order.begin(), order.end(), 0);
+
+		std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t left, uint32_t right)
+		{
+			return sortKeys[left] > sortKeys[right];
+		});
+
+		std::vector<uint32_t> result;
+		result.reserve(triangleCount * 3);
+
+		for (uint32_t cluster : order)
+		{
+			uint32_t end = (cluster + 1 < clusters.size()) ? clusters[cluster + 1] : static_cast<uint32_t>(triangleCount);
+			result.insert(result.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + end * 3);
+		}
+
+		indices.swap(result);
+	}
+
+	/*
+	@brief : Reorders the vertices in the order of their first use by the indices and drops the unused ones
+	@param : The vertices, reordered in place
+	@param : The number of vertices
+	@param : The size of a vertex in bytes
+	@param : The indices, remapped to the new order
+	@return : The number of vertices left
+	*/
+	uint32_t OptimizeVertexFetch(void* vertices, uint32_t vertexCount, uint32_t stride, std::vector<uint32_t>& indices)
+	{
+		std::vector<uint32_t> remap(vertexCount, InvalidVertex);
+		std::vector<char> reordered(static_cast<std::size_t>(vertexCount) * stride);
+
+		char* data = static_cast<char*>(vertices);
+		uint32_t next = 0;
+
+		for (uint32_t& index : indices)
+		{
+			if (remap[index] == InvalidVertex)
+			{
+				std::memcpy(&reordered[static_cast<std::size_t>(next) * stride], data + static_cast<std::size_t>(index) * stride, stride);
+				remap[index] = next++;
+			}
+
+			index = remap[index];
+		}
+
+		std::memcpy(data, reordered.data(), static_cast<std::size_t>(next) * stride);
+
+		return next;
+	}
+
+	/*
+	@brief : Simplifies a triangle list by collapsing edges onto one of their vertices, the result uses the same vertices
+	@param : The indices of the triangle list
+	@param : The positions of the vertices, 3 floats each
+	@param : The number of vertices
+	@param : The distance in bytes between two positions
+	@param : The number of indices to reach
+	@param : The largest distance to the original surface allowed, in the units of the positions
+	@param : The indices of the simplified triangle list
+	@return : The distance to the original surface of the simplified list, 0 if nothing is collapsed
+	*/
+	float SimplifyMesh(const std::vector<uint32_t>& indices, const float* positions, uint32_t vertexCount, uint32_t positionStride, std::size_t targetIndexCount,
+		float targetError, std::vector<uint32_t>& result)
+	{
+		std::size_t triangleCount = indices.size() / 3;
+
+		result.assign(indices.begin(), indices.begin() + triangleCount * 3);
+
+		if (triangleCount == 0 || vertexCount == 0 || positions == nullptr)
+			return 0.0f;
+
+		std::vector<Quadric> quadrics(vertexCount, Quadric());
+		std::unordered_set<uint64_t> edges;
+
+		// Quadrics of the planes of the triangles around each vertex, weighted by area
+		for (std::size_t i = 0; i < triangleCount; i++)
+		{
+			const uint32_t* triangle = &result[i * 3];
+
+			const float* a = GetPosition(positions, positionStride, triangle[0]);
+			const float* b = GetPosition(positions, positionStride, triangle[1]);
+			const float* c = GetPosition(positions, positionStride, triangle[2]);
+
+			float normal[3];
+			TriangleNormal(a, b, c, normal);
+
+			float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+			for (uint32_t j = 0; j < 3; j++)
+				edges.insert((static_cast<uint64_t>(triangle[j]) << 32) | triangle[(j + 1) % 3]);
+
+			if (length <= 0.0f)
+				continue;
+
+			normal[0] /= length;
+			normal[1] /= length;
+			normal[2] /= length;
+
+			Quadric quadric = MakeQuadric(normal, -(normal[0] * a[0] + normal[1] * a[1] + normal[2] * a[2]), length * 0.5f);
+
+			for (uint32_t j = 0; j < 3; j++)
+				AddQuadric(quadrics[triangle[j]], quadric);
+		}
+
+		// Vertices on the border of an open mesh keep the silhouette of the border, they are never moved
+		std::vector<bool> locked(vertexCount, false);
+
+		for (uint64_t edge : edges)
+		{
+			uint32_t from = static_cast<uint32_t>(edge >> 32);
+			uint32_t to = static_cast<uint32_t>(edge & UINT32_MAX);
+
+			if (edges.find((static_cast<uint64_t>(to) << 32) | from) == edges.end())
+				locked[from] = locked[to] = true;
+		}
+
+		struct Collapse
+		{
+			uint32_t from;
+			uint32_t to;
+			float error;
+		};
+
+		float errorLimit = targetError * targetError;
+		float maxError = 0.0f;
+
+		Adjacency adjacency;
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> remap(vertexCount);
+		std::vector<bool> touched(vertexCount);
+
+		while (result.size() > targetIndexCount)
+		{
+			std::size_t currentTriangleCount = result.size() / 3;
+
+			collapses.clear();
+
+			// Every edge once, in the direction moving the vertex the least far from the planes of both vertices
+			for (std::size_t i = 0; i < currentTriangleCount * 3; i++)
+			{
+				uint32_t a = result[i];
+				uint32_t b = result[(i % 3 == 2) ? i - 2 : i + 1];
+
+				if (a > b || (locked[a] && locked[b]))
+					continue;
+
+				Quadric quadric = quadrics[a];
+				AddQuadric(quadric, quadrics[b]);
+
+				float errorAB = locked[a] ? FLT_MAX : EvaluateQuadric(quadric, GetPosition(positions, positionStride, b));
+				float errorBA = locked[b] ? FLT_MAX : EvaluateQuadric(quadric, GetPosition(positions, positionStride, a));
+
+				if (errorAB <= errorBA)
+					collapses.push_back({ a, b, errorAB });
+				else
+					collapses.push_back({ b, a, errorBA });
+			}
+
+			if (collapses.empty())
+				break;
+
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& left, const Collapse& right)
+			{
+				return left.error < right.error;
+			});
+
+			BuildAdjacency(result, currentTriangleCount, vertexCount, adjacency);
+
+			std::iota(remap.begin(), remap.end(), 0);
+			std::fill(touched.begin(), touched.end(), false);
+
+			// The cheapest collapses of the pass, a collapse never changes a triangle another one of the same pass already changed
+			std::size_t collapseGoal = (result.size() - targetIndexCount) / 6 + 1;
+			std::size_t collapseCount = 0;
+
+			for (const Collapse& collapse : collapses)
+			{
+				if (collapse.error > errorLimit || collapseCount >= collapseGoal)
+					break;
+
+				if (touched[collapse.from] || touched[collapse.to] || CollapseFlips(result, adjacency, positions, positionStride, collapse.from, collapse.to))
+					continue;
+
+				for (uint32_t i = 0; i < adjacency.counts[collapse.from]; i++)
+				{
+					const uint32_t* triangle = &result[adjacency.triangles[adjacency.offsets[collapse.from] + i] * 3];
+
+					touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = true;
+				}
+
+				remap[collapse.from] = collapse.to;
+				AddQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+
+				maxError = std::max(maxError, collapse.error);
+				collapseCount++;
+			}
+
+			if (collapseCount == 0)
+				break;
+
+			// The triangles around the collapsed edges are degenerate and dropped
+			std::size_t write = 0;
+
+			for (std::size_t i = 0; i < currentTriangleCount; i++)
+			{
+				uint32_t a = remap[result[i * 3]];
+				uint32_t b = remap[result[i * 3 + 1]];
+				uint32_t c = remap[result[i * 3 + 2]];
+
+				if (a == b || b == c || c == a)
+					continue;
+
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+
+			result.resize(write);
+		}
+
+		return std::sqrt(maxError);
+	}
+
+	/*
+	@brief : Optimizes a mesh for the vertex cache, then for overdraw, then for the vertex fetch
+	@param : The vertices, starting with a 3 floats position
+	@param : The number of vertices
+	@param : The size of a vertex in bytes
+	@param : The indices of the triangle list
+	@param : The number of vertices the cache is assumed to hold
+	@param : The ACMR the overdraw optimization can lose, 1.05 allows 5%
+	@return : The number of vertices left, the unused ones are dropped
+	*/
+	uint32_t OptimizeMesh(void* vertices, uint32_t vertexCount, uint32_t stride, std::vector<uint32_t>& indices, uint32_t cacheSize, float threshold)
+	{
+		OptimizeVertexCache(indices, vertexCount, cacheSize);
+		OptimizeOverdraw(indices, static_cast<const float*>(vertices), vertexCount, stride, cacheSize, threshold);
+
+		return OptimizeVertexFetch(vertices, vertexCount, stride, indices);
+	}
+
+	/*
+	@brief : Measures the vertex cache efficiency, the vertex fetch efficiency and the overdraw of a mesh
+	@param : The vertices, starting with a 3 floats position
+	@param : The number of vertices
+	@param : The size of a vertex in bytes
+	@param : The indices of the triangle list
+	@param : The number of vertices the cache is assumed to hold
+	@return : The measurements
+	*/
+	MeshStatistics AnalyzeMesh(const void* vertices, uint32_t vertexCount, uint32_t stride, const std::vector<uint32_t>& indices, uint32_t cacheSize)
+	{
+		MeshStatistics statistics;
+
+		std::size_t triangleCount = indices.size() / 3;
+
+		if (triangleCount == 0 || vertexCount == 0)
+			return statistics;
+
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		std::vector<bool> referenced(vertexCount, false);
+
+		// Vertices are fetched on post transform cache misses, through a FIFO cache of lines
+		std::vector<uint32_t> lineTimestamps((static_cast<std::size_t>(vertexCount) * stride) / FetchCacheLineSize + 2, 0);
+
+		uint32_t time = cacheSize + 1;
+		uint32_t lineTime = FetchCacheLineCount + 1;
+
+		uint32_t misses = 0;
+		uint32_t lineMisses = 0;
+		uint32_t referencedCount = 0;
+
+		for (std::size_t i = 0; i < triangleCount * 3; i++)
+		{
+			uint32_t vertex = indices[i];
+
+			if (!referenced[vertex])
+			{
+				referenced[vertex] = true;
+				referencedCount++;
+			}
+
+			if (SimulateCache(&indices[i], 1, cacheSize, timestamps, time) == 0)
+				continue;
+
+			misses++;
+
+			std::size_t firstLine = (static_cast<std::size_t>(vertex) * stride) / FetchCacheLineSize;
+			std::size_t lastLine = (static_cast<std::size_t>(vertex) * stride + stride - 1) / FetchCacheLineSize;
+
+			for (std::size_t line = firstLine; line <= lastLine; line++)
+			{
+				if (lineTime - lineTimestamps[line] > FetchCacheLineCount)
+				{
+					lineTimestamps[line] = lineTime++;
+					lineMisses++;
+				}
+			}
+		}
+
+		statistics.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount);
+		statistics.atvr = static_cast<float>(misses) / static_cast<float>(referencedCount);
+		statistics.overfetch = static_cast<float>(static_cast<uint64_t>(lineMisses) * FetchCacheLineSize) / static_cast<float>(static_cast<uint64_t>(referencedCount) * stride);
+		statistics.overdraw = MeasureOverdraw(static_cast<const float*>(vertices), vertexCount, stride, indices, triangleCount);
+
+		return statistics;
+	}
+}
\ No newline at end of file
@@ -16,13 +16,14 @@ namespace Zx
 	@param : The device of the application
 	@param : The renderPass of the application
 	@param : The swapChain of the application
+	@param : The description of the pipeline
 	*/
-	Pipeline::Pipeline(Device& device, RenderPass& renderPass, SwapChain& swapChain)
+	Pipeline::Pipeline(Device& device, RenderPass& renderPass, SwapChain& swapChain, const PipelineInfo& info) : m_info(info)
 	{
 		m_device = std::make_shared<Device>(device);
 		m_renderPass = std::make_shared<RenderPass>(renderPass);
 		m_swapChain = std::make_shared<SwapChain>(swapChain);
-		m_pipeline = VK_NULL_HANDLE;
+		m_pipeline = std::make_shared<Pipelines>();
 
 		if (!CreatePipeline())
 			std::cout << "Failed to create pipeline" << std::endl;
@@ -33,20 +34,40 @@ namespace Zx
 	}
 
 	/*
-	@brief : Copy constructor
+	@brief : Copy constructor, the copy shares the pipelines
 	@param : A constant reference to Pipeline to copy
 	*/
-	Pipeline::Pipeline(const Pipeline& pipeline) : m_pipeline(pipeline.m_pipeline), m_device(pipeline.m_device), m_renderPass(pipeline.m_renderPass)
-		, m_swapChain(pipeline.m_swapChain)
+	Pipeline::Pipeline(const Pipeline& pipeline) : m_swapChain(pipeline.m_swapChain), m_device(pipeline.m_device), m_renderPass(pipeline.m_renderPass)
+		, m_pipeline(pipeline.m_pipeline), m_info(pipeline.m_info)
 	{}
 
 	/*
-	@brief : Destroys a pipeline
+	@brief : Destroys the pipelines and their layout with the last owner of the pipeline
 	*/
 	Pipeline::~Pipeline()
 	{
-		vkDestroyPipeline(m_device->GetDevice()->logicalDevice, m_pipeline, nullptr);
-		m_pipeline = VK_NULL_HANDLE;
+		if ((m_pipeline == nullptr) || (m_pipeline.use_count() > 1))
+			return;
+
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		if (m_pipeline->pipeline != VK_NULL_HANDLE)
+		{
+			vkDestroyPipeline(logicalDevice, m_pipeline->pipeline, nullptr);
+			m_pipeline->pipeline = VK_NULL_HANDLE;
+		}
+
+		if (m_pipeline->depthPipeline != VK_NULL_HANDLE)
+		{
+			vkDestroyPipeline(logicalDevice, m_pipeline->depthPipeline, nullptr);
+			m_pipeline->depthPipeline = VK_NULL_HANDLE;
+		}
+
+		if (m_pipeline->pipelineLayout != VK_NULL_HANDLE)
+		{
+			vkDestroyPipelineLayout(logicalDevice, m_pipeline->pipelineLayout, nullptr);
+			m_pipeline->pipelineLayout = VK_NULL_HANDLE;
+		}
 	}
 
 	/*
@@ -58,6 +79,7 @@ namespace Zx
 	{
 		std::swap(m_device, pipeline.m_device);
 		std::swap(m_pipeline, pipeline.m_pipeline);
+		std::swap(m_info, pipeline.m_info);
 		std::swap(m_renderPass, pipeline.m_renderPass);
 		std::swap(m_swapChain, pipeline.m_swapChain);
 
@@ -67,9 +89,8 @@ namespace Zx
 	//-------------------------Private method-------------------------
 	bool Pipeline::CreatePipeline()
 	{
-		//Chemin absolu pour RenderDoc
-		SmartDeleter<VkShaderModule, PFN_vkDestroyShaderModule> vertex = CreateShaderModule("C:/Users/Lucas/Documents/Neon/shaders/vert.spv", *m_device);
-		SmartDeleter<VkShaderModule, PFN_vkDestroyShaderModule> frag = CreateShaderModule("C:/Users/Lucas/Documents/Neon/shaders/frag.spv", *m_device);
+		SmartDeleter<VkShaderModule, PFN_vkDestroyShaderModule> vertex = CreateShaderModule(m_info.vertexShader, *m_device);
+		SmartDeleter<VkShaderModule, PFN_vkDestroyShaderModule> frag = CreateShaderModule(m_info.fragmentShader, *m_device);
 
 		if (!vertex || !frag)
 			return false;
@@ -96,40 +117,15 @@ namespace Zx
 			}
 		};
 
-		std::vector<VkVertexInputBindingDescription> inputBindingDescription =
-		{
-			{
-				0,
-				sizeof(VertexData),
-				VK_VERTEX_INPUT_RATE_VERTEX
-			}
-		};
-
-		std::vector<VkVertexInputAttributeDescription> inputAttributeDescription =
-		{
-			{
-				0,
-				inputBindingDescription.data()->binding,
-				VK_FORMAT_R32G32B32A32_SFLOAT,
-				offsetof(struct VertexData, x)
-			},
-			{
-				1,
-				inputBindingDescription.data()->binding,
-				VK_FORMAT_R32G32B32A32_SFLOAT,
-				offsetof(struct VertexData, r)
-			}
-		};
-
 		VkPipelineVertexInputStateCreateInfo pipelineVertexInfo =
 		{
 			VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
 			nullptr,
 			0,
-			static_cast<uint32_t>(inputBindingDescription.size()),
-			inputBindingDescription.data(),
-			static_cast<uint32_t>(inputAttributeDescription.size()),
-			inputAttributeDescription.data()
+			static_cast<uint32_t>(m_info.vertexBindings.size()),
+			m_info.vertexBindings.data(),
+			static_cast<uint32_t>(m_info.vertexAttributes.size()),
+			m_info.vertexAttributes.data()
 		};
 
 		VkPipelineInputAssemblyStateCreateInfo pipelineInputAssembly =
@@ -137,7 +133,7 @@ namespace Zx
 			VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
 			nullptr,
 			0,
-			VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+			m_info.topology,
 			VK_FALSE
 		};
 
@@ -160,7 +156,7 @@ namespace Zx
 			VK_FALSE,
 			VK_FALSE,
 			VK_POLYGON_MODE_FILL,
-			VK_CULL_MODE_BACK_BIT,
+			m_info.lighting ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT,
 			VK_FRONT_FACE_COUNTER_CLOCKWISE,
 			VK_FALSE,
 			0.0f,
@@ -174,7 +170,7 @@ namespace Zx
 			VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
 			nullptr,
 			0,
-			VK_SAMPLE_COUNT_1_BIT,
+			m_renderPass->GetSampleCount(),
 			VK_FALSE,
 			1.0f,
 			nullptr,
@@ -182,7 +178,26 @@ namespace Zx
 			VK_FALSE
 		};
 
-		VkPipelineColorBlendAttachmentState pipelineColorBendAttachmentState =
+		bool depthPrePass = m_renderPass->HasDepthPrePass() && !m_info.lighting;
+
+		// The depth written by the pre-pass is final, the color subpass only shades the fragments matching it
+		VkPipelineDepthStencilStateCreateInfo pipelineDepthStencilInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			m_info.depthTest ? VK_TRUE : VK_FALSE,
+			(m_info.depthWrite && !depthPrePass) ? VK_TRUE : VK_FALSE,
+			(m_info.depthTest && depthPrePass) ? VK_COMPARE_OP_EQUAL : m_info.depthCompareOp,
+			VK_FALSE,
+			VK_FALSE,
+			{},
+			{},
+			0.0f,
+			1.0f
+		};
+
+		std::vector<VkPipelineColorBlendAttachmentState> pipelineColorBendAttachmentState(m_info.lighting ? 1 : m_renderPass->GetGeometryColorCount(),
 		{
 			VK_FALSE,
 			VK_BLEND_FACTOR_ONE,
@@ -192,7 +207,7 @@ namespace Zx
 			VK_BLEND_FACTOR_ZERO,
 			VK_BLEND_OP_ADD,
 			VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT
-		};
+		});
 
 		VkPipelineColorBlendStateCreateInfo pipelineColorBlendStateCreateInfo =
 		{
@@ -201,8 +216,8 @@ namespace Zx
 			0,
 			VK_FALSE,
 			VK_LOGIC_OP_COPY,
-			1,
-			&pipelineColorBendAttachmentState,
+			static_cast<uint32_t>(pipelineColorBendAttachmentState.size()),
+			pipelineColorBendAttachmentState.data(),
 			{ 0.0f, 0.0f, 0.0f, 0.0f }
 		};
 
@@ -221,9 +236,7 @@ namespace Zx
 			dynamicState.data()
 		};
 
-		SmartDeleter<VkPipelineLayout, PFN_vkDestroyPipelineLayout> pipelineLayout = CreatePipelineLayout();
-
-		if (!pipelineLayout)
+		if (!CreatePipelineLayout())
 			return false;
 
 		VkGraphicsPipelineCreateInfo graphicsPipelineInfo =
@@ -239,49 +252,64 @@ namespace Zx
 			&pipelineViewportInfo,
 			&pipelineRasterizationInfo,
 			&pipelineMultisampleInfo,
-			nullptr,
+			(m_renderPass->HasDepth() && !m_info.lighting) ? &pipelineDepthStencilInfo : nullptr,
 			&pipelineColorBlendStateCreateInfo,
 			&dynamicStateCreateInfo,
-			pipelineLayout.GetObj(),
+			m_pipeline->pipelineLayout,
 			m_renderPass->GetRenderPass(),
-			0,
+			m_info.lighting ? m_renderPass->GetColorSubpass() : m_renderPass->GetGeometrySubpass(),
 			VK_NULL_HANDLE,
 			-1
 		};
 
-		if (vkCreateGraphicsPipelines(m_device->GetDevice()->logicalDevice, VK_NULL_HANDLE, 1, &graphicsPipelineInfo, nullptr, &m_pipeline) != VK_SUCCESS)
+		if (vkCreateGraphicsPipelines(m_device->GetDevice()->logicalDevice, VK_NULL_HANDLE, 1, &graphicsPipelineInfo, nullptr, &m_pipeline->pipeline) != VK_SUCCESS)
 		{
 			std::cout << "Failed to create graphics pipeline" << std::endl;
 			return false;
 		}
 
+		if (!depthPrePass || !m_info.depthTest)
+			return true;
+
+		// The pre-pass pipeline runs the same vertex stage without fragment stage nor color attachment
+		pipelineDepthStencilInfo.depthWriteEnable = VK_TRUE;
+		pipelineDepthStencilInfo.depthCompareOp = m_info.depthCompareOp;
+		pipelineColorBlendStateCreateInfo.attachmentCount = 0;
+		pipelineColorBlendStateCreateInfo.pAttachments = nullptr;
+
+		graphicsPipelineInfo.stageCount = 1;
+		graphicsPipelineInfo.subpass = 0;
+
+		if (vkCreateGraphicsPipelines(m_device->GetDevice()->logicalDevice, VK_NULL_HANDLE, 1, &graphicsPipelineInfo, nullptr, &m_pipeline->depthPipeline) != VK_SUCCESS)
+		{
+			std::cout << "Failed to create depth pre-pass pipeline" << std::endl;
+			return false;
+		}
+
 		return true;
 	}
 
 	//----------------------------------------------------------------
 
-	SmartDeleter<VkPipelineLayout, PFN_vkDestroyPipelineLayout> Pipeline::CreatePipelineLayout()
+	bool Pipeline::CreatePipelineLayout()
 	{
-		// Pour l'instant on cr un pipeline "vide"
-
 		VkPipelineLayoutCreateInfo pipelineLayoutInfo = 
 		{
 			VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
 			nullptr,
 			0,
-			0,
-			nullptr,
-			0,
-			nullptr
+			static_cast<uint32_t>(m_info.descriptorSetLayouts.size()),
+			m_info.descriptorSetLayouts.data(),
+			static_cast<uint32_t>(m_info.pushConstantRanges.size()),
+			m_info.pushConstantRanges.data()
 		};
 
-		VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-		if (vkCreatePipelineLayout(m_device->GetDevice()->logicalDevice, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+		if (vkCreatePipelineLayout(m_device->GetDevice()->logicalDevice, &pipelineLayoutInfo, nullptr, &m_pipeline->pipelineLayout) != VK_SUCCESS)
 		{
 			std::cout << "Could not create pipeline layout" << std::endl;
-			return SmartDeleter<VkPipelineLayout, PFN_vkDestroyPipelineLayout>();
+			return false;
 		}
 
-		return SmartDeleter<VkPipelineLayout, PFN_vkDestroyPipelineLayout>(pipelineLayout, vkDestroyPipelineLayout, m_device->GetDevice()->logicalDevice);
+		return true;
 	}
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <string>
 #include <iostream>
+#include <cerrno>
+#include <poll.h>
 
 #include <Neon/Core/String.hpp>
 #include <Neon/Renderer/Posix/Platform.hpp>
@@ -50,6 +52,24 @@ namespace Zx
 
 		xcb_change_property(m_connection, XCB_PROP_MODE_REPLACE, m_handle, XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8, title.GetSize(), title.GetPtr());
 
+		// The window manager sends WM_DELETE_WINDOW instead of killing the connection when the window is closed
+		xcb_intern_atom_cookie_t protocolsCookie = xcb_intern_atom(m_connection, 1, 12, "WM_PROTOCOLS");
+		xcb_intern_atom_cookie_t deleteCookie = xcb_intern_atom(m_connection, 0, 16, "WM_DELETE_WINDOW");
+		xcb_intern_atom_reply_t* protocolsReply = xcb_intern_atom_reply(m_connection, protocolsCookie, nullptr);
+		xcb_intern_atom_reply_t* deleteReply = xcb_intern_atom_reply(m_connection, deleteCookie, nullptr);
+
+		m_deleteAtom = (deleteReply != nullptr) ? deleteReply->atom : XCB_ATOM_NONE;
+
+		if ((protocolsReply != nullptr) && (deleteReply != nullptr))
+			xcb_change_property(m_connection, XCB_PROP_MODE_REPLACE, m_handle, protocolsReply->atom, XCB_ATOM_ATOM, 32, 1, &m_deleteAtom);
+
+		free(protocolsReply);
+		free(deleteReply);
+
+		m_width = static_cast<uint16_t>(width);
+		m_height = static_cast<uint16_t>(height);
+		m_minimized = false;
+
 		return true;
 	}
 	
@@ -75,4 +95,74 @@ namespace Zx
 
 		return false;
 	}
+
+	/*
+	@brief : Handles every pending event in one batch, or blocks on the socket of the connection until one arrives
+	@param : The changes made by the events, added to the ones not handled yet
+	@param : The time to wait in milliseconds when no event is pending, 0 returns at once and -1 waits for the next event
+	@return : Returns false if the connection to the X server is lost, true otherwise
+	*/
+	bool Platform::PumpEvents(WindowEvents& events, int timeout)
+	{
+		xcb_generic_event_t* event = xcb_poll_for_event(m_connection);
+
+		if ((event == nullptr) && (timeout != 0))
+		{
+			// The requests still buffered may be the ones the server answers with the awaited events
+			xcb_flush(m_connection);
+
+			pollfd connection = { xcb_get_file_descriptor(m_connection), POLLIN, 0 };
+
+			if ((poll(&connection, 1, timeout) < 0) && (errno != EINTR))
+				return false;
+
+			event = xcb_poll_for_event(m_connection);
+		}
+
+		// The socket is read once, the rest of the batch is already in the queue of xcb
+		while (event != nullptr)
+		{
+			HandleEvent(*event, events);
+			free(event);
+
+			event = xcb_poll_for_queued_event(m_connection);
+		}
+
+		return xcb_connection_has_error(m_connection) == 0;
+	}
+
+	//-------------------------Private method-------------------------
+
+	void Platform::HandleEvent(const xcb_generic_event_t& event, WindowEvents& events)
+	{
+		switch (event.response_type & 0x7f)
+		{
+		case XCB_CONFIGURE_NOTIFY:
+		{
+			const xcb_configure_notify_event_t& configureEvent = reinterpret_cast<const xcb_configure_notify_event_t&>(event);
+
+			// A move of the window is notified as well, only a new size recreates the swap chain
+			if (((configureEvent.width > 0) && (configureEvent.width != m_width)) || ((configureEvent.height > 0) && (configureEvent.height != m_height)))
+			{
+				events.resize = true;
+				m_width = configureEvent.width;
+				m_height = configureEvent.height;
+			}
+			break;
+		}
+		case XCB_UNMAP_NOTIFY:
+			m_minimized = true;
+			break;
+		case XCB_MAP_NOTIFY:
+			m_minimized = false;
+			break;
+		case XCB_CLIENT_MESSAGE:
+			if (reinterpret_cast<const xcb_client_message_event_t&>(event).data.data32[0] == m_deleteAtom)
+				events.close = true;
+			break;
+		case XCB_KEY_PRESS:
+			events.close = true;
+			break;
+		}
+	}
 }
@@ -0,0 +1,1526 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/RenderGraph.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a graph rebuilt every frame from the passes declared on it, it orders their barriers, culls the unused ones and aliases its transient images
+	@param : A reference to the Device
+	@param : The allocator giving the memory of the transient images
+	*/
+	RenderGraph::RenderGraph(Device& device, MemoryAllocator& allocator)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_renderGraph = std::make_shared<RenderGraphs>();
+
+		m_renderGraph->allocator = MemoryAllocator(allocator);
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the graph and its caches
+	@param : A constant reference to the RenderGraph to copy
+	*/
+	RenderGraph::RenderGraph(const RenderGraph& renderGraph) : m_device(renderGraph.m_device), m_renderGraph(renderGraph.m_renderGraph)
+	{}
+
+	/*
+	@brief : Destroys the render passes, the framebuffers and the transient images once the last owner goes away, the device must be idle
+	*/
+	RenderGraph::~RenderGraph()
+	{
+		if ((m_renderGraph == nullptr) || (m_renderGraph.use_count() > 1))
+			return;
+
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		for (const CachedFramebuffer& framebuffer : m_renderGraph->framebuffers)
+			vkDestroyFramebuffer(logicalDevice, framebuffer.framebuffer, nullptr);
+
+		for (const CachedRenderPass& renderPass : m_renderGraph->renderPasses)
+			vkDestroyRenderPass(logicalDevice, renderPass.renderPass, nullptr);
+
+		m_renderGraph->framebuffers.clear();
+		m_renderGraph->renderPasses.clear();
+
+		ReleaseTransientImages(false);
+		ReleaseRetired(true);
+	}
+
+	/*
+	@brief : Starts the declaration of the graph of a new frame, the resources and the passes of the previous one are dropped
+	@param : The extent of the frame, followed by the transient images without size
+	*/
+	void RenderGraph::Reset(VkExtent2D extent)
+	{
+		m_renderGraph->extent = extent;
+
+		m_renderGraph->resources.clear();
+		m_renderGraph->passes.clear();
+		m_renderGraph->finalBarriers.clear();
+		m_renderGraph->compiled = false;
+
+		ReleaseRetired(false);
+
+		// The framebuffers of images gone or of passes not declared anymore are dropped once the frames using them are over
+		const FrameCounter& counter = m_device->GetDevice()->frameCounter;
+
+		auto it = std::partition(m_renderGraph->framebuffers.begin(), m_renderGraph->framebuffers.end(), [&counter](const CachedFramebuffer& framebuffer)
+		{
+			return !counter.IsOver(framebuffer.lastUsedFrame);
+		});
+
+		for (auto unused = it; unused != m_renderGraph->framebuffers.end(); unused++)
+			vkDestroyFramebuffer(m_device->GetDevice()->logicalDevice, unused->framebuffer, nullptr);
+
+		m_renderGraph->framebuffers.erase(it, m_renderGraph->framebuffers.end());
+	}
+
+	/*
+	@brief : Declares an image created by the graph, its contents only live from the first pass writing it to the last pass reading it
+	@param : The description of the image
+	@return : The handle of the image in the graph
+	*/
+	uint32_t RenderGraph::CreateImage(const RenderGraphImageInfo& info)
+	{
+		Resource resource;
+		resource.info = info;
+
+		if (resource.info.width == 0 || resource.info.height == 0)
+		{
+			resource.info.width = m_renderGraph->extent.width;
+			resource.info.height = m_renderGraph->extent.height;
+		}
+
+		m_renderGraph->resources.push_back(resource);
+
+		return static_cast<uint32_t>(m_renderGraph->resources.size() - 1);
+	}
+
+	/*
+	@brief : Declares an image owned outside of the graph
+	@param : The image
+	@param : The view used as attachment
+	@param : The format, the extent, the aspect and the sample count of the image
+	@param : The layout of the image before the graph, undefined to discard its contents
+	@param : The layout the image is moved to after the graph, undefined if its contents are not needed after the graph
+	@param : The stages which must be done with the image before the graph, the stage of the acquire semaphore for a swap chain image
+	@param : The accesses which must be made available before the graph, added to the ones of the initial layout
+	@return : The handle of the image in the graph
+	*/
+	uint32_t RenderGraph::ImportImage(VkImage image, VkImageView imageView, const RenderGraphImageInfo& info, VkImageLayout initialLayout, VkImageLayout finalLayout,
+		VkPipelineStageFlags initialStages, VkAccessFlags initialAccess)
+	{
+		Resource resource;
+		resource.image = image;
+		resource.imageView = imageView;
+		resource.info = info;
+		resource.imported = true;
+		resource.keep = finalLayout != VK_IMAGE_LAYOUT_UNDEFINED;
+		resource.initialLayout = initialLayout;
+		resource.finalLayout = finalLayout;
+		resource.initialStages = initialStages;
+
+		VkPipelineStageFlags layoutStages = 0;
+		GetLayoutAccess(initialLayout, resource.initialAccess, layoutStages);
+		resource.initialAccess |= initialAccess;
+
+		m_renderGraph->resources.push_back(resource);
+
+		return static_cast<uint32_t>(m_renderGraph->resources.size() - 1);
+	}
+
+	/*
+	@brief : Declares a buffer owned outside of the graph, its whole range is synchronized
+	@param : The buffer
+	@param : The stages which must be done with the buffer before the graph
+	@param : The accesses which must be made available before the graph
+	@return : The handle of the buffer in the graph
+	*/
+	uint32_t RenderGraph::ImportBuffer(VkBuffer buffer, VkPipelineStageFlags initialStages, VkAccessFlags initialAccess)
+	{
+		Resource resource;
+		resource.buffer = buffer;
+		resource.imported = true;
+		resource.keep = true;
+		resource.initialStages = initialStages;
+		resource.initialAccess = initialAccess;
+
+		m_renderGraph->resources.push_back(resource);
+
+		return static_cast<uint32_t>(m_renderGraph->resources.size() - 1);
+	}
+
+	/*
+	@brief : Declares a pass, the passes run in the order they are declared and read what the previous ones wrote
+	@param : True if the pass draws in its attachments inside a render pass begun by the graph
+	@param : The function recording the commands of the pass
+	@param : True if the pass has effects outside of the graph and must never be culled
+	@return : The handle of the pass in the graph
+	*/
+	uint32_t RenderGraph::AddPass(bool graphics, const std::function<void(VkCommandBuffer)>& record, bool sideEffect)
+	{
+		Pass pass;
+		pass.record = record;
+		pass.graphics = graphics;
+		pass.sideEffect = sideEffect;
+		pass.group = static_cast<uint32_t>(m_renderGraph->passes.size());
+
+		m_renderGraph->passes.push_back(pass);
+
+		return pass.group;
+	}
+
+	/*
+	@brief : Declares a graphics pass recorded as the next subpass of the render pass of another one, the attachments they share stay in tile memory between them
+	@param : The handle of the graphics pass declared just before
+	@param : The function recording the commands of the subpass
+	@return : The handle of the pass in the graph
+	*/
+	uint32_t RenderGraph::AddSubpass(uint32_t pass, const std::function<void(VkCommandBuffer)>& record)
+	{
+		uint32_t subpass = AddPass(true, record);
+
+		if ((pass + 1 != subpass) || !m_renderGraph->passes[pass].graphics)
+		{
+			std::cout << "A subpass must follow the graphics pass it continues, it begins its own render pass" << std::endl;
+			return subpass;
+		}
+
+		m_renderGraph->passes[subpass].group = m_renderGraph->passes[pass].group;
+		m_renderGraph->passes[subpass].subpass = m_renderGraph->passes[pass].subpass + 1;
+
+		return subpass;
+	}
+
+	/*
+	@brief : Adds a color attachment written by a graphics pass, in the order of the outputs of its fragment shader
+	@param : The handle of the pass
+	@param : The handle of the image
+	@param : The color the attachment is cleared to, nullptr to keep the contents written by the previous passes
+	@param : The handle of the single sampled image the attachment is resolved in at the end of the pass, InvalidHandle if it is not resolved
+	*/
+	void RenderGraph::AddColorAttachment(uint32_t pass, uint32_t image, const VkClearColorValue* clearColor, uint32_t resolveImage)
+	{
+		Pass& graphPass = m_renderGraph->passes[pass];
+
+		Attachment attachment;
+		attachment.resource = image;
+		attachment.clear = clearColor != nullptr;
+		attachment.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+		if (clearColor != nullptr)
+			attachment.clearValue.color = *clearColor;
+
+		Attachment resolveAttachment;
+		resolveAttachment.resource = resolveImage;
+		resolveAttachment.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+		// The depth attachment stays the last one
+		if (graphPass.depthAttachment != InvalidHandle)
+		{
+			graphPass.attachments.insert(graphPass.attachments.begin() + graphPass.depthAttachment, attachment);
+			graphPass.depthAttachment++;
+		}
+		else
+			graphPass.attachments.push_back(attachment);
+
+		graphPass.resolveAttachments.push_back(resolveAttachment);
+
+		Write(pass, image, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+			VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		graphPass.uses.back().attachment = true;
+
+		if (resolveImage == InvalidHandle)
+			return;
+
+		Write(pass, resolveImage, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		graphPass.uses.back().attachment = true;
+	}
+
+	/*
+	@brief : Sets the depth attachment of a graphics pass
+	@param : The handle of the pass
+	@param : The handle of the image
+	@param : The depth and stencil the attachment is cleared to, nullptr to keep the contents written by the previous passes
+	@param : True if the pass only tests the depth written by a previous pass
+	*/
+	void RenderGraph::SetDepthAttachment(uint32_t pass, uint32_t image, const VkClearDepthStencilValue* clearDepth, bool readOnly)
+	{
+		Pass& graphPass = m_renderGraph->passes[pass];
+
+		Attachment attachment;
+		attachment.resource = image;
+		attachment.clear = (clearDepth != nullptr) && !readOnly;
+		attachment.layout = readOnly ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		if (attachment.clear)
+			attachment.clearValue.depthStencil = *clearDepth;
+
+		if (graphPass.depthAttachment != InvalidHandle)
+			graphPass.attachments[graphPass.depthAttachment] = attachment;
+		else
+		{
+			graphPass.attachments.push_back(attachment);
+			graphPass.depthAttachment = static_cast<uint32_t>(graphPass.attachments.size() - 1);
+		}
+
+		VkPipelineStageFlags stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
+		if (readOnly)
+			Read(pass, image, stages, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT, attachment.layout);
+		else
+			Write(pass, image, stages, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, attachment.layout);
+
+		graphPass.uses.back().attachment = true;
+	}
+
+	/*
+	@brief : Adds an input attachment read by a subpass at the pixel it shades, written by a previous subpass of the same render pass
+	@param : The handle of the pass
+	@param : The handle of the image, a depth image is read in the layout keeping it usable as a depth attachment
+	*/
+	void RenderGraph::AddInputAttachment(uint32_t pass, uint32_t image)
+	{
+		bool depth = (m_renderGraph->resources[image].info.aspect & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0;
+
+		Attachment attachment;
+		attachment.resource = image;
+		attachment.layout = depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		m_renderGraph->passes[pass].inputAttachments.push_back(attachment);
+
+		Read(pass, image, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_INPUT_ATTACHMENT_READ_BIT, attachment.layout);
+
+		ResourceUse& use = m_renderGraph->passes[pass].uses.back();
+		use.usage = VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+		use.attachment = true;
+	}
+
+	/*
+	@brief : Declares a resource read by a pass
+	@param : The handle of the pass
+	@param : The handle of the resource
+	@param : The stages reading the resource
+	@param : The accesses of these stages
+	@param : The layout an image is read in, the general layout if undefined, ignored for a buffer
+	*/
+	void RenderGraph::Read(uint32_t pass, uint32_t resource, VkPipelineStageFlags stages, VkAccessFlags access, VkImageLayout layout)
+	{
+		ResourceUse use;
+		use.resource = resource;
+		use.stages = stages;
+		use.access = access;
+		use.layout = layout;
+		use.write = false;
+
+		if ((m_renderGraph->resources[resource].buffer == VK_NULL_HANDLE) && (layout == VK_IMAGE_LAYOUT_UNDEFINED))
+			use.layout = VK_IMAGE_LAYOUT_GENERAL;
+
+		if (m_renderGraph->resources[resource].buffer == VK_NULL_HANDLE)
+			use.usage = GetLayoutUsage(use.layout);
+
+		m_renderGraph->passes[pass].uses.push_back(use);
+	}
+
+	/*
+	@brief : Declares a resource written by a pass, the previous contents are kept unless the pass clears them
+	@param : The handle of the pass
+	@param : The handle of the resource
+	@param : The stages writing the resource
+	@param : The accesses of these stages
+	@param : The layout an image is written in, the general layout if undefined, ignored for a buffer
+	*/
+	void RenderGraph::Write(uint32_t pass, uint32_t resource, VkPipelineStageFlags stages, VkAccessFlags access, VkImageLayout layout)
+	{
+		ResourceUse use;
+		use.resource = resource;
+		use.stages = stages;
+		use.access = access;
+		use.layout = layout;
+		use.write = true;
+
+		if ((m_renderGraph->resources[resource].buffer == VK_NULL_HANDLE) && (layout == VK_IMAGE_LAYOUT_UNDEFINED))
+			use.layout = VK_IMAGE_LAYOUT_GENERAL;
+
+		if (m_renderGraph->resources[resource].buffer == VK_NULL_HANDLE)
+			use.usage = GetLayoutUsage(use.layout);
+
+		m_renderGraph->passes[pass].uses.push_back(use);
+	}
+
+	/*
+	@brief : Culls the passes nothing reads, creates or reuses the transient images and computes the barriers, subpass dependencies, render passes and framebuffers of the others
+	@return : Returns true if the graph can be executed, false otherwise
+	*/
+	bool RenderGraph::Compile()
+	{
+		CullPasses();
+
+		std::vector<Pass>& passes = m_renderGraph->passes;
+		std::vector<Resource>& resources = m_renderGraph->resources;
+
+		// The lifetime and the usage of the images come from the passes kept
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			if (passes[i].culled)
+				continue;
+
+			if (passes[i].graphics && passes[i].attachments.empty() && passes[i].inputAttachments.empty())
+			{
+				std::cout << "Failed to compile a graphics pass without attachment" << std::endl;
+				return false;
+			}
+
+			for (const ResourceUse& use : passes[i].uses)
+			{
+				Resource& resource = resources[use.resource];
+
+				resource.firstPass = std::min(resource.firstPass, i);
+				resource.lastPass = std::max(resource.lastPass, i);
+				resource.usage |= use.usage;
+			}
+		}
+
+		if (!CreateTransientImages())
+		{
+			std::cout << "Failed to create the transient images of the render graph" << std::endl;
+			return false;
+		}
+
+		ComputeBarriers();
+
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			if (passes[i].culled || !passes[i].graphics)
+				continue;
+
+			// The subpasses draw in the render pass and the framebuffer of the first one
+			if (passes[i].group != i)
+			{
+				passes[i].renderPass = passes[passes[i].group].renderPass;
+				passes[i].framebuffer = passes[passes[i].group].framebuffer;
+				continue;
+			}
+
+			if (!CreateRenderPass(i) || !CreateFramebuffer(passes[i]))
+			{
+				std::cout << "Failed to create the render pass of a render graph pass" << std::endl;
+				return false;
+			}
+		}
+
+		m_renderGraph->compiled = true;
+
+		return true;
+	}
+
+	/*
+	@brief : Records the passes kept by the compilation with their barriers, then moves the imported images to their final layout
+	@param : The command buffer in recording state
+	*/
+	void RenderGraph::Execute(VkCommandBuffer commandBuffer) const
+	{
+		if (!m_renderGraph->compiled)
+			return;
+
+		std::vector<VkClearValue> clearValues;
+
+		for (uint32_t i = 0; i < m_renderGraph->passes.size(); i++)
+		{
+			const Pass& pass = m_renderGraph->passes[i];
+
+			if (pass.culled)
+				continue;
+
+			// The barriers of every subpass are recorded before the render pass begins
+			bool begins = pass.group == i;
+
+			if (begins && (!pass.imageBarriers.empty() || !pass.bufferBarriers.empty()))
+			{
+				vkCmdPipelineBarrier(commandBuffer, pass.srcStages, pass.dstStages, 0, 0, nullptr, static_cast<uint32_t>(pass.bufferBarriers.size()), pass.bufferBarriers.data(),
+					static_cast<uint32_t>(pass.imageBarriers.size()), pass.imageBarriers.data());
+			}
+
+			if (!pass.graphics)
+			{
+				if (pass.record)
+					pass.record(commandBuffer);
+
+				continue;
+			}
+
+			if (!begins)
+			{
+				vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+
+				if (pass.record)
+					pass.record(commandBuffer);
+
+				if (IsLastSubpass(i))
+					vkCmdEndRenderPass(commandBuffer);
+
+				continue;
+			}
+
+			clearValues.clear();
+
+			for (const Attachment& attachment : pass.renderAttachments)
+				clearValues.push_back(attachment.clearValue);
+
+			VkRenderPassBeginInfo renderPassBeginInfo =
+			{
+				VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+				nullptr,
+				pass.renderPass,
+				pass.framebuffer,
+				{
+					{
+						0,
+						0
+					},
+					pass.extent
+				},
+				static_cast<uint32_t>(clearValues.size()),
+				clearValues.data()
+			};
+
+			vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+			if (pass.record)
+				pass.record(commandBuffer);
+
+			if (IsLastSubpass(i))
+				vkCmdEndRenderPass(commandBuffer);
+		}
+
+		if (!m_renderGraph->finalBarriers.empty())
+		{
+			vkCmdPipelineBarrier(commandBuffer, m_renderGraph->finalSrcStages, m_renderGraph->finalDstStages, 0, 0, nullptr, 0, nullptr,
+				static_cast<uint32_t>(m_renderGraph->finalBarriers.size()), m_renderGraph->finalBarriers.data());
+		}
+	}
+
+	/*
+	@brief : Assigns the graph by move semantic
+	@param : The graph to move
+	@return : A reference to this
+	*/
+	RenderGraph& RenderGraph::operator=(RenderGraph&& renderGraph) noexcept
+	{
+		std::swap(m_device, renderGraph.m_device);
+		std::swap(m_renderGraph, renderGraph.m_renderGraph);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	void RenderGraph::CullPasses()
+	{
+		std::vector<Pass>& passes = m_renderGraph->passes;
+		std::vector<Resource>& resources = m_renderGraph->resources;
+
+		// Walked from the last pass, a pass is kept if a kept pass or the caller needs what it writes
+		std::vector<bool> needed(resources.size(), false);
+
+		for (uint32_t last = static_cast<uint32_t>(passes.size()); last-- > 0;)
+		{
+			// The subpasses of a render pass are kept or culled together, the pipelines are created for their indices
+			uint32_t first = passes[last].group;
+			bool culled = true;
+
+			for (uint32_t i = first; i <= last; i++)
+			{
+				culled = culled && !passes[i].sideEffect;
+
+				for (const ResourceUse& use : passes[i].uses)
+				{
+					if (use.write && (needed[use.resource] || (resources[use.resource].imported && resources[use.resource].keep)))
+						culled = false;
+				}
+			}
+
+			for (uint32_t i = first; i <= last; i++)
+				passes[i].culled = culled;
+
+			for (uint32_t i = last + 1; !culled && (i-- > first);)
+			{
+				const Pass& pass = passes[i];
+
+				// A cleared attachment does not need the passes which wrote it before, any other write may keep a part of their contents
+				for (const ResourceUse& use : pass.uses)
+				{
+					if (!use.write)
+						continue;
+
+					bool cleared = false;
+
+					for (const Attachment& attachment : pass.attachments)
+					{
+						if (attachment.resource == use.resource)
+							cleared = attachment.clear;
+					}
+
+					needed[use.resource] = !cleared;
+				}
+
+				for (const ResourceUse& use : pass.uses)
+				{
+					if (!use.write)
+						needed[use.resource] = true;
+				}
+			}
+
+			last = first;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool RenderGraph::CreateTransientImages()
+	{
+		std::vector<Resource>& resources = m_renderGraph->resources;
+		const std::vector<Pass>& passes = m_renderGraph->passes;
+		std::vector<TransientImage> transientImages;
+
+		for (Resource& resource : resources)
+		{
+			if (resource.imported || (resource.firstPass == InvalidHandle))
+				continue;
+
+			TransientImage transientImage;
+			transientImage.info = resource.info;
+			transientImage.usage = resource.usage | resource.info.usage;
+			transientImage.firstPass = resource.firstPass;
+			transientImage.lastPass = resource.lastPass;
+
+			// An attachment living in a single render pass is neither loaded nor stored, tiled GPUs keep it in tile memory
+			VkImageUsageFlags attachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+
+			if (((transientImage.usage & ~attachmentUsage) == 0) && (passes[transientImage.firstPass].group == passes[transientImage.lastPass].group))
+				transientImage.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+
+			resource.transient = static_cast<uint32_t>(transientImages.size());
+			transientImages.push_back(transientImage);
+		}
+
+		// The images of the previous frame are kept as long as the graph declares the same ones with the same lifetimes
+		std::vector<TransientImage>& cachedImages = m_renderGraph->transientImages;
+		bool same = cachedImages.size() == transientImages.size();
+
+		for (uint32_t i = 0; (i < transientImages.size()) && same; i++)
+		{
+			const TransientImage& image = transientImages[i];
+			const TransientImage& cachedImage = cachedImages[i];
+
+			same = (image.info.format == cachedImage.info.format) && (image.info.width == cachedImage.info.width) && (image.info.height == cachedImage.info.height)
+				&& (image.info.aspect == cachedImage.info.aspect) && (image.info.samples == cachedImage.info.samples) && (image.usage == cachedImage.usage)
+				&& (image.firstPass == cachedImage.firstPass)
+				&& (image.lastPass == cachedImage.lastPass);
+		}
+
+		if (!same)
+		{
+			ReleaseTransientImages(true);
+
+			// Nothing recorded uses the new images yet, they are destroyed at once
+			if (!AllocateTransientImages(transientImages))
+			{
+				ReleaseTransientImages(false);
+				return false;
+			}
+		}
+
+		for (Resource& resource : resources)
+		{
+			if (resource.transient == InvalidHandle)
+				continue;
+
+			resource.image = m_renderGraph->transientImages[resource.transient].image;
+			resource.imageView = m_renderGraph->transientImages[resource.transient].imageView;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool RenderGraph::AllocateTransientImages(std::vector<TransientImage>& transientImages)
+	{
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		m_renderGraph->transientImages = transientImages;
+
+		std::vector<TransientImage>& images = m_renderGraph->transientImages;
+		std::vector<VkMemoryRequirements> requirements(images.size());
+
+		for (uint32_t i = 0; i < images.size(); i++)
+		{
+			VkImageCreateInfo imageCreateInfo =
+			{
+				VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+				nullptr,
+				0,
+				VK_IMAGE_TYPE_2D,
+				images[i].info.format,
+				{ images[i].info.width, images[i].info.height, 1 },
+				1,
+				1,
+				images[i].info.samples,
+				VK_IMAGE_TILING_OPTIMAL,
+				images[i].usage,
+				VK_SHARING_MODE_EXCLUSIVE,
+				0,
+				nullptr,
+				VK_IMAGE_LAYOUT_UNDEFINED
+			};
+
+			if (vkCreateImage(logicalDevice, &imageCreateInfo, nullptr, &images[i].image) != VK_SUCCESS)
+				return false;
+
+			vkGetImageMemoryRequirements(logicalDevice, images[i].image, &requirements[i]);
+			m_renderGraph->unaliasedSize += requirements[i].size;
+		}
+
+		// The largest images are placed first, an image goes in the first slot of a compatible memory type whose images all live in other passes
+		std::vector<uint32_t> order(images.size());
+		std::iota(order.begin(), order.end(), 0);
+
+		std::sort(order.begin(), order.end(), [&requirements](uint32_t a, uint32_t b)
+		{
+			return requirements[a].size > requirements[b].size;
+		});
+
+		std::vector<MemorySlot>& slots = m_renderGraph->memorySlots;
+
+		for (uint32_t index : order)
+		{
+			TransientImage& image = images[index];
+			bool lazy = (image.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0;
+
+			for (uint32_t i = 0; (i < slots.size()) && (image.slot == InvalidHandle); i++)
+			{
+				if ((slots[i].lazy != lazy) || ((slots[i].requirements.memoryTypeBits & requirements[index].memoryTypeBits) == 0))
+					continue;
+
+				bool overlap = false;
+
+				for (const std::pair<uint32_t, uint32_t>& lifetime : slots[i].lifetimes)
+					overlap = overlap || ((image.firstPass <= lifetime.second) && (lifetime.first <= image.lastPass));
+
+				if (!overlap)
+					image.slot = i;
+			}
+
+			if (image.slot == InvalidHandle)
+			{
+				slots.push_back(MemorySlot());
+				slots.back().requirements = requirements[index];
+				slots.back().lazy = lazy;
+				image.slot = static_cast<uint32_t>(slots.size() - 1);
+			}
+
+			MemorySlot& slot = slots[image.slot];
+			slot.requirements.size = std::max(slot.requirements.size, requirements[index].size);
+			slot.requirements.alignment = std::max(slot.requirements.alignment, requirements[index].alignment);
+			slot.requirements.memoryTypeBits &= requirements[index].memoryTypeBits;
+			slot.lifetimes.push_back(std::make_pair(image.firstPass, image.lastPass));
+		}
+
+		for (MemorySlot& slot : slots)
+		{
+			VkMemoryPropertyFlags memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+			if (slot.lazy && m_renderGraph->allocator.IsMemoryTypeAvailable(slot.requirements.memoryTypeBits, memoryProperties | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT))
+				memoryProperties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+			if (!m_renderGraph->allocator.Allocate(slot.requirements, memoryProperties, slot.allocation))
+				return false;
+
+			m_renderGraph->transientSize += slot.allocation.size;
+		}
+
+		for (TransientImage& image : images)
+		{
+			const MemoryAllocation& allocation = slots[image.slot].allocation;
+
+			if (vkBindImageMemory(logicalDevice, image.image, allocation.memory, allocation.offset) != VK_SUCCESS)
+				return false;
+
+			VkImageViewCreateInfo imageViewInfo =
+			{
+				VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+				nullptr,
+				0,
+				image.image,
+				VK_IMAGE_VIEW_TYPE_2D,
+				image.info.format,
+				{
+					VK_COMPONENT_SWIZZLE_IDENTITY,
+					VK_COMPONENT_SWIZZLE_IDENTITY,
+					VK_COMPONENT_SWIZZLE_IDENTITY,
+					VK_COMPONENT_SWIZZLE_IDENTITY
+				},
+				{
+					image.info.aspect,
+					0,
+					1,
+					0,
+					1
+				}
+			};
+
+			if (vkCreateImageView(logicalDevice, &imageViewInfo, nullptr, &image.imageView) != VK_SUCCESS)
+				return false;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::ComputeBarriers()
+	{
+		std::vector<Pass>& passes = m_renderGraph->passes;
+		std::vector<Resource>& resources = m_renderGraph->resources;
+
+		m_renderGraph->barrierCount = 0;
+
+		for (Resource& resource : resources)
+		{
+			resource.state = ResourceState();
+
+			// Imported resources keep their contents, a transient image starts undefined once the previous user of its memory is done
+			if (resource.imported)
+			{
+				resource.state.layout = resource.initialLayout;
+				resource.state.writeStages = resource.initialStages;
+				resource.state.writeAccess = resource.initialAccess;
+				resource.state.written = (resource.buffer != VK_NULL_HANDLE) || (resource.initialLayout != VK_IMAGE_LAYOUT_UNDEFINED);
+			}
+		}
+
+		std::vector<bool> begun(resources.size(), false);
+
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			Pass& pass = passes[i];
+
+			pass.srcStages = 0;
+			pass.dstStages = 0;
+			pass.imageBarriers.clear();
+			pass.bufferBarriers.clear();
+
+			if (pass.culled)
+				continue;
+
+			if (pass.graphics && (pass.group == i))
+				BeginRenderPass(i);
+
+			// The barriers of a subpass are recorded before its render pass begins
+			Pass& renderPass = passes[pass.group];
+
+			for (const ResourceUse& use : pass.uses)
+			{
+				Resource& resource = resources[use.resource];
+
+				AddUse(renderPass, resource, use, pass.subpass, begun);
+
+				if (!use.attachment)
+					continue;
+
+				resource.state.useSubpass = pass.subpass;
+
+				if (use.write)
+					resource.state.writeSubpass = pass.subpass;
+
+				// The render pass leaves the attachment in the layout of its last subpass
+				uint32_t attachment = FindAttachment(renderPass.renderAttachments, use.resource);
+
+				if (attachment != InvalidHandle)
+					renderPass.renderAttachments[attachment].finalLayout = use.layout;
+			}
+
+			if ((renderPass.srcStages == 0) && (!renderPass.imageBarriers.empty() || !renderPass.bufferBarriers.empty()))
+				renderPass.srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+			if (pass.graphics && IsLastSubpass(i))
+				EndRenderPass(pass.group, i);
+		}
+
+		m_renderGraph->finalSrcStages = 0;
+		m_renderGraph->finalDstStages = 0;
+
+		for (const Resource& resource : resources)
+		{
+			if (!resource.imported || (resource.buffer != VK_NULL_HANDLE) || (resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED)
+				|| (resource.finalLayout == resource.state.layout))
+				continue;
+
+			VkAccessFlags dstAccess = 0;
+			VkPipelineStageFlags dstStages = 0;
+			GetLayoutAccess(resource.finalLayout, dstAccess, dstStages);
+
+			VkImageMemoryBarrier imageMemoryBarrier =
+			{
+				VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+				nullptr,
+				resource.state.writeAccess,
+				dstAccess,
+				resource.state.layout,
+				resource.finalLayout,
+				VK_QUEUE_FAMILY_IGNORED,
+				VK_QUEUE_FAMILY_IGNORED,
+				resource.image,
+				{
+					resource.info.aspect,
+					0,
+					VK_REMAINING_MIP_LEVELS,
+					0,
+					VK_REMAINING_ARRAY_LAYERS
+				}
+			};
+
+			m_renderGraph->finalBarriers.push_back(imageMemoryBarrier);
+			m_renderGraph->finalSrcStages |= resource.state.writeStages | resource.state.readStages;
+			m_renderGraph->finalDstStages |= dstStages;
+			m_renderGraph->barrierCount++;
+		}
+
+		if (m_renderGraph->finalSrcStages == 0)
+			m_renderGraph->finalSrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::BeginRenderPass(uint32_t pass)
+	{
+		std::vector<Pass>& passes = m_renderGraph->passes;
+		std::vector<Resource>& resources = m_renderGraph->resources;
+
+		Pass& renderPass = passes[pass];
+		renderPass.renderAttachments.clear();
+		renderPass.dependencies.clear();
+
+		// The attachments of the render pass in the order of their first use, loaded from the state they have before it
+		auto addAttachment = [&renderPass, &resources](const Attachment& attachment, bool overwritten)
+		{
+			if ((attachment.resource == InvalidHandle) || (FindAttachment(renderPass.renderAttachments, attachment.resource) != InvalidHandle))
+				return;
+
+			Resource& resource = resources[attachment.resource];
+			resource.state.writeSubpass = InvalidHandle;
+			resource.state.useSubpass = InvalidHandle;
+
+			Attachment renderAttachment = attachment;
+			renderAttachment.finalLayout = attachment.layout;
+
+			if (attachment.clear)
+				renderAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+			else if (resource.state.written && !overwritten)
+				renderAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+			else
+				renderAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+
+			renderPass.renderAttachments.push_back(renderAttachment);
+		};
+
+		for (uint32_t i = pass; (i < passes.size()) && (passes[i].group == pass); i++)
+		{
+			const Pass& subpass = passes[i];
+
+			for (const Attachment& attachment : subpass.attachments)
+				addAttachment(attachment, false);
+
+			// A resolve writes every pixel of the image
+			for (const Attachment& attachment : subpass.resolveAttachments)
+				addAttachment(attachment, true);
+
+			for (const Attachment& attachment : subpass.inputAttachments)
+				addAttachment(attachment, false);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::EndRenderPass(uint32_t pass, uint32_t lastPass)
+	{
+		// The contents are stored when the caller or a pass after the render pass needs them
+		for (Attachment& attachment : m_renderGraph->passes[pass].renderAttachments)
+		{
+			const Resource& resource = m_renderGraph->resources[attachment.resource];
+			bool readAfter = (resource.imported && resource.keep) || (resource.lastPass > lastPass);
+
+			attachment.storeOp = readAfter ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::AddUse(Pass& pass, Resource& resource, const ResourceUse& use, uint32_t subpass, std::vector<bool>& begun)
+	{
+		MemorySlot* slot = nullptr;
+
+		if (resource.transient != InvalidHandle)
+			slot = &m_renderGraph->memorySlots[m_renderGraph->transientImages[resource.transient].slot];
+
+		if ((slot != nullptr) && !begun[use.resource])
+		{
+			resource.state.writeStages = slot->lastStages;
+			resource.state.writeAccess = slot->lastAccess;
+			begun[use.resource] = true;
+		}
+
+		// An attachment used by a previous subpass is synchronized by a dependency of the render pass, every other use by a barrier before it
+		if (use.attachment && (resource.state.useSubpass != InvalidHandle))
+			AddDependency(pass, resource, use, subpass);
+		else
+			AddBarrier(pass, resource, use);
+
+		if (slot != nullptr)
+		{
+			slot->lastStages = resource.state.writeStages | resource.state.readStages;
+			slot->lastAccess = resource.state.writeAccess;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::AddBarrier(Pass& pass, Resource& resource, const ResourceUse& use)
+	{
+		ResourceState& state = resource.state;
+
+		bool image = resource.buffer == VK_NULL_HANDLE;
+		bool layoutChange = image && (use.layout != state.layout);
+
+		VkPipelineStageFlags srcStages = 0;
+		VkAccessFlags srcAccess = 0;
+
+		// A read only waits for the last write once per stage, a write waits for every access since the last write
+		if (layoutChange || use.write)
+		{
+			srcStages = state.writeStages | state.readStages;
+			srcAccess = state.writeAccess;
+		}
+		else if ((state.writeAccess != 0) && (((use.stages & ~state.visibleStages) != 0) || ((use.access & ~state.visibleAccess) != 0)))
+		{
+			srcStages = state.writeStages;
+			srcAccess = state.writeAccess;
+		}
+
+		bool barrier = layoutChange || (srcAccess != 0) || ((srcStages & ~VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT) != 0);
+
+		if (barrier)
+		{
+			pass.srcStages |= srcStages;
+			pass.dstStages |= use.stages;
+
+			if (image)
+			{
+				VkImageMemoryBarrier imageMemoryBarrier =
+				{
+					VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+					nullptr,
+					srcAccess,
+					use.access,
+					state.layout,
+					use.layout,
+					VK_QUEUE_FAMILY_IGNORED,
+					VK_QUEUE_FAMILY_IGNORED,
+					resource.image,
+					{
+						resource.info.aspect,
+						0,
+						VK_REMAINING_MIP_LEVELS,
+						0,
+						VK_REMAINING_ARRAY_LAYERS
+					}
+				};
+
+				pass.imageBarriers.push_back(imageMemoryBarrier);
+			}
+			else
+			{
+				VkBufferMemoryBarrier bufferMemoryBarrier =
+				{
+					VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+					nullptr,
+					srcAccess,
+					use.access,
+					VK_QUEUE_FAMILY_IGNORED,
+					VK_QUEUE_FAMILY_IGNORED,
+					resource.buffer,
+					0,
+					VK_WHOLE_SIZE
+				};
+
+				pass.bufferBarriers.push_back(bufferMemoryBarrier);
+			}
+
+			m_renderGraph->barrierCount++;
+		}
+
+		UpdateState(state, use, barrier, image);
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::AddDependency(Pass& pass, Resource& resource, const ResourceUse& use, uint32_t subpass)
+	{
+		ResourceState& state = resource.state;
+
+		bool layoutChange = use.layout != state.layout;
+
+		uint32_t srcSubpass = InvalidHandle;
+		VkPipelineStageFlags srcStages = 0;
+		VkAccessFlags srcAccess = 0;
+
+		// Like the barriers, a read waits for the subpass of the last write, a write or a layout transition for the last subpass using the attachment
+		if (layoutChange || use.write)
+		{
+			srcSubpass = state.useSubpass;
+			srcStages = state.writeStages | state.readStages;
+			srcAccess = state.writeAccess;
+		}
+		else if (state.writeSubpass != InvalidHandle)
+		{
+			srcSubpass = state.writeSubpass;
+			srcStages = state.writeStages;
+			srcAccess = state.writeAccess;
+		}
+
+		bool dependency = (srcSubpass != InvalidHandle) && (srcSubpass != subpass);
+
+		if (dependency)
+		{
+			if (srcStages == 0)
+				srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+			auto it = std::find_if(pass.dependencies.begin(), pass.dependencies.end(), [srcSubpass, subpass](const VkSubpassDependency& subpassDependency)
+			{
+				return (subpassDependency.srcSubpass == srcSubpass) && (subpassDependency.dstSubpass == subpass);
+			});
+
+			// The attachments are only read at the pixel they were written, the tiles stay in place between the subpasses
+			if (it == pass.dependencies.end())
+				pass.dependencies.push_back({ srcSubpass, subpass, srcStages, use.stages, srcAccess, use.access, VK_DEPENDENCY_BY_REGION_BIT });
+			else
+			{
+				it->srcStageMask |= srcStages;
+				it->dstStageMask |= use.stages;
+				it->srcAccessMask |= srcAccess;
+				it->dstAccessMask |= use.access;
+			}
+		}
+
+		UpdateState(state, use, dependency, true);
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool RenderGraph::CreateRenderPass(uint32_t pass)
+	{
+		Pass& renderPass = m_renderGraph->passes[pass];
+		std::vector<VkAttachmentDescription> attachments;
+
+		for (const Attachment& attachment : renderPass.renderAttachments)
+		{
+			const RenderGraphImageInfo& info = m_renderGraph->resources[attachment.resource].info;
+			bool stencil = (info.aspect & VK_IMAGE_ASPECT_STENCIL_BIT) != 0;
+
+			// The graph moves the images to the layout of their first subpass before the render pass, the render pass leaves them in the layout of their last one
+			VkAttachmentDescription attachmentDescription =
+			{
+				0,
+				info.format,
+				info.samples,
+				attachment.loadOp,
+				attachment.storeOp,
+				stencil ? attachment.loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+				stencil ? attachment.storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+				attachment.layout,
+				attachment.finalLayout
+			};
+
+			attachments.push_back(attachmentDescription);
+		}
+
+		uint32_t subpassCount = 0;
+
+		while ((pass + subpassCount < m_renderGraph->passes.size()) && (m_renderGraph->passes[pass + subpassCount].group == pass))
+			subpassCount++;
+
+		std::vector<std::vector<VkAttachmentReference>> colorReferences(subpassCount);
+		std::vector<std::vector<VkAttachmentReference>> resolveReferences(subpassCount);
+		std::vector<std::vector<VkAttachmentReference>> inputReferences(subpassCount);
+		std::vector<VkAttachmentReference> depthReferences(subpassCount, { VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED });
+
+		// The references of every subpass are part of the key of the render pass
+		std::vector<uint32_t> key;
+
+		auto addReferences = [&key](const std::vector<VkAttachmentReference>& references)
+		{
+			key.push_back(static_cast<uint32_t>(references.size()));
+
+			for (const VkAttachmentReference& reference : references)
+			{
+				key.push_back(reference.attachment);
+				key.push_back(static_cast<uint32_t>(reference.layout));
+			}
+		};
+
+		for (uint32_t i = 0; i < subpassCount; i++)
+		{
+			const Pass& subpass = m_renderGraph->passes[pass + i];
+			bool resolve = false;
+
+			for (uint32_t j = 0; j < subpass.attachments.size(); j++)
+			{
+				const Attachment& attachment = subpass.attachments[j];
+				VkAttachmentReference reference = { FindAttachment(renderPass.renderAttachments, attachment.resource), attachment.layout };
+
+				if (j == subpass.depthAttachment)
+				{
+					depthReferences[i] = reference;
+					continue;
+				}
+
+				const Attachment& resolveAttachment = subpass.resolveAttachments[j];
+				bool resolved = resolveAttachment.resource != InvalidHandle;
+
+				colorReferences[i].push_back(reference);
+				resolveReferences[i].push_back({ resolved ? FindAttachment(renderPass.renderAttachments, resolveAttachment.resource) : VK_ATTACHMENT_UNUSED,
+					resolveAttachment.layout });
+
+				resolve = resolve || resolved;
+			}
+
+			if (!resolve)
+				resolveReferences[i].clear();
+
+			for (const Attachment& attachment : subpass.inputAttachments)
+				inputReferences[i].push_back({ FindAttachment(renderPass.renderAttachments, attachment.resource), attachment.layout });
+
+			addReferences(colorReferences[i]);
+			addReferences(resolveReferences[i]);
+			addReferences(std::vector<VkAttachmentReference>(1, depthReferences[i]));
+			addReferences(inputReferences[i]);
+		}
+
+		const std::vector<VkSubpassDependency>& dependencies = renderPass.dependencies;
+
+		// The load and store operations are part of the key, the render passes only differing by them stay compatible with the same pipelines
+		for (const CachedRenderPass& cachedRenderPass : m_renderGraph->renderPasses)
+		{
+			if ((cachedRenderPass.subpasses == key) && (cachedRenderPass.attachments.size() == attachments.size())
+				&& (cachedRenderPass.dependencies.size() == dependencies.size())
+				&& (attachments.empty() || (std::memcmp(cachedRenderPass.attachments.data(), attachments.data(), attachments.size() * sizeof(VkAttachmentDescription)) == 0))
+				&& (dependencies.empty() || (std::memcmp(cachedRenderPass.dependencies.data(), dependencies.data(), dependencies.size() * sizeof(VkSubpassDependency)) == 0)))
+			{
+				renderPass.renderPass = cachedRenderPass.renderPass;
+				return true;
+			}
+		}
+
+		std::vector<VkSubpassDescription> subpassDescriptions;
+
+		for (uint32_t i = 0; i < subpassCount; i++)
+		{
+			VkSubpassDescription subpassDescription =
+			{
+				0,
+				VK_PIPELINE_BIND_POINT_GRAPHICS,
+				static_cast<uint32_t>(inputReferences[i].size()),
+				inputReferences[i].data(),
+				static_cast<uint32_t>(colorReferences[i].size()),
+				colorReferences[i].data(),
+				resolveReferences[i].empty() ? nullptr : resolveReferences[i].data(),
+				(depthReferences[i].attachment != VK_ATTACHMENT_UNUSED) ? &depthReferences[i] : nullptr,
+				0,
+				nullptr
+			};
+
+			subpassDescriptions.push_back(subpassDescription);
+		}
+
+		// The barriers recorded by the graph synchronize the attachments with the passes around the render pass, the dependencies only order its subpasses
+		VkRenderPassCreateInfo renderPassCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+			nullptr,
+			0,
+			static_cast<uint32_t>(attachments.size()),
+			attachments.data(),
+			static_cast<uint32_t>(subpassDescriptions.size()),
+			subpassDescriptions.data(),
+			static_cast<uint32_t>(dependencies.size()),
+			dependencies.data()
+		};
+
+		CachedRenderPass cachedRenderPass;
+		cachedRenderPass.attachments = attachments;
+		cachedRenderPass.subpasses = key;
+		cachedRenderPass.dependencies = dependencies;
+
+		if (vkCreateRenderPass(m_device->GetDevice()->logicalDevice, &renderPassCreateInfo, nullptr, &cachedRenderPass.renderPass) != VK_SUCCESS)
+			return false;
+
+		m_renderGraph->renderPasses.push_back(cachedRenderPass);
+		renderPass.renderPass = cachedRenderPass.renderPass;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool RenderGraph::CreateFramebuffer(Pass& pass)
+	{
+		std::vector<VkImageView> imageViews;
+
+		pass.extent = { UINT32_MAX, UINT32_MAX };
+
+		for (const Attachment& attachment : pass.renderAttachments)
+		{
+			const Resource& resource = m_renderGraph->resources[attachment.resource];
+
+			imageViews.push_back(resource.imageView);
+			pass.extent.width = std::min(pass.extent.width, resource.info.width);
+			pass.extent.height = std::min(pass.extent.height, resource.info.height);
+		}
+
+		for (CachedFramebuffer& cachedFramebuffer : m_renderGraph->framebuffers)
+		{
+			if ((cachedFramebuffer.renderPass == pass.renderPass) && (cachedFramebuffer.imageViews == imageViews) && (cachedFramebuffer.extent.width == pass.extent.width)
+				&& (cachedFramebuffer.extent.height == pass.extent.height))
+			{
+				cachedFramebuffer.lastUsedFrame = m_device->GetDevice()->frameCounter.GetFrame();
+				pass.framebuffer = cachedFramebuffer.framebuffer;
+				return true;
+			}
+		}
+
+		VkFramebufferCreateInfo framebufferCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+			nullptr,
+			0,
+			pass.renderPass,
+			static_cast<uint32_t>(imageViews.size()),
+			imageViews.data(),
+			pass.extent.width,
+			pass.extent.height,
+			1
+		};
+
+		CachedFramebuffer cachedFramebuffer;
+		cachedFramebuffer.renderPass = pass.renderPass;
+		cachedFramebuffer.imageViews = imageViews;
+		cachedFramebuffer.extent = pass.extent;
+		cachedFramebuffer.lastUsedFrame = m_device->GetDevice()->frameCounter.GetFrame();
+
+		if (vkCreateFramebuffer(m_device->GetDevice()->logicalDevice, &framebufferCreateInfo, nullptr, &cachedFramebuffer.framebuffer) != VK_SUCCESS)
+			return false;
+
+		m_renderGraph->framebuffers.push_back(cachedFramebuffer);
+		pass.framebuffer = cachedFramebuffer.framebuffer;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::ReleaseTransientImages(bool retire)
+	{
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		for (const TransientImage& image : m_renderGraph->transientImages)
+		{
+			if (retire)
+			{
+				m_renderGraph->retiredImages.Push(m_device->GetDevice()->frameCounter, std::make_pair(image.image, image.imageView));
+				continue;
+			}
+
+			if (image.imageView != VK_NULL_HANDLE)
+				vkDestroyImageView(logicalDevice, image.imageView, nullptr);
+
+			if (image.image != VK_NULL_HANDLE)
+				vkDestroyImage(logicalDevice, image.image, nullptr);
+		}
+
+		for (const MemorySlot& slot : m_renderGraph->memorySlots)
+		{
+			if (slot.allocation.memory == VK_NULL_HANDLE)
+				continue;
+
+			if (retire)
+				m_renderGraph->retiredAllocations.Push(m_device->GetDevice()->frameCounter, slot.allocation);
+			else
+				m_renderGraph->allocator.Free(slot.allocation);
+		}
+
+		m_renderGraph->transientImages.clear();
+		m_renderGraph->memorySlots.clear();
+		m_renderGraph->transientSize = 0;
+		m_renderGraph->unaliasedSize = 0;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::ReleaseRetired(bool all)
+	{
+		const VkDevice& logicalDevice = m_device->GetDevice()->logicalDevice;
+
+		auto releaseImage = [&logicalDevice](std::pair<VkImage, VkImageView>& image)
+		{
+			if (image.second != VK_NULL_HANDLE)
+				vkDestroyImageView(logicalDevice, image.second, nullptr);
+
+			if (image.first != VK_NULL_HANDLE)
+				vkDestroyImage(logicalDevice, image.first, nullptr);
+		};
+
+		auto releaseAllocation = [this](MemoryAllocation& allocation)
+		{
+			m_renderGraph->allocator.Free(allocation);
+		};
+
+		if (all)
+		{
+			m_renderGraph->retiredImages.ReleaseAll(releaseImage);
+			m_renderGraph->retiredAllocations.ReleaseAll(releaseAllocation);
+		}
+		else
+		{
+			m_renderGraph->retiredImages.Release(m_device->GetDevice()->frameCounter, releaseImage);
+			m_renderGraph->retiredAllocations.Release(m_device->GetDevice()->frameCounter, releaseAllocation);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool RenderGraph::IsLastSubpass(uint32_t pass) const
+	{
+		const std::vector<Pass>& passes = m_renderGraph->passes;
+
+		return (pass + 1 == passes.size()) || (passes[pass + 1].group != passes[pass].group);
+	}
+
+	//-------------------------------------------------------------------------
+
+	uint32_t RenderGraph::FindAttachment(const std::vector<Attachment>& attachments, uint32_t resource)
+	{
+		for (uint32_t i = 0; i < attachments.size(); i++)
+		{
+			if (attachments[i].resource == resource)
+				return i;
+		}
+
+		return InvalidHandle;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::UpdateState(ResourceState& state, const ResourceUse& use, bool visible, bool image)
+	{
+		if (use.write)
+		{
+			state.writeStages = use.stages;
+			state.writeAccess = use.access;
+			state.readStages = 0;
+			state.visibleStages = 0;
+			state.visibleAccess = 0;
+			state.written = true;
+		}
+		else
+		{
+			state.readStages |= use.stages;
+
+			if (visible)
+			{
+				state.visibleStages |= use.stages;
+				state.visibleAccess |= use.access;
+			}
+		}
+
+		if (image)
+			state.layout = use.layout;
+	}
+
+	//-------------------------------------------------------------------------
+
+	void RenderGraph::GetLayoutAccess(VkImageLayout layout, VkAccessFlags& access, VkPipelineStageFlags& stages)
+	{
+		switch (layout)
+		{
+		case VK_IMAGE_LAYOUT_UNDEFINED:
+			access = 0;
+			stages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+			access = VK_ACCESS_TRANSFER_WRITE_BIT;
+			stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+			access = VK_ACCESS_TRANSFER_READ_BIT;
+			stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+			access = VK_ACCESS_SHADER_READ_BIT;
+			stages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+			access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+			access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+			access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+			stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+			access = 0;
+			stages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+			break;
+		default:
+			access = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+			stages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+			break;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	VkImageUsageFlags RenderGraph::GetLayoutUsage(VkImageLayout layout)
+	{
+		switch (layout)
+		{
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+			return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+			return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+			return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+			return VK_IMAGE_USAGE_SAMPLED_BIT;
+		case VK_IMAGE_LAYOUT_GENERAL:
+			return VK_IMAGE_USAGE_STORAGE_BIT;
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+			return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+			return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		default:
+			return 0;
+		}
+	}
+}
\ No newline at end of file
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <vector>
+
 #include <Neon/Core/File.hpp>
 #include <Neon/Core/SmartDeleter.hpp>
 #include <Neon/Renderer/SwapChain.hpp>
@@ -6,6 +9,12 @@
 
 namespace Zx
 {
+	namespace
+	{
+		// The albedo keeps 8 bits per channel, the normal needs more precision than 8 bits to light smooth surfaces
+		const VkFormat GBufferFormats[] = { VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R16G16B16A16_SFLOAT };
+	}
+
 	/*
 	@brief : Creates a render pass
 	@param : The device of the application
@@ -15,8 +24,58 @@ namespace Zx
 	{
 		m_device = std::make_shared<Device>(device);
 		m_swapChain = std::make_shared<SwapChain>(swapChain);
+		m_attachments = std::make_shared<Attachments>();
+		m_attachments->info.depth = false;
 
-		if (!CreateRenderPass())
+		if (!CreateAttachments() || !CreateRenderPass())
+			std::cout << "Failed to create a render pass" << std::endl;
+
+		device = std::move(*m_device);
+		swapChain = std::move(*m_swapChain);
+	}
+
+	/*
+	@brief : Creates a render pass with a depth attachment, optionally written by a depth pre-pass, and optionally multisampled or deferred
+	@param : The device of the application
+	@param : The swapChain of the application
+	@param : The allocator giving the memory of the depth and multisampled attachments
+	@param : The description of the render pass
+	*/
+	RenderPass::RenderPass(Device& device, SwapChain& swapChain, MemoryAllocator& allocator, const RenderPassInfo& info) : m_renderPass(VK_NULL_HANDLE)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_swapChain = std::make_shared<SwapChain>(swapChain);
+		m_attachments = std::make_shared<Attachments>();
+		m_attachments->allocator = MemoryAllocator(allocator);
+		m_attachments->info = info;
+
+		if (info.depth)
+		{
+			m_attachments->depthFormat = FindDepthFormat();
+
+			if (m_attachments->depthFormat == VK_FORMAT_UNDEFINED)
+				std::cout << "No depth format is supported, the render pass has no depth" << std::endl;
+		}
+
+		// The lighting subpass rebuilds the positions from the depth, the G-buffer subpass takes the place of the pre-pass
+		if (info.deferred && !HasDepth())
+		{
+			std::cout << "The deferred path needs a depth attachment, the render pass is forward" << std::endl;
+			m_attachments->info.deferred = false;
+		}
+		else if (info.deferred)
+		{
+			m_attachments->info.depthPrePass = false;
+			m_attachments->info.samples = VK_SAMPLE_COUNT_1_BIT;
+			m_attachments->gBufferImages.resize(sizeof(GBufferFormats) / sizeof(VkFormat));
+		}
+
+		m_attachments->samples = FindSampleCount(m_attachments->info.samples);
+
+		if (m_attachments->samples != m_attachments->info.samples)
+			std::cout << "The sample count is lowered to " << m_attachments->samples << ", the highest one the device supports" << std::endl;
+
+		if (!CreateAttachments() || !CreateRenderPass())
 			std::cout << "Failed to create a render pass" << std::endl;
 
 		device = std::move(*m_device);
@@ -27,53 +86,220 @@ namespace Zx
 	@brief : Copy constructor
 	@param : A constant reference to the RenderPass to copy
 	*/
-	RenderPass::RenderPass(const RenderPass& rend) : m_swapChain(rend.m_swapChain), m_device(rend.m_device), m_renderPass(rend.m_renderPass)
+	RenderPass::RenderPass(const RenderPass& rend) : m_swapChain(rend.m_swapChain), m_device(rend.m_device), m_attachments(rend.m_attachments), m_renderPass(rend.m_renderPass)
 	{}
 
 	/*
-	@brief : Destroys a render pass
+	@brief : Destroys a render pass, the Vulkan render pass belongs to the render graph and goes away with the last copy sharing it
 	*/
 	RenderPass::~RenderPass()
+	{}
+
+	/*
+	@brief : Creates the depth and multisampled color attachments at the extent of the swap chain, to call again once the swap chain is recreated
+	@return : Returns true if the attachments are created or the render pass has none, false otherwise
+	*/
+	bool RenderPass::CreateAttachments()
 	{
-		if (m_renderPass != VK_NULL_HANDLE)
+		if (m_attachments == nullptr)
+			return true;
+
+		// The device is not waited, the previous attachments are destroyed by BeginFrame once no frame in flight uses them
+		RetireImage(m_attachments->colorImage);
+		RetireImage(m_attachments->depthImage);
+
+		for (Image& gBufferImage : m_attachments->gBufferImages)
+			RetireImage(gBufferImage);
+
+		VkImageUsageFlags transientUsage = m_attachments->info.transientAttachments ? VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT : 0;
+
+		// The framebuffers holding the previous attachments are recreated every frame
+		const VkExtent2D& extent = m_swapChain->GetSwapChain()->extent;
+
+		if (GetSampleCount() != VK_SAMPLE_COUNT_1_BIT)
+		{
+			m_attachments->colorImage = Image(*m_device, m_attachments->allocator, extent.width, extent.height, m_swapChain->GetSwapChain()->format,
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | transientUsage, 1, VK_IMAGE_ASPECT_COLOR_BIT, GetSampleCount());
+
+			if (!m_attachments->colorImage.IsValid())
+			{
+				std::cout << "Failed to create multisampled color attachment" << std::endl;
+				return false;
+			}
+		}
+
+		for (uint32_t i = 0; i < m_attachments->gBufferImages.size(); i++)
+		{
+			m_attachments->gBufferImages[i] = Image(*m_device, m_attachments->allocator, extent.width, extent.height, GBufferFormats[i],
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT | transientUsage);
+
+			if (!m_attachments->gBufferImages[i].IsValid())
+			{
+				std::cout << "Failed to create G-buffer attachment" << std::endl;
+				return false;
+			}
+		}
+
+		if (!HasDepth())
+			return true;
+
+		VkImageAspectFlags aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+		if ((m_attachments->depthFormat == VK_FORMAT_D32_SFLOAT_S8_UINT) || (m_attachments->depthFormat == VK_FORMAT_D24_UNORM_S8_UINT))
+			aspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+
+		m_attachments->depthImage = Image(*m_device, m_attachments->allocator, extent.width, extent.height, m_attachments->depthFormat,
+			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | (IsDeferred() ? VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT : 0) | transientUsage, 1, aspect, GetSampleCount());
+
+		if (!m_attachments->depthImage.IsValid())
 		{
-			vkDestroyRenderPass(m_device->GetDevice()->logicalDevice, m_renderPass, nullptr);
-			m_renderPass = VK_NULL_HANDLE;
+			std::cout << "Failed to create depth attachment" << std::endl;
+			return false;
 		}
+
+		return true;
 	}
 
 	/*
-	@brief : Creates a framebuffer
-	@param : Returns true if the creation is a success, false otherwise
+	@brief : Starts the render graph of a frame with the swap chain image and the attachments of the render pass imported in it
+	@param : The index of the swap chain image the frame draws to
+	@return : A reference to the graph, the passes of the frame are declared on it before DeclareSubpasses
 	*/
-	bool RenderPass::CreateFramebuffer(VkFramebuffer& framebuffer, VkImageView imageView)
+	RenderGraph& RenderPass::DeclareFrame(uint32_t imageIndex)
 	{
-		if (framebuffer != VK_NULL_HANDLE)
+		RenderGraph& renderGraph = m_attachments->renderGraph;
+		const auto& swapChain = m_swapChain->GetSwapChain();
+
+		renderGraph.Reset(swapChain->extent);
+
+		RenderGraphImageInfo info;
+		info.format = swapChain->format;
+		info.width = swapChain->extent.width;
+		info.height = swapChain->extent.height;
+
+		// The swap chain image waits for the acquire semaphore at the color output stage, it is presented after the graph
+		m_attachments->swapChainAttachment = renderGraph.ImportImage(swapChain->image[imageIndex], swapChain->imageView[imageIndex], info, VK_IMAGE_LAYOUT_UNDEFINED,
+			VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+		// The other attachments are shared by the frames in flight, a frame waits for the previous one to be done with them and their contents are never kept
+		if (GetSampleCount() != VK_SAMPLE_COUNT_1_BIT)
 		{
-			vkDestroyFramebuffer(m_device->GetDevice()->logicalDevice, framebuffer, nullptr);
-			framebuffer = VK_NULL_HANDLE;
+			info.samples = GetSampleCount();
+
+			m_attachments->colorAttachment = renderGraph.ImportImage(m_attachments->colorImage.GetImage(), m_attachments->colorImage.GetImageView(), info,
+				VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
 		}
 
-		VkFramebufferCreateInfo frameBufferCreateInfo =
+		m_attachments->gBufferAttachments.clear();
+
+		for (uint32_t i = 0; i < GetGBufferCount(); i++)
 		{
-			VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-			nullptr,
-			0,
-			m_renderPass,
-			1,
-			&imageView,
-			m_swapChain->GetSwapChain()->extent.width,
-			m_swapChain->GetSwapChain()->extent.height,
-			1
+			const Image& gBufferImage = m_attachments->gBufferImages[i];
+
+			info.format = gBufferImage.GetFormat();
+			info.samples = VK_SAMPLE_COUNT_1_BIT;
+
+			m_attachments->gBufferAttachments.push_back(renderGraph.ImportImage(gBufferImage.GetImage(), gBufferImage.GetImageView(), info, VK_IMAGE_LAYOUT_UNDEFINED,
+				VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+		}
+
+		if (!HasDepth())
+			return renderGraph;
+
+		const Image& depthImage = m_attachments->depthImage;
+
+		info.format = depthImage.GetFormat();
+		info.aspect = depthImage.GetAspect();
+		info.samples = depthImage.GetSampleCount();
+
+		// The lighting subpass of the previous frame reads the depth as an input attachment
+		VkPipelineStageFlags depthStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
+			| (IsDeferred() ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : 0);
+
+		m_attachments->depthAttachment = renderGraph.ImportImage(depthImage.GetImage(), depthImage.GetImageView(), info, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_UNDEFINED,
+			depthStages, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+
+		return renderGraph;
+	}
+
+	/*
+	@brief : Declares the subpasses of the render pass on the graph of the frame, the depth pre-pass or the geometry subpass comes first
+	@param : The function recording the commands of a subpass, given its index
+	@param : The color the swap chain image is cleared to
+	@return : The handle of the first subpass in the graph
+	*/
+	uint32_t RenderPass::DeclareSubpasses(const std::function<void(VkCommandBuffer, uint32_t)>& record, const VkClearColorValue& clearColor)
+	{
+		RenderGraph& renderGraph = m_attachments->renderGraph;
+
+		auto recordSubpass = [record](uint32_t subpass)
+		{
+			return [record, subpass](VkCommandBuffer commandBuffer)
+			{
+				if (record)
+					record(commandBuffer, subpass);
+			};
 		};
 
-		if (vkCreateFramebuffer(m_device->GetDevice()->logicalDevice, &frameBufferCreateInfo, nullptr, &framebuffer) != VK_SUCCESS)
+		const VkClearColorValue gBufferClearColor = {};
+		const VkClearDepthStencilValue clearDepth = { 1.0f, 0 };
+
+		// The geometry subpass fills the G-buffer, the lighting subpass shades each pixel once from the G-buffer and the depth
+		if (IsDeferred())
 		{
-			std::cout << "Failed to create frame buffer" << std::endl;
-			return false;
+			uint32_t geometry = renderGraph.AddPass(true, recordSubpass(0));
+
+			for (uint32_t gBufferAttachment : m_attachments->gBufferAttachments)
+				renderGraph.AddColorAttachment(geometry, gBufferAttachment, &gBufferClearColor);
+
+			renderGraph.SetDepthAttachment(geometry, m_attachments->depthAttachment, &clearDepth);
+
+			uint32_t lighting = renderGraph.AddSubpass(geometry, recordSubpass(1));
+
+			for (uint32_t gBufferAttachment : m_attachments->gBufferAttachments)
+				renderGraph.AddInputAttachment(lighting, gBufferAttachment);
+
+			renderGraph.AddInputAttachment(lighting, m_attachments->depthAttachment);
+			renderGraph.AddColorAttachment(lighting, m_attachments->swapChainAttachment, &clearColor);
+
+			return geometry;
 		}
 
-		return true;
+		uint32_t first = RenderGraph::InvalidHandle;
+
+		// The pre-pass has no color attachment, the color subpass then tests against its depth without writing it
+		if (HasDepthPrePass())
+		{
+			first = renderGraph.AddPass(true, recordSubpass(0));
+			renderGraph.SetDepthAttachment(first, m_attachments->depthAttachment, &clearDepth);
+		}
+
+		uint32_t color = (first != RenderGraph::InvalidHandle) ? renderGraph.AddSubpass(first, recordSubpass(1)) : renderGraph.AddPass(true, recordSubpass(0));
+
+		// A multisampled subpass draws in its own color attachment, the samples are resolved in the swap chain image at its end
+		if (GetSampleCount() != VK_SAMPLE_COUNT_1_BIT)
+			renderGraph.AddColorAttachment(color, m_attachments->colorAttachment, &clearColor, m_attachments->swapChainAttachment);
+		else
+			renderGraph.AddColorAttachment(color, m_attachments->swapChainAttachment, &clearColor);
+
+		if (HasDepthPrePass())
+			renderGraph.SetDepthAttachment(color, m_attachments->depthAttachment, nullptr, true);
+		else if (HasDepth())
+			renderGraph.SetDepthAttachment(color, m_attachments->depthAttachment, &clearDepth);
+
+		return (first != RenderGraph::InvalidHandle) ? first : color;
+	}
+
+	/*
+	@brief : Destroys the attachments retired by frames which are now over, to call once the Device began the frame
+	*/
+	void RenderPass::BeginFrame()
+	{
+		if (m_attachments == nullptr)
+			return;
+
+		// The images are destroyed with their last copy
+		m_attachments->retiredImages.Release(m_device->GetDevice()->frameCounter, [](Image&) {});
 	}
 
 	/*
@@ -86,93 +312,80 @@ namespace Zx
 		std::swap(m_device, renderPass.m_device);
 		std::swap(m_renderPass, renderPass.m_renderPass);
 		std::swap(m_swapChain, renderPass.m_swapChain);
+		std::swap(m_attachments, renderPass.m_attachments);
 
 		return (*this);
 	}
 
 	//---------------------------Private method---------------------------
-	bool RenderPass::CreateRenderPass()
+	void RenderPass::RetireImage(Image& image)
 	{
-		VkAttachmentDescription attachmentDescription[] =
-		{
-			{
-				0,
-				m_swapChain->GetSwapChain()->format,
-				VK_SAMPLE_COUNT_1_BIT, // nombre d'chantillon(s) de l'image
-				VK_ATTACHMENT_LOAD_OP_CLEAR,
-				VK_ATTACHMENT_STORE_OP_STORE,
-				VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-				VK_ATTACHMENT_STORE_OP_DONT_CARE,
-				VK_IMAGE_LAYOUT_UNDEFINED,
-				VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
-			}
-		};
+		if (!image.IsValid())
+			return;
 
-		VkAttachmentReference colorAttachmentReference[] =
-		{
-			{
-				0,
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-			}
-		};
+		m_attachments->retiredImages.Push(m_device->GetDevice()->frameCounter, image);
+		image = Image();
+	}
 
-		VkSubpassDescription subpassDescription[] =
-		{
-			{
-				0,
-				VK_PIPELINE_BIND_POINT_GRAPHICS,
-				0,
-				nullptr,
-				1,
-				colorAttachmentReference,
-				nullptr,
-				nullptr,
-				0,
-				nullptr
-			}
-		};
+	//-------------------------------------------------------------------------
 
-		std::vector<VkSubpassDependency> subpassDependency =
-		{
-			{
-				VK_SUBPASS_EXTERNAL,
-				0,
-				VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-				VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-				VK_ACCESS_MEMORY_READ_BIT,
-				VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-				VK_DEPENDENCY_BY_REGION_BIT
-			},
-			{
-				0,
-				VK_SUBPASS_EXTERNAL,
-				VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-				VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-				VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-				VK_ACCESS_MEMORY_READ_BIT,
-				VK_DEPENDENCY_BY_REGION_BIT
-			}
-		};
+	bool RenderPass::CreateRenderPass()
+	{
+		m_attachments->renderGraph = RenderGraph(*m_device, m_attachments->allocator);
 
-		VkRenderPassCreateInfo renderPassCreateInfo =
-		{
-			VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-			nullptr,
-			0,
-			1,
-			attachmentDescription,
-			1,
-			subpassDescription,
-			static_cast<uint32_t>(subpassDependency.size()),
-			subpassDependency.data()
-		};
+		// The render pass of the pipelines is the one the graph compiles for the frames, the subpasses are declared without commands
+		RenderGraph& renderGraph = DeclareFrame(0);
+		uint32_t pass = DeclareSubpasses(std::function<void(VkCommandBuffer, uint32_t)>(), {});
 
-		if (vkCreateRenderPass(m_device->GetDevice()->logicalDevice, &renderPassCreateInfo, nullptr, &m_renderPass) != VK_SUCCESS)
+		if (!renderGraph.Compile())
 		{
 			std::cout << "Failed to create render pass" << std::endl;
 			return false;
 		}
 
+		m_renderPass = renderGraph.GetRenderPass(pass);
+
 		return true;
 	}
+
+	//-------------------------------------------------------------------------
+
+	VkFormat RenderPass::FindDepthFormat() const
+	{
+		// The first format is the most precise, the others keep a stencil with the depth
+		const VkFormat depthFormats[] = { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT };
+
+		for (VkFormat depthFormat : depthFormats)
+		{
+			VkFormatProperties formatProperties;
+			vkGetPhysicalDeviceFormatProperties(m_device->GetDevice()->physicalDevice, depthFormat, &formatProperties);
+
+			if ((formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0)
+				return depthFormat;
+		}
+
+		return VK_FORMAT_UNDEFINED;
+	}
+
+	//-------------------------------------------------------------------------
+
+	VkSampleCountFlagBits RenderPass::FindSampleCount(VkSampleCountFlagBits samples) const
+	{
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		VkSampleCountFlags sampleCounts = deviceProperties.limits.framebufferColorSampleCounts;
+
+		if (HasDepth())
+			sampleCounts &= deviceProperties.limits.framebufferDepthSampleCounts;
+
+		// The counts are powers of two, the highest one supported below the requested one is kept
+		for (uint32_t count = samples; count > VK_SAMPLE_COUNT_1_BIT; count >>= 1)
+		{
+			if ((sampleCounts & count) != 0)
+				return static_cast<VkSampleCountFlagBits>(count);
+		}
+
+		return VK_SAMPLE_COUNT_1_BIT;
+	}
 }
\ No newline at end of file
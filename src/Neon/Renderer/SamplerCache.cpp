@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <iostream>
+
+#include <Neon/Core/Hash.hpp>
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/SamplerCache.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates an empty cache of samplers
+	@param : A reference to the Device
+	*/
+	SamplerCache::SamplerCache(Device& device)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_samplerCache = std::make_shared<SamplerCaches>();
+
+		if (m_device->GetDevice()->samplerAnisotropy)
+		{
+			VkPhysicalDeviceProperties deviceProperties;
+			vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+			m_samplerCache->maxAnisotropy = deviceProperties.limits.maxSamplerAnisotropy;
+		}
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the samplers of the cache
+	@param : A constant reference to the SamplerCache to copy
+	*/
+	SamplerCache::SamplerCache(const SamplerCache& samplerCache) : m_device(samplerCache.m_device), m_samplerCache(samplerCache.m_samplerCache)
+	{}
+
+	/*
+	@brief : Destroys every cached sampler once the last owner of the cache goes away
+	*/
+	SamplerCache::~SamplerCache()
+	{
+		if ((m_samplerCache == nullptr) || (m_samplerCache.use_count() > 1))
+			return;
+
+		for (auto& sampler : m_samplerCache->samplers)
+			vkDestroySampler(m_device->GetDevice()->logicalDevice, sampler.second, nullptr);
+
+		m_samplerCache->samplers.clear();
+	}
+
+	/*
+	@brief : Gets the sampler matching a description, it is only created the first time it is asked
+	@param : The description of the sampler
+	@return : Returns the sampler, VK_NULL_HANDLE if it could not be created
+	*/
+	VkSampler SamplerCache::GetSampler(const SamplerInfo& info)
+	{
+		// The description is clamped first so requests above the limit of the device share the same sampler
+		SamplerInfo key = info;
+		key.maxAnisotropy = std::min(key.maxAnisotropy, m_samplerCache->maxAnisotropy);
+
+		if (key.maxAnisotropy <= 1.0f)
+			key.maxAnisotropy = 1.0f;
+
+		auto it = m_samplerCache->samplers.find(key);
+		if (it != m_samplerCache->samplers.end())
+			return it->second;
+
+		VkSamplerCreateInfo samplerCreateInfo =
+		{
+			VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+			nullptr,
+			0,
+			key.magFilter,
+			key.minFilter,
+			key.mipmapMode,
+			key.addressMode,
+			key.addressMode,
+			key.addressMode,
+			0.0f,
+			(key.maxAnisotropy > 1.0f) ? VK_TRUE : VK_FALSE,
+			key.maxAnisotropy,
+			key.compareEnable ? VK_TRUE : VK_FALSE,
+			key.compareOp,
+			0.0f,
+			key.maxLod,
+			VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
+			VK_FALSE
+		};
+
+		VkSampler sampler = VK_NULL_HANDLE;
+		if (vkCreateSampler(m_device->GetDevice()->logicalDevice, &samplerCreateInfo, nullptr, &sampler) != VK_SUCCESS)
+		{
+			std::cout << "Failed to create sampler" << std::endl;
+			return VK_NULL_HANDLE;
+		}
+
+		m_samplerCache->samplers.emplace(key, sampler);
+
+		return sampler;
+	}
+
+	/*
+	@brief : Assigns the cache by move semantic
+	@param : The cache to move
+	@return : A reference to this
+	*/
+	SamplerCache& SamplerCache::operator=(SamplerCache&& samplerCache) noexcept
+	{
+		std::swap(m_device, samplerCache.m_device);
+		std::swap(m_samplerCache, samplerCache.m_samplerCache);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	std::size_t SamplerCache::SamplerInfoHash::operator()(const SamplerInfo& info) const
+	{
+		std::size_t seed = 0;
+
+		HashCombine(seed, static_cast<uint32_t>(info.magFilter));
+		HashCombine(seed, static_cast<uint32_t>(info.minFilter));
+		HashCombine(seed, static_cast<uint32_t>(info.mipmapMode));
+		HashCombine(seed, static_cast<uint32_t>(info.addressMode));
+		HashCombine(seed, info.maxAnisotropy);
+		HashCombine(seed, info.maxLod);
+		HashCombine(seed, static_cast<uint32_t>(info.compareOp));
+		HashCombine(seed, info.compareEnable);
+
+		return seed;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool SamplerInfo::operator==(const SamplerInfo& info) const
+	{
+		return (magFilter == info.magFilter) && (minFilter == info.minFilter) && (mipmapMode == info.mipmapMode) && (addressMode == info.addressMode)
+			&& (maxAnisotropy == info.maxAnisotropy) && (maxLod == info.maxLod) && (compareOp == info.compareOp) && (compareEnable == info.compareEnable);
+	}
+}
\ No newline at end of file
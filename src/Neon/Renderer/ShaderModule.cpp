@@ -1,3 +1,7 @@
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <Neon/Core/File.hpp>
 #include <Neon/Core/SmartDeleter.hpp>
 #include <Neon/Renderer/Device.hpp>
@@ -36,4 +40,206 @@ namespace Zx
 
 		return SmartDeleter<VkShaderModule, PFN_vkDestroyShaderModule>(shaderModule, vkDestroyShaderModule, device.GetDevice()->logicalDevice);
 	}
+
+	/*
+	@brief : Reads the descriptor bindings declared by a spv file and merges them into the bindings of other stages
+	@param : The spv file
+	@param : The stage of the shader
+	@param : The bindings of each set, a binding used by several stages gets all of them
+	@return : Returns true if the file could be read, false otherwise
+	*/
+	bool ReflectDescriptorBindings(const String& filename, VkShaderStageFlags stage, std::map<uint32_t, std::vector<VkDescriptorSetLayoutBinding>>& sets)
+	{
+		File file(filename);
+
+		return ReflectDescriptorBindings(file.GetBinaryFileContent(), stage, sets);
+	}
+
+	/*
+	@brief : Reads the descriptor bindings declared by some SPIR-V code and merges them into the bindings of other stages
+	@param : The SPIR-V code
+	@param : The stage of the shader
+	@param : The bindings of each set, a binding used by several stages gets all of them
+	@return : Returns true if the code could be read, false otherwise
+	*/
+	bool ReflectDescriptorBindings(const std::vector<char>& code, VkShaderStageFlags stage, std::map<uint32_t, std::vector<VkDescriptorSetLayoutBinding>>& sets)
+	{
+		// Opcodes, decorations and storage classes from the SPIR-V specification
+		enum : uint32_t
+		{
+			OpTypeImage = 25, OpTypeSampler = 26, OpTypeSampledImage = 27, OpTypeArray = 28, OpTypeRuntimeArray = 29, OpTypePointer = 32,
+			OpConstant = 43, OpVariable = 59, OpDecorate = 71,
+			DecorationBufferBlock = 3, DecorationBinding = 33, DecorationDescriptorSet = 34,
+			StorageUniformConstant = 0, StorageUniform = 2, StorageStorageBuffer = 12,
+			DimBuffer = 5, DimSubpassData = 6
+		};
+
+		if ((code.size() < 5 * sizeof(uint32_t)) || (code.size() % sizeof(uint32_t) != 0))
+		{
+			std::cout << "Invalid SPIR-V code size" << std::endl;
+			return false;
+		}
+
+		std::vector<uint32_t> words(code.size() / sizeof(uint32_t));
+		std::memcpy(words.data(), code.data(), code.size());
+
+		if (words[0] != 0x07230203)
+		{
+			std::cout << "Invalid SPIR-V magic number" << std::endl;
+			return false;
+		}
+
+		struct Variable
+		{
+			uint32_t type;
+			uint32_t storage;
+		};
+
+		std::unordered_map<uint32_t, std::vector<uint32_t>> types;
+		std::unordered_map<uint32_t, uint32_t> constants;
+		std::unordered_map<uint32_t, uint32_t> bindings;
+		std::unordered_map<uint32_t, uint32_t> descriptorSets;
+		std::unordered_set<uint32_t> bufferBlocks;
+		std::unordered_map<uint32_t, Variable> variables;
+
+		for (std::size_t i = 5; i < words.size();)
+		{
+			uint32_t opcode = words[i] & 0xFFFF;
+			uint32_t wordCount = words[i] >> 16;
+
+			if ((wordCount == 0) || (i + wordCount > words.size()))
+			{
+				std::cout << "Invalid SPIR-V instruction" << std::endl;
+				return false;
+			}
+
+			const uint32_t* operands = &words[i + 1];
+
+			switch (opcode)
+			{
+			case OpDecorate:
+				if ((operands[1] == DecorationBinding) && (wordCount > 3))
+					bindings[operands[0]] = operands[2];
+				else if ((operands[1] == DecorationDescriptorSet) && (wordCount > 3))
+					descriptorSets[operands[0]] = operands[2];
+				else if (operands[1] == DecorationBufferBlock)
+					bufferBlocks.insert(operands[0]);
+				break;
+			case OpTypeImage:
+			case OpTypeSampler:
+			case OpTypeSampledImage:
+			case OpTypeArray:
+			case OpTypeRuntimeArray:
+			case OpTypePointer:
+				types[operands[0]] = std::vector<uint32_t>(&words[i], &words[i] + wordCount);
+				break;
+			case OpConstant:
+				constants[operands[1]] = operands[2];
+				break;
+			case OpVariable:
+				variables[operands[1]] = { operands[0], operands[2] };
+				break;
+			}
+
+			i += wordCount;
+		}
+
+		for (const auto& variable : variables)
+		{
+			uint32_t storage = variable.second.storage;
+
+			if (((storage != StorageUniformConstant) && (storage != StorageUniform) && (storage != StorageStorageBuffer))
+				|| (bindings.count(variable.first) == 0))
+				continue;
+
+			auto pointer = types.find(variable.second.type);
+			if ((pointer == types.end()) || ((pointer->second[0] & 0xFFFF) != OpTypePointer))
+				continue;
+
+			// Arrays of resources become one binding with several descriptors, 0 descriptor for a runtime array
+			uint32_t typeId = pointer->second[3];
+			uint32_t descriptorCount = 1;
+
+			for (auto type = types.find(typeId); type != types.end(); type = types.find(typeId))
+			{
+				uint32_t opcode = type->second[0] & 0xFFFF;
+
+				if (opcode == OpTypeArray)
+					descriptorCount *= constants.count(type->second[3]) ? constants[type->second[3]] : 1;
+				else if (opcode == OpTypeRuntimeArray)
+					descriptorCount = 0;
+				else
+					break;
+
+				typeId = type->second[2];
+			}
+
+			VkDescriptorType descriptorType;
+			auto type = types.find(typeId);
+			uint32_t opcode = (type != types.end()) ? (type->second[0] & 0xFFFF) : 0;
+
+			if (storage == StorageStorageBuffer)
+				descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			else if (storage == StorageUniform)
+				descriptorType = bufferBlocks.count(typeId) ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+			else if (opcode == OpTypeSampler)
+				descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+			else if (opcode == OpTypeSampledImage)
+			{
+				auto image = types.find(type->second[2]);
+				bool isBuffer = (image != types.end()) && (image->second[3] == DimBuffer);
+
+				descriptorType = isBuffer ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			}
+			else if (opcode == OpTypeImage)
+			{
+				uint32_t dim = type->second[3];
+				bool isStorage = type->second[7] == 2;
+
+				if (dim == DimSubpassData)
+					descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+				else if (dim == DimBuffer)
+					descriptorType = isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+				else
+					descriptorType = isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+			}
+			else
+				continue;
+
+			uint32_t set = descriptorSets.count(variable.first) ? descriptorSets[variable.first] : 0;
+			uint32_t binding = bindings[variable.first];
+
+			std::vector<VkDescriptorSetLayoutBinding>& setBindings = sets[set];
+
+			bool isMerged = false;
+			for (VkDescriptorSetLayoutBinding& setBinding : setBindings)
+			{
+				if (setBinding.binding != binding)
+					continue;
+
+				if (setBinding.descriptorType != descriptorType)
+				{
+					std::cout << "Binding " << binding << " of set " << set << " is declared with different types" << std::endl;
+					return false;
+				}
+
+				setBinding.stageFlags |= stage;
+				isMerged = true;
+			}
+
+			if (!isMerged)
+			{
+				setBindings.push_back(
+				{
+					binding,
+					descriptorType,
+					descriptorCount,
+					stage,
+					nullptr
+				});
+			}
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
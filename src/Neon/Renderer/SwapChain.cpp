@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <Neon/Core/Exception.hpp>
 #include <Neon/Renderer/Device.hpp>
 #include <Neon/Renderer/Window.hpp>
@@ -5,6 +7,58 @@
 
 namespace Zx
 {
+	/*
+	@brief : Presents as soon as a frame is done, tearing included, to measure the throughput
+	@return : The description of the swap chain
+	*/
+	SwapChainInfo SwapChainInfo::Uncapped()
+	{
+		SwapChainInfo info;
+		info.presentModes = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR };
+		info.imageCount = 3;
+
+		return info;
+	}
+
+	/*
+	@brief : Presents the latest frame at the next vertical blank without tearing, the frames in between are dropped
+	@return : The description of the swap chain
+	*/
+	SwapChainInfo SwapChainInfo::LowLatency()
+	{
+		SwapChainInfo info;
+		info.presentModes = { VK_PRESENT_MODE_MAILBOX_KHR };
+		info.imageCount = 3;
+
+		return info;
+	}
+
+	/*
+	@brief : Presents every frame at a vertical blank, the rendering waits on the display and saves power
+	@return : The description of the swap chain
+	*/
+	SwapChainInfo SwapChainInfo::VSync()
+	{
+		SwapChainInfo info;
+		info.presentModes = { VK_PRESENT_MODE_FIFO_KHR };
+		info.imageCount = 2;
+
+		return info;
+	}
+
+	/*
+	@brief : Like VSync, a late frame is presented at once and tears instead of waiting for the next vertical blank
+	@return : The description of the swap chain
+	*/
+	SwapChainInfo SwapChainInfo::AdaptiveVSync()
+	{
+		SwapChainInfo info;
+		info.presentModes = { VK_PRESENT_MODE_FIFO_RELAXED_KHR };
+		info.imageCount = 3;
+
+		return info;
+	}
+
 	/*
 	@brief : Constructor with the needed informations
 	@param : The device of the application
@@ -36,19 +90,27 @@ namespace Zx
 	}
 
 	/*
-	@brief : Destroys SwapChain
+	@brief : Destroys SwapChain, its image views and the retired swap chains once the last owner goes away
 	*/
 	SwapChain::~SwapChain()
 	{
-		if (m_swapChain->swapChain != VK_NULL_HANDLE)
+		if ((m_swapChain == nullptr) || (m_swapChain.use_count() > 1))
+			return;
+
+		m_swapChain->retired.ReleaseAll([this](RetiredSwapChain& retired)
 		{
-			vkDestroySwapchainKHR(m_device->GetDevice()->logicalDevice, m_swapChain->swapChain, nullptr);
-			m_swapChain->swapChain = VK_NULL_HANDLE;
-		}
+			DestroyRetiredSwapChain(retired);
+		});
+
+		RetiredSwapChain current = { m_swapChain->swapChain, m_swapChain->imageView };
+		DestroyRetiredSwapChain(current);
+
+		m_swapChain->swapChain = VK_NULL_HANDLE;
+		m_swapChain->imageView.clear();
 	}
 
 	/*
-	@brief : Creates a swap chain
+	@brief : Creates a swap chain, the previous one is handed to the new one and destroyed once the frames in flight are over, the device is never waited
 	@returns : Returns true if the creation is a success, false otherwise
 	*/
 	bool SwapChain::CreateSwapChain()
@@ -58,9 +120,6 @@ namespace Zx
 
 		m_isRenderAvailable = false;
 
-		if (m_device->GetDevice()->logicalDevice != VK_NULL_HANDLE)
-			vkDeviceWaitIdle(m_device->GetDevice()->logicalDevice);
-
 		VkSurfaceCapabilitiesKHR surfaceCapabilities;	
 		if (vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_device->GetDevice()->physicalDevice, m_window->GetSurface(), &surfaceCapabilities) != VK_SUCCESS)
 		{
@@ -106,12 +165,12 @@ namespace Zx
 
 		//Cration de la swap chain
 
-		uint32_t desiredNumImages = GetSwapChainNumImages(surfaceCapabilities);
+		VkPresentModeKHR desiredPresentMode = GetSwapChainPresentMode(presentModes);
+		uint32_t desiredNumImages = GetSwapChainNumImages(surfaceCapabilities, desiredPresentMode);
 		VkSurfaceFormatKHR desiredSurfaceFormat = GetSwapChainFormat(surfaceFormats);
 		VkExtent2D desiredExtent = GetSwapChainExtent(surfaceCapabilities);
 		VkImageUsageFlags desiredUsageFlags = GetSwapChainUsageFlags(surfaceCapabilities);
 		VkSurfaceTransformFlagBitsKHR desiredSurfaceTransform = GetSwapChainTransform(surfaceCapabilities);
-		VkPresentModeKHR desiredPresentMode = GetSwapChainPresentMode(presentModes);
 		VkSwapchainKHR oldSwapChain = m_swapChain->swapChain;
 
 		if ((static_cast<int>(desiredUsageFlags) == -1) || (static_cast<int>(desiredPresentMode) == -1))
@@ -142,14 +201,23 @@ namespace Zx
 			oldSwapChain
 		};
 
-		if (vkCreateSwapchainKHR(m_device->GetDevice()->logicalDevice, &swapChainInfo, nullptr, &m_swapChain->swapChain) != VK_SUCCESS)
+		VkSwapchainKHR swapChain = VK_NULL_HANDLE;
+
+		if (vkCreateSwapchainKHR(m_device->GetDevice()->logicalDevice, &swapChainInfo, nullptr, &swapChain) != VK_SUCCESS)
 		{
 			std::cout << "Failed to create swap chain" << std::endl;
 			return false;
 		}
 
+		m_swapChain->swapChain = swapChain;
+		m_swapChain->presentMode = desiredPresentMode;
+
+		// The frames in flight may still render to or present the images of the previous swap chain
 		if (oldSwapChain != VK_NULL_HANDLE)
-			vkDestroySwapchainKHR(m_device->GetDevice()->logicalDevice, oldSwapChain, nullptr);
+		{
+			m_swapChain->retired.Push(m_device->GetDevice()->frameCounter, RetiredSwapChain{ oldSwapChain, m_swapChain->imageView });
+			m_swapChain->imageView.clear();
+		}
 
 		m_isRenderAvailable = true;
 
@@ -174,6 +242,29 @@ namespace Zx
 		return CreateSwapChainImageView();
 	}
 
+	/*
+	@brief : Sets the presentation policy, applied by the next CreateSwapChain
+	@param : The description of the swap chain
+	*/
+	void SwapChain::SetInfo(const SwapChainInfo& info)
+	{
+		if (m_swapChain == nullptr)
+			m_swapChain = std::make_shared<SwapChains>();
+
+		m_swapChain->info = info;
+	}
+
+	/*
+	@brief : Destroys the swap chains retired by frames which are now over, to call once the Device began the frame
+	*/
+	void SwapChain::BeginFrame()
+	{
+		m_swapChain->retired.Release(m_device->GetDevice()->frameCounter, [this](RetiredSwapChain& retired)
+		{
+			DestroyRetiredSwapChain(retired);
+		});
+	}
+
 	/*
 	@brief : Assign a SwapChain by move semantic
 	@param : A reference to the SwapChain to move
@@ -190,9 +281,19 @@ namespace Zx
 
 	//-------------------------Private method-------------------------
 
-	uint32_t SwapChain::GetSwapChainNumImages(const VkSurfaceCapabilitiesKHR& surfaceCapabilities)
+	uint32_t SwapChain::GetSwapChainNumImages(const VkSurfaceCapabilitiesKHR& surfaceCapabilities, VkPresentModeKHR presentMode)
 	{
-		uint32_t imageCount = surfaceCapabilities.minImageCount + 1;
+		uint32_t imageCount = m_swapChain->info.imageCount;
+
+		if (imageCount == 0)
+			imageCount = surfaceCapabilities.minImageCount + 1;
+
+		// With fewer than 3 images, mailbox blocks on the presentation engine like FIFO
+		if ((presentMode == VK_PRESENT_MODE_MAILBOX_KHR) && (imageCount < 3))
+			imageCount = 3;
+
+		if (imageCount < surfaceCapabilities.minImageCount)
+			imageCount = surfaceCapabilities.minImageCount;
 		if ((surfaceCapabilities.maxImageCount > 0) && (imageCount > surfaceCapabilities.maxImageCount))
 			imageCount = surfaceCapabilities.maxImageCount;
 
@@ -263,12 +364,15 @@ namespace Zx
 
 	VkPresentModeKHR SwapChain::GetSwapChainPresentMode(const std::vector<VkPresentModeKHR>& presentModes)
 	{
-		for (const auto& presentMode : presentModes)
+		for (const auto& desiredPresentMode : m_swapChain->info.presentModes)
 		{
-			if (presentMode == VK_PRESENT_MODE_MAILBOX_KHR)
-				return presentMode;
+			if (std::find(presentModes.begin(), presentModes.end(), desiredPresentMode) != presentModes.end())
+				return desiredPresentMode;
 		}
 
+		if (!m_swapChain->info.presentModes.empty())
+			std::cout << "None of the requested present modes is supported, the swap chain falls back to FIFO" << std::endl;
+
 		for (const auto& presentMode : presentModes)
 		{
 			if (presentMode == VK_PRESENT_MODE_FIFO_KHR)
@@ -320,4 +424,24 @@ namespace Zx
 		
 		return true;
 	}
+
+	//-------------------------------------------------------------------------
+
+	void SwapChain::DestroyRetiredSwapChain(RetiredSwapChain& retired)
+	{
+		for (VkImageView& imageView : retired.imageView)
+		{
+			if (imageView != VK_NULL_HANDLE)
+			{
+				vkDestroyImageView(m_device->GetDevice()->logicalDevice, imageView, nullptr);
+				imageView = VK_NULL_HANDLE;
+			}
+		}
+
+		if (retired.swapChain != VK_NULL_HANDLE)
+		{
+			vkDestroySwapchainKHR(m_device->GetDevice()->logicalDevice, retired.swapChain, nullptr);
+			retired.swapChain = VK_NULL_HANDLE;
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <iostream>
+
+#include <Neon/Core/File.hpp>
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/MemoryAllocator.hpp>
+#include <Neon/Renderer/ImageUploader.hpp>
+#include <Neon/Renderer/Ktx2.hpp>
+#include <Neon/Renderer/TextureCompression.hpp>
+#include <Neon/Renderer/Texture.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a sampled 2D image and gets its sampler from the cache
+	@param : A reference to the Device
+	@param : The allocator giving the memory of the image
+	@param : The cache giving the sampler
+	@param : The width of the texture
+	@param : The height of the texture
+	@param : The format of the texture
+	@param : True to give the texture a full mip chain, generated on the device at upload
+	@param : The description of the sampler
+	*/
+	Texture::Texture(Device& device, MemoryAllocator& allocator, SamplerCache& samplerCache, uint32_t width, uint32_t height, VkFormat format, bool mipmapped,
+		const SamplerInfo& samplerInfo)
+	{
+		m_texture = std::make_shared<Textures>();
+		m_texture->mipmapped = mipmapped;
+
+		VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+		// The mip levels are blitted from the previous ones
+		if (mipmapped)
+			usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+		m_texture->image = Image(device, allocator, width, height, format, usage, mipmapped ? Image::GetMipLevelCount(width, height) : 1);
+		m_texture->sampler = samplerCache.GetSampler(samplerInfo);
+
+		if (!IsValid())
+			std::cout << "Failed to create texture" << std::endl;
+	}
+
+	/*
+	@brief : Creates a texture from a KTX2 container and stages its levels, the compressed formats the device cannot sample are transcoded on the CPU
+	@param : A reference to the Device
+	@param : The allocator giving the memory of the image
+	@param : The cache giving the sampler
+	@param : The uploader recording the copies of the levels
+	@param : The KTX2 file
+	@param : The description of the sampler
+	*/
+	Texture::Texture(Device& device, MemoryAllocator& allocator, SamplerCache& samplerCache, ImageUploader& imageUploader, const File& file,
+		const SamplerInfo& samplerInfo)
+	{
+		m_texture = std::make_shared<Textures>();
+
+		Ktx2Image ktx2Image;
+
+		if (!LoadKtx2(file, ktx2Image))
+		{
+			std::cout << "Failed to load texture" << std::endl;
+			return;
+		}
+
+		VkFormat format = ktx2Image.format;
+		bool transcoded = !IsFormatSampled(device, format);
+
+		if (transcoded)
+		{
+			format = GetTranscodedFormat(ktx2Image.format);
+
+			if ((format == VK_FORMAT_UNDEFINED) || !IsFormatSampled(device, format))
+			{
+				std::cout << "Failed to load texture, the device cannot sample its format " << ktx2Image.format << std::endl;
+				return;
+			}
+		}
+
+		// Compressed images cannot be blitted, their missing levels are left out
+		m_texture->mipmapped = ktx2Image.generateMips && !IsBlockCompressed(format);
+
+		VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+		if (m_texture->mipmapped)
+			usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+		uint32_t levelCount = static_cast<uint32_t>(ktx2Image.levels.size());
+		uint32_t mipLevels = m_texture->mipmapped ? Image::GetMipLevelCount(ktx2Image.width, ktx2Image.height) : levelCount;
+
+		m_texture->image = Image(device, allocator, ktx2Image.width, ktx2Image.height, format, usage, mipLevels);
+		m_texture->sampler = samplerCache.GetSampler(samplerInfo);
+
+		if (!IsValid())
+		{
+			std::cout << "Failed to create texture" << std::endl;
+			return;
+		}
+
+		std::vector<uint8_t> texels;
+
+		for (uint32_t i = 0; i < std::min(levelCount, m_texture->image.GetMipLevels()); i++)
+		{
+			const Ktx2Level& level = ktx2Image.levels[i];
+
+			const void* data = ktx2Image.content.data() + level.offset;
+			VkDeviceSize size = level.size;
+
+			if (transcoded)
+			{
+				if (!TranscodeImage(ktx2Image.format, data, size, std::max(ktx2Image.width >> i, 1u), std::max(ktx2Image.height >> i, 1u), texels))
+				{
+					m_texture->image = Image();
+					return;
+				}
+
+				data = texels.data();
+				size = texels.size();
+			}
+
+			if (!imageUploader.Upload(m_texture->image, data, size, i))
+			{
+				std::cout << "Failed to upload texture level " << i << std::endl;
+				m_texture->image = Image();
+				return;
+			}
+		}
+
+		if (m_texture->mipmapped)
+			imageUploader.GenerateMips(m_texture->image);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the image
+	@param : A constant reference to the Texture to copy
+	*/
+	Texture::Texture(const Texture& texture) : m_texture(texture.m_texture)
+	{}
+
+	/*
+	@brief : Destroys a texture, the image is freed with its last owner
+	*/
+	Texture::~Texture()
+	{}
+
+	/*
+	@brief : Stages the texels of the first level, the other levels are generated when the upload is recorded
+	@param : The uploader recording the copy with the uploads of its frame
+	@param : The texels, tightly packed
+	@param : The size of the texels in bytes
+	@return : Returns true if the texels are staged, false otherwise
+	*/
+	bool Texture::Upload(ImageUploader& imageUploader, const void* texels, VkDeviceSize size)
+	{
+		if (!imageUploader.Upload(m_texture->image, texels, size))
+			return false;
+
+		if (m_texture->mipmapped)
+			imageUploader.GenerateMips(m_texture->image);
+
+		return true;
+	}
+
+	/*
+	@brief : Assigns the texture by move semantic
+	@param : The texture to move
+	@return : A reference to this
+	*/
+	Texture& Texture::operator=(Texture&& texture) noexcept
+	{
+		std::swap(m_texture, texture.m_texture);
+
+		return (*this);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,650 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/TextureCompression.hpp>
+
+namespace Zx
+{
+	namespace
+	{
+		const uint32_t BlockTexelCount = 16;
+
+		// Intensity modifiers of the ETC1 tables, the negative ones are the opposites
+		const int32_t EtcModifiers[8][2] =
+		{
+			{ 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+		};
+
+		const int32_t EtcDistances[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+		const int32_t EacModifiers[16][8] =
+		{
+			{ -3, -6, -9, -15, 2, 5, 8, 14 },
+			{ -3, -7, -10, -13, 2, 6, 9, 12 },
+			{ -2, -5, -8, -13, 1, 4, 7, 12 },
+			{ -2, -4, -6, -13, 1, 3, 5, 12 },
+			{ -3, -6, -8, -12, 2, 5, 7, 11 },
+			{ -3, -7, -9, -11, 2, 6, 8, 10 },
+			{ -4, -7, -8, -11, 3, 6, 7, 10 },
+			{ -3, -5, -8, -11, 2, 4, 7, 10 },
+			{ -2, -6, -8, -10, 1, 5, 7, 9 },
+			{ -2, -5, -8, -10, 1, 4, 7, 9 },
+			{ -2, -4, -8, -10, 1, 3, 7, 9 },
+			{ -2, -5, -7, -10, 1, 4, 6, 9 },
+			{ -3, -4, -7, -10, 2, 3, 6, 9 },
+			{ -1, -2, -3, -10, 0, 1, 2, 9 },
+			{ -4, -6, -8, -9, 3, 5, 7, 8 },
+			{ -3, -5, -7, -9, 2, 4, 6, 8 }
+		};
+
+		// Block sizes of the ASTC formats, in the order of VkFormat from 4x4 to 12x12
+		const uint32_t AstcBlocks[14][2] =
+		{
+			{ 4, 4 }, { 5, 4 }, { 5, 5 }, { 6, 5 }, { 6, 6 }, { 8, 5 }, { 8, 6 }, { 8, 8 }, { 10, 5 }, { 10, 6 }, { 10, 8 }, { 10, 10 }, { 12, 10 }, { 12, 12 }
+		};
+
+		bool IsInRange(VkFormat format, VkFormat first, VkFormat last)
+		{
+			return (format >= first) && (format <= last);
+		}
+
+		uint8_t Clamp(int32_t value)
+		{
+			return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+		}
+
+		uint64_t ReadBigEndian(const uint8_t* block)
+		{
+			uint64_t bits = 0;
+
+			for (uint32_t i = 0; i < 8; i++)
+				bits = (bits << 8) | block[i];
+
+			return bits;
+		}
+
+		uint64_t ReadLittleEndian(const uint8_t* block, uint32_t size)
+		{
+			uint64_t bits = 0;
+
+			for (uint32_t i = 0; i < size; i++)
+				bits |= static_cast<uint64_t>(block[i]) << (8 * i);
+
+			return bits;
+		}
+
+		void DecodeColor565(uint32_t color, uint8_t* rgba)
+		{
+			uint32_t r = (color >> 11) & 31;
+			uint32_t g = (color >> 5) & 63;
+			uint32_t b = color & 31;
+
+			rgba[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+			rgba[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+			rgba[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+			rgba[3] = 255;
+		}
+
+		// Two 565 endpoints and 2 bits indices, the 3 colors mode of BC1 ends with a black that is transparent when the format has alpha
+		void DecodeBc1(const uint8_t* block, uint8_t* texels, bool fourColors, bool alpha)
+		{
+			uint32_t color0 = block[0] | (block[1] << 8);
+			uint32_t color1 = block[2] | (block[3] << 8);
+			uint32_t indices = static_cast<uint32_t>(ReadLittleEndian(block + 4, 4));
+
+			uint8_t palette[4][4];
+			DecodeColor565(color0, palette[0]);
+			DecodeColor565(color1, palette[1]);
+
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				if (fourColors || (color0 > color1))
+				{
+					palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+					palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+				}
+				else
+				{
+					palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+					palette[3][c] = 0;
+				}
+			}
+
+			palette[2][3] = 255;
+			palette[3][3] = (fourColors || (color0 > color1) || !alpha) ? 255 : 0;
+
+			for (uint32_t i = 0; i < BlockTexelCount; i++)
+				std::memcpy(texels + i * 4, palette[(indices >> (2 * i)) & 3], 4);
+		}
+
+		// Two 8 bits endpoints and 3 bits indices, for the alpha of BC3 and the channels of BC4 and BC5
+		void DecodeBc4(const uint8_t* block, uint8_t* texels, uint32_t channel)
+		{
+			int32_t value0 = block[0];
+			int32_t value1 = block[1];
+
+			uint8_t palette[8] = { block[0], block[1], 0, 0, 0, 0, 0, 255 };
+
+			if (value0 > value1)
+			{
+				for (int32_t i = 1; i < 7; i++)
+					palette[i + 1] = static_cast<uint8_t>(((7 - i) * value0 + i * value1) / 7);
+			}
+			else
+			{
+				for (int32_t i = 1; i < 5; i++)
+					palette[i + 1] = static_cast<uint8_t>(((5 - i) * value0 + i * value1) / 5);
+			}
+
+			uint64_t indices = ReadLittleEndian(block + 2, 6);
+
+			for (uint32_t i = 0; i < BlockTexelCount; i++)
+				texels[i * 4 + channel] = palette[(indices >> (3 * i)) & 7];
+		}
+
+		// Explicit 4 bits alpha of BC2
+		void DecodeBc2Alpha(const uint8_t* block, uint8_t* texels)
+		{
+			for (uint32_t i = 0; i < BlockTexelCount; i++)
+				texels[i * 4 + 3] = static_cast<uint8_t>(((block[i / 2] >> (4 * (i % 2))) & 15) * 17);
+		}
+
+		int32_t SignExtend3(int32_t value)
+		{
+			return (value & 4) ? value - 8 : value;
+		}
+
+		int32_t Extend4(int32_t value)
+		{
+			return value * 17;
+		}
+
+		int32_t Extend5(int32_t value)
+		{
+			return (value << 3) | (value >> 2);
+		}
+
+		// The texels of ETC are numbered column by column, the index of a texel is split between the two halves of the low 32 bits
+		uint32_t GetEtcIndex(uint32_t pixelIndices, uint32_t texel)
+		{
+			return (((pixelIndices >> (texel + 16)) & 1) << 1) | ((pixelIndices >> texel) & 1);
+		}
+
+		void WriteEtcTexel(uint8_t* texels, uint32_t texel, int32_t r, int32_t g, int32_t b, uint8_t alpha)
+		{
+			uint8_t* rgba = texels + ((texel % 4) * 4 + texel / 4) * 4;
+
+			rgba[0] = Clamp(r);
+			rgba[1] = Clamp(g);
+			rgba[2] = Clamp(b);
+			rgba[3] = alpha;
+		}
+
+		// T and H modes, 4 colors picked by the index, the index 2 is transparent without the opaque bit of the punch-through alpha
+		void DecodeEtcPaint(const int32_t colors[4][3], uint32_t pixelIndices, bool opaque, uint8_t* texels)
+		{
+			for (uint32_t i = 0; i < BlockTexelCount; i++)
+			{
+				uint32_t index = GetEtcIndex(pixelIndices, i);
+
+				if (!opaque && (index == 2))
+					WriteEtcTexel(texels, i, 0, 0, 0, 0);
+				else
+					WriteEtcTexel(texels, i, colors[index][0], colors[index][1], colors[index][2], 255);
+			}
+		}
+
+		void DecodeEtcT(const uint8_t* block, uint32_t pixelIndices, bool opaque, uint8_t* texels)
+		{
+			int32_t color0[3] = { Extend4((((block[0] >> 3) & 3) << 2) | (block[0] & 3)), Extend4(block[1] >> 4), Extend4(block[1] & 15) };
+			int32_t color1[3] = { Extend4(block[2] >> 4), Extend4(block[2] & 15), Extend4(block[3] >> 4) };
+			int32_t distance = EtcDistances[(((block[3] >> 2) & 3) << 1) | (block[3] & 1)];
+
+			int32_t colors[4][3];
+
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				colors[0][c] = color0[c];
+				colors[1][c] = std::min(color1[c] + distance, 255);
+				colors[2][c] = color1[c];
+				colors[3][c] = std::max(color1[c] - distance, 0);
+			}
+
+			DecodeEtcPaint(colors, pixelIndices, opaque, texels);
+		}
+
+		void DecodeEtcH(const uint8_t* block, uint32_t pixelIndices, bool opaque, uint8_t* texels)
+		{
+			int32_t r0 = (block[0] >> 3) & 15;
+			int32_t g0 = ((block[0] & 7) << 1) | ((block[1] >> 4) & 1);
+			int32_t b0 = (block[1] & 8) | ((block[1] & 3) << 1) | (block[2] >> 7);
+			int32_t r1 = (block[2] >> 3) & 15;
+			int32_t g1 = ((block[2] & 7) << 1) | (block[3] >> 7);
+			int32_t b1 = (block[3] >> 3) & 15;
+
+			// The last bit of the distance is given by the order of the two colors
+			uint32_t ordering = (((r0 << 8) | (g0 << 4) | b0) >= ((r1 << 8) | (g1 << 4) | b1)) ? 1 : 0;
+			int32_t distance = EtcDistances[(block[3] & 4) | ((block[3] & 1) << 1) | ordering];
+
+			int32_t color0[3] = { Extend4(r0), Extend4(g0), Extend4(b0) };
+			int32_t color1[3] = { Extend4(r1), Extend4(g1), Extend4(b1) };
+
+			int32_t colors[4][3];
+
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				colors[0][c] = color0[c] + distance;
+				colors[1][c] = color0[c] - distance;
+				colors[2][c] = color1[c] + distance;
+				colors[3][c] = color1[c] - distance;
+			}
+
+			DecodeEtcPaint(colors, pixelIndices, opaque, texels);
+		}
+
+		// Planar mode, a color gradient given at the origin and on the horizontal and vertical edges
+		void DecodeEtcPlanar(uint64_t bits, uint8_t* texels)
+		{
+			int32_t ro = static_cast<int32_t>((bits >> 57) & 63);
+			int32_t go = static_cast<int32_t>((((bits >> 56) & 1) << 6) | ((bits >> 49) & 63));
+			int32_t bo = static_cast<int32_t>((((bits >> 48) & 1) << 5) | (((bits >> 43) & 3) << 3) | ((bits >> 39) & 7));
+			int32_t rh = static_cast<int32_t>((((bits >> 34) & 31) << 1) | ((bits >> 32) & 1));
+			int32_t gh = static_cast<int32_t>((bits >> 25) & 127);
+			int32_t bh = static_cast<int32_t>((bits >> 19) & 63);
+			int32_t rv = static_cast<int32_t>((bits >> 13) & 63);
+			int32_t gv = static_cast<int32_t>((bits >> 6) & 127);
+			int32_t bv = static_cast<int32_t>(bits & 63);
+
+			int32_t origin[3] = { (ro << 2) | (ro >> 4), (go << 1) | (go >> 6), (bo << 2) | (bo >> 4) };
+			int32_t horizontal[3] = { (rh << 2) | (rh >> 4), (gh << 1) | (gh >> 6), (bh << 2) | (bh >> 4) };
+			int32_t vertical[3] = { (rv << 2) | (rv >> 4), (gv << 1) | (gv >> 6), (bv << 2) | (bv >> 4) };
+
+			for (int32_t y = 0; y < 4; y++)
+			{
+				for (int32_t x = 0; x < 4; x++)
+				{
+					uint8_t* rgba = texels + (y * 4 + x) * 4;
+
+					for (uint32_t c = 0; c < 3; c++)
+						rgba[c] = Clamp((x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2);
+
+					rgba[3] = 255;
+				}
+			}
+		}
+
+		// ETC2 RGB block, the individual and differential modes of ETC1, with the T, H and planar modes given by the overflows of the differential mode
+		void DecodeEtc2(const uint8_t* block, uint8_t* texels, bool punchThrough)
+		{
+			uint64_t bits = ReadBigEndian(block);
+			uint32_t pixelIndices = static_cast<uint32_t>(bits);
+
+			// The punch-through alpha has no individual mode, its differential bit tells if the block is opaque
+			bool differential = ((block[3] >> 1) & 1) != 0;
+			bool opaque = !punchThrough || differential;
+
+			int32_t baseColors[2][3];
+
+			if (punchThrough || differential)
+			{
+				int32_t channels[3];
+				int32_t deltas[3];
+
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					channels[c] = block[c] >> 3;
+					deltas[c] = SignExtend3(block[c] & 7);
+				}
+
+				if ((channels[0] + deltas[0] < 0) || (channels[0] + deltas[0] > 31))
+				{
+					DecodeEtcT(block, pixelIndices, opaque, texels);
+					return;
+				}
+
+				if ((channels[1] + deltas[1] < 0) || (channels[1] + deltas[1] > 31))
+				{
+					DecodeEtcH(block, pixelIndices, opaque, texels);
+					return;
+				}
+
+				// The planar mode ignores the opaque bit
+				if ((channels[2] + deltas[2] < 0) || (channels[2] + deltas[2] > 31))
+				{
+					DecodeEtcPlanar(bits, texels);
+					return;
+				}
+
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					baseColors[0][c] = Extend5(channels[c]);
+					baseColors[1][c] = Extend5(channels[c] + deltas[c]);
+				}
+			}
+			else
+			{
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					baseColors[0][c] = Extend4(block[c] >> 4);
+					baseColors[1][c] = Extend4(block[c] & 15);
+				}
+			}
+
+			uint32_t tables[2] = { static_cast<uint32_t>(block[3] >> 5), static_cast<uint32_t>((block[3] >> 2) & 7) };
+			bool flip = (block[3] & 1) != 0;
+
+			for (uint32_t i = 0; i < BlockTexelCount; i++)
+			{
+				uint32_t x = i / 4;
+				uint32_t y = i % 4;
+				uint32_t subBlock = flip ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+				uint32_t index = GetEtcIndex(pixelIndices, i);
+
+				if (!opaque && (index == 2))
+				{
+					WriteEtcTexel(texels, i, 0, 0, 0, 0);
+					continue;
+				}
+
+				int32_t modifier = EtcModifiers[tables[subBlock]][index & 1];
+
+				if (index >= 2)
+					modifier = -modifier;
+
+				// Without the opaque bit, the smallest modifiers are replaced by the base color
+				if (!opaque && (index == 0))
+					modifier = 0;
+
+				const int32_t* baseColor = baseColors[subBlock];
+				WriteEtcTexel(texels, i, baseColor[0] + modifier, baseColor[1] + modifier, baseColor[2] + modifier, 255);
+			}
+		}
+
+		// EAC block of 8 or 11 bits values, a base value moved by a multiplied modifier, kept on 8 bits
+		void DecodeEac(const uint8_t* block, uint8_t* texels, uint32_t channel, bool elevenBits)
+		{
+			uint64_t bits = ReadBigEndian(block);
+
+			int32_t base = block[0];
+			int32_t multiplier = block[1] >> 4;
+			const int32_t* modifiers = EacModifiers[block[1] & 15];
+
+			for (uint32_t i = 0; i < BlockTexelCount; i++)
+			{
+				int32_t modifier = modifiers[(bits >> (45 - 3 * i)) & 7];
+				int32_t value;
+
+				if (elevenBits)
+				{
+					value = base * 8 + 4 + modifier * ((multiplier != 0) ? multiplier * 8 : 1);
+					value = (std::min(std::max(value, 0), 2047) * 255 + 1023) / 2047;
+				}
+				else
+					value = base + modifier * multiplier;
+
+				texels[((i % 4) * 4 + i / 4) * 4 + channel] = Clamp(value);
+			}
+		}
+
+		bool DecodeBlock(VkFormat format, const uint8_t* block, uint8_t* texels)
+		{
+			switch (format)
+			{
+			case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+				DecodeBc1(block, texels, false, false);
+				return true;
+			case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+				DecodeBc1(block, texels, false, true);
+				return true;
+			case VK_FORMAT_BC2_UNORM_BLOCK:
+			case VK_FORMAT_BC2_SRGB_BLOCK:
+				DecodeBc1(block + 8, texels, true, false);
+				DecodeBc2Alpha(block, texels);
+				return true;
+			case VK_FORMAT_BC3_UNORM_BLOCK:
+			case VK_FORMAT_BC3_SRGB_BLOCK:
+				DecodeBc1(block + 8, texels, true, false);
+				DecodeBc4(block, texels, 3);
+				return true;
+			case VK_FORMAT_BC4_UNORM_BLOCK:
+				DecodeBc4(block, texels, 0);
+				return true;
+			case VK_FORMAT_BC5_UNORM_BLOCK:
+				DecodeBc4(block, texels, 0);
+				DecodeBc4(block + 8, texels, 1);
+				return true;
+			case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+				DecodeEtc2(block, texels, false);
+				return true;
+			case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+				DecodeEtc2(block, texels, true);
+				return true;
+			case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+			case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+				DecodeEtc2(block + 8, texels, false);
+				DecodeEac(block, texels, 3, false);
+				return true;
+			case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+				DecodeEac(block, texels, 0, true);
+				return true;
+			case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+				DecodeEac(block, texels, 0, true);
+				DecodeEac(block + 8, texels, 1, true);
+				return true;
+			default:
+				return false;
+			}
+		}
+	}
+
+	/*
+	@brief : Gives the texel block of a format
+	@param : The format
+	@param : The block, its size in bytes and its extent in texels
+	@return : Returns true if the format is known, false otherwise
+	*/
+	bool GetFormatBlock(VkFormat format, FormatBlock& block)
+	{
+		block = FormatBlock();
+
+		switch (format)
+		{
+		case VK_FORMAT_R8_UNORM:
+			block.size = 1;
+			return true;
+		case VK_FORMAT_R8G8_UNORM:
+			block.size = 2;
+			return true;
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R8G8B8A8_SNORM:
+		case VK_FORMAT_R8G8B8A8_SRGB:
+		case VK_FORMAT_B8G8R8A8_UNORM:
+		case VK_FORMAT_B8G8R8A8_SRGB:
+		case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+			block.size = 4;
+			return true;
+		case VK_FORMAT_R16G16B16A16_UNORM:
+		case VK_FORMAT_R16G16B16A16_SFLOAT:
+			block.size = 8;
+			return true;
+		case VK_FORMAT_R32G32B32A32_SFLOAT:
+			block.size = 16;
+			return true;
+		default:
+			break;
+		}
+
+		if (!IsBlockCompressed(format))
+			return false;
+
+		block.width = 4;
+		block.height = 4;
+		block.size = 16;
+
+		if (IsInRange(format, VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ASTC_12x12_SRGB_BLOCK))
+		{
+			const uint32_t* astcBlock = AstcBlocks[(format - VK_FORMAT_ASTC_4x4_UNORM_BLOCK) / 2];
+			block.width = astcBlock[0];
+			block.height = astcBlock[1];
+		}
+		else if (IsInRange(format, VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC1_RGBA_SRGB_BLOCK) || IsInRange(format, VK_FORMAT_BC4_UNORM_BLOCK, VK_FORMAT_BC4_SNORM_BLOCK)
+			|| IsInRange(format, VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK, VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK) || IsInRange(format, VK_FORMAT_EAC_R11_UNORM_BLOCK, VK_FORMAT_EAC_R11_SNORM_BLOCK))
+			block.size = 8;
+
+		return true;
+	}
+
+	/*
+	@brief : Tells if a format is one of the BC, ETC2, EAC or ASTC block compressed formats
+	@param : The format
+	@return : Returns true if the format is block compressed, false otherwise
+	*/
+	bool IsBlockCompressed(VkFormat format)
+	{
+		return IsInRange(format, VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_ASTC_12x12_SRGB_BLOCK);
+	}
+
+	/*
+	@brief : Gives the size of the tightly packed texels of an image
+	@param : The format of the image
+	@param : The width of the image
+	@param : The height of the image
+	@return : The size in bytes, 0 if the format is unknown
+	*/
+	VkDeviceSize GetImageSize(VkFormat format, uint32_t width, uint32_t height)
+	{
+		FormatBlock block;
+
+		if (!GetFormatBlock(format, block))
+			return 0;
+
+		VkDeviceSize blockCountX = (width + block.width - 1) / block.width;
+		VkDeviceSize blockCountY = (height + block.height - 1) / block.height;
+
+		return blockCountX * blockCountY * block.size;
+	}
+
+	/*
+	@brief : Tells if the device can sample and linearly filter images of a format, the compressed formats also need their family to be enabled
+	@param : A constant reference to the Device
+	@param : The format
+	@return : Returns true if the format can be sampled, false otherwise
+	*/
+	bool IsFormatSampled(const Device& device, VkFormat format)
+	{
+		if (IsInRange(format, VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK) && !device.GetDevice()->textureCompressionBC)
+			return false;
+
+		if (IsInRange(format, VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK, VK_FORMAT_EAC_R11G11_SNORM_BLOCK) && !device.GetDevice()->textureCompressionETC2)
+			return false;
+
+		if (IsInRange(format, VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ASTC_12x12_SRGB_BLOCK) && !device.GetDevice()->textureCompressionASTC)
+			return false;
+
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(device.GetDevice()->physicalDevice, format, &formatProperties);
+
+		VkFormatFeatureFlags sampledFeatures = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+		return (formatProperties.optimalTilingFeatures & sampledFeatures) == sampledFeatures;
+	}
+
+	/*
+	@brief : Gives the format of the texels written by TranscodeImage for a compressed format
+	@param : The compressed format
+	@return : The RGBA8 format keeping the color space, VK_FORMAT_UNDEFINED if there is no transcoder for the format
+	*/
+	VkFormat GetTranscodedFormat(VkFormat format)
+	{
+		switch (format)
+		{
+		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		case VK_FORMAT_BC2_UNORM_BLOCK:
+		case VK_FORMAT_BC3_UNORM_BLOCK:
+		case VK_FORMAT_BC4_UNORM_BLOCK:
+		case VK_FORMAT_BC5_UNORM_BLOCK:
+		case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+		case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+		case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+		case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+		case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+			return VK_FORMAT_R8G8B8A8_UNORM;
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case VK_FORMAT_BC2_SRGB_BLOCK:
+		case VK_FORMAT_BC3_SRGB_BLOCK:
+		case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+		case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+		case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+			return VK_FORMAT_R8G8B8A8_SRGB;
+		default:
+			return VK_FORMAT_UNDEFINED;
+		}
+	}
+
+	/*
+	@brief : Decodes a compressed image on the CPU, for the devices that cannot sample its format
+	@param : The compressed format, GetTranscodedFormat tells if it has a transcoder
+	@param : The blocks of the image
+	@param : The size of the blocks in bytes
+	@param : The width of the image
+	@param : The height of the image
+	@param : The decoded RGBA8 texels, tightly packed
+	@return : Returns true if the image is decoded, false if the format has no transcoder or the blocks are truncated
+	*/
+	bool TranscodeImage(VkFormat format, const void* data, VkDeviceSize size, uint32_t width, uint32_t height, std::vector<uint8_t>& texels)
+	{
+		if (GetTranscodedFormat(format) == VK_FORMAT_UNDEFINED)
+		{
+			std::cout << "No transcoder for the texture format " << format << std::endl;
+			return false;
+		}
+
+		if (size < GetImageSize(format, width, height))
+		{
+			std::cout << "Compressed image is truncated" << std::endl;
+			return false;
+		}
+
+		FormatBlock block;
+		GetFormatBlock(format, block);
+
+		texels.assign(static_cast<std::size_t>(width) * height * 4, 0);
+
+		const uint8_t* blocks = static_cast<const uint8_t*>(data);
+		uint8_t blockTexels[BlockTexelCount * 4];
+
+		for (uint32_t blockY = 0; blockY < height; blockY += 4)
+		{
+			for (uint32_t blockX = 0; blockX < width; blockX += 4)
+			{
+				// Single channel formats leave green and blue to 0 and alpha to 1
+				for (uint32_t i = 0; i < BlockTexelCount; i++)
+				{
+					blockTexels[i * 4] = 0;
+					blockTexels[i * 4 + 1] = 0;
+					blockTexels[i * 4 + 2] = 0;
+					blockTexels[i * 4 + 3] = 255;
+				}
+
+				DecodeBlock(format, blocks, blockTexels);
+				blocks += block.size;
+
+				// The blocks on the right and bottom edges cover texels outside of the image
+				uint32_t rowSize = std::min(4u, width - blockX) * 4;
+
+				for (uint32_t y = 0; y < std::min(4u, height - blockY); y++)
+					std::memcpy(&texels[((static_cast<std::size_t>(blockY) + y) * width + blockX) * 4], blockTexels + y * 16, rowSize);
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
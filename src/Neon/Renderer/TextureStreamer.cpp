@@ -0,0 +1,488 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include <Neon/Core/File.hpp>
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/TextureCompression.hpp>
+#include <Neon/Renderer/TextureStreamer.hpp>
+
+namespace Zx
+{
+	namespace
+	{
+		// The levels of this size and below stay resident, a texture is never sampled without them
+		const uint32_t MinResidentExtent = 64;
+
+		// Runs on a worker thread once the device is known not to sample the format of the source
+		bool TranscodeSource(Ktx2Image& source, VkFormat format)
+		{
+			std::vector<char> content;
+			std::vector<uint8_t> texels;
+
+			for (uint32_t i = 0; i < source.levels.size(); i++)
+			{
+				Ktx2Level& level = source.levels[i];
+
+				if (!TranscodeImage(source.format, source.content.data() + level.offset, level.size, std::max(source.width >> i, 1u), std::max(source.height >> i, 1u), texels))
+					return false;
+
+				level.offset = content.size();
+				level.size = texels.size();
+				content.insert(content.end(), texels.begin(), texels.end());
+			}
+
+			source.content = std::move(content);
+			source.format = format;
+
+			return true;
+		}
+	}
+
+	/*
+	@brief : Creates a streamer keeping the levels of its textures resident according to their size on the screen and to the memory budget
+	@param : A reference to the Device
+	@param : The allocator giving the memory of the images
+	@param : The cache giving the samplers
+	@param : The uploader staging the streamed levels
+	@param : The table where the textures are bound, their index changes when their residency does
+	@param : The largest size of the resident levels, 0 to only follow the budget of the device
+	@param : The largest size of the levels staged in a frame, at least one texture is streamed per frame
+	*/
+	TextureStreamer::TextureStreamer(Device& device, MemoryAllocator& allocator, SamplerCache& samplerCache, ImageUploader& imageUploader, BindlessTable& bindlessTable,
+		VkDeviceSize maxResidentSize, VkDeviceSize uploadSize)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_textureStreamer = std::make_shared<TextureStreamers>();
+
+		m_textureStreamer->allocator = MemoryAllocator(allocator);
+		m_textureStreamer->samplerCache = SamplerCache(samplerCache);
+		m_textureStreamer->imageUploader = ImageUploader(imageUploader);
+		m_textureStreamer->bindlessTable = BindlessTable(bindlessTable);
+		m_textureStreamer->maxResidentSize = maxResidentSize;
+		m_textureStreamer->uploadSize = uploadSize;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor, the copy shares the streamed textures
+	@param : A constant reference to the TextureStreamer to copy
+	*/
+	TextureStreamer::TextureStreamer(const TextureStreamer& textureStreamer) : m_device(textureStreamer.m_device), m_textureStreamer(textureStreamer.m_textureStreamer)
+	{}
+
+	/*
+	@brief : Destroys a streamer, the images are freed with its last owner once their loading is over
+	*/
+	TextureStreamer::~TextureStreamer()
+	{}
+
+	/*
+	@brief : Adds a texture read from a KTX2 container on a worker thread, its smallest levels are made resident once it is read
+	@param : The KTX2 file
+	@param : The description of the sampler
+	@return : The handle of the texture
+	*/
+	uint32_t TextureStreamer::Add(const File& file, const SamplerInfo& samplerInfo)
+	{
+		uint32_t handle = static_cast<uint32_t>(m_textureStreamer->textures.size());
+
+		if (!m_textureStreamer->freeHandles.empty())
+		{
+			handle = m_textureStreamer->freeHandles.back();
+			m_textureStreamer->freeHandles.pop_back();
+		}
+		else
+			m_textureStreamer->textures.emplace_back();
+
+		StreamedTexture& texture = m_textureStreamer->textures[handle];
+		texture.used = true;
+		texture.sampler = m_textureStreamer->samplerCache.GetSampler(samplerInfo);
+		texture.source = std::make_shared<Ktx2Image>();
+
+		std::shared_ptr<Ktx2Image> source = texture.source;
+
+		texture.loading = std::async(std::launch::async, [file, source]()
+		{
+			return LoadKtx2(file, *source);
+		});
+
+		return handle;
+	}
+
+	/*
+	@brief : Removes a texture, waits for its loading if it is not over
+	@param : The handle of the texture
+	*/
+	void TextureStreamer::Remove(uint32_t handle)
+	{
+		if ((handle >= m_textureStreamer->textures.size()) || !m_textureStreamer->textures[handle].used)
+			return;
+
+		StreamedTexture& texture = m_textureStreamer->textures[handle];
+
+		if (texture.image.IsValid())
+			m_textureStreamer->retiredImages.Push(m_device->GetDevice()->frameCounter, texture.image);
+
+		if (texture.bindlessIndex != BindlessTable::InvalidIndex)
+			m_textureStreamer->bindlessTable.RemoveTexture(texture.bindlessIndex);
+
+		if (texture.loaded)
+			m_textureStreamer->residentSize -= GetLevelsSize(texture, texture.residentMip);
+
+		texture = StreamedTexture();
+		m_textureStreamer->freeHandles.push_back(handle);
+	}
+
+	/*
+	@brief : Starts a frame, the images replaced by the frames over are released and the requests are cleared, to call once the Device began the frame
+	*/
+	void TextureStreamer::BeginFrame()
+	{
+		// The images are destroyed with their last copy
+		m_textureStreamer->retiredImages.Release(m_device->GetDevice()->frameCounter, [](Image&) {});
+
+		for (StreamedTexture& texture : m_textureStreamer->textures)
+			texture.requestedSize = 0.0f;
+	}
+
+	/*
+	@brief : Marks a texture as used this frame, its levels are streamed up to the one matching its size on the screen
+	@param : The handle of the texture
+	@param : The largest extent of the texture on the screen, in pixels
+	*/
+	void TextureStreamer::Request(uint32_t handle, float screenSize)
+	{
+		if ((handle >= m_textureStreamer->textures.size()) || !m_textureStreamer->textures[handle].used)
+			return;
+
+		StreamedTexture& texture = m_textureStreamer->textures[handle];
+		texture.lastUsedFrame = m_device->GetDevice()->frameCounter.GetFrame();
+		texture.requestedSize = std::max(texture.requestedSize, screenSize);
+	}
+
+	/*
+	@brief : Streams in the levels of the textures the most needed this frame, evicting the levels of the least recently used ones when the budget is reached
+	@param : The command buffer of the frame in recording state, the uploader must record its copies after this call
+	@return : Returns true if the residencies are updated, false if an image could not be created
+	*/
+	bool TextureStreamer::Update(VkCommandBuffer commandBuffer)
+	{
+		ComputeBudget();
+
+		std::vector<StreamedTexture>& textures = m_textureStreamer->textures;
+		std::vector<uint32_t> candidates;
+
+		for (uint32_t i = 0; i < textures.size(); i++)
+		{
+			StreamedTexture& texture = textures[i];
+
+			if (!texture.used)
+				continue;
+
+			PollLoading(texture);
+
+			if (!texture.loaded)
+				continue;
+
+			// The level with as many texels as pixels covered, the minification picks the next ones
+			uint32_t extent = std::max(texture.source->width, texture.source->height);
+			texture.requestedMip = texture.minResidentMip;
+
+			if (texture.requestedSize >= 1.0f)
+			{
+				float mip = std::floor(std::log2(static_cast<float>(extent) / texture.requestedSize));
+				texture.requestedMip = std::min(static_cast<uint32_t>(std::max(mip, 0.0f)), texture.minResidentMip);
+			}
+
+			texture.targetMip = texture.residentMip;
+
+			if ((texture.residentMip == texture.levelCount) || (texture.requestedMip < texture.residentMip))
+				candidates.push_back(i);
+		}
+
+		// Textures without any level first, then the ones used the most recently with the most missing levels
+		std::sort(candidates.begin(), candidates.end(), [&textures](uint32_t a, uint32_t b)
+		{
+			const StreamedTexture& textureA = textures[a];
+			const StreamedTexture& textureB = textures[b];
+
+			bool emptyA = textureA.residentMip == textureA.levelCount;
+			bool emptyB = textureB.residentMip == textureB.levelCount;
+
+			if (emptyA != emptyB)
+				return emptyA;
+
+			if (textureA.lastUsedFrame != textureB.lastUsedFrame)
+				return textureA.lastUsedFrame > textureB.lastUsedFrame;
+
+			return (textureA.residentMip - textureA.requestedMip) > (textureB.residentMip - textureB.requestedMip);
+		});
+
+		VkDeviceSize uploadedSize = 0;
+
+		for (uint32_t handle : candidates)
+		{
+			StreamedTexture& texture = textures[handle];
+
+			// One level is streamed in at a time, the smallest levels come together
+			bool empty = texture.residentMip == texture.levelCount;
+			uint32_t mip = empty ? texture.minResidentMip : texture.residentMip - 1;
+
+			VkDeviceSize levelsSize = GetLevelsSize(texture, mip) - GetLevelsSize(texture, texture.residentMip);
+
+			if ((uploadedSize > 0) && (uploadedSize + levelsSize > m_textureStreamer->uploadSize))
+				continue;
+
+			// An empty texture evicts like the others, when nothing is left to evict only its smallest mip tail overshoots the budget so that every used texture can be sampled
+			bool overBudget = (m_textureStreamer->residentSize + levelsSize > m_textureStreamer->budget) && !Evict(levelsSize, handle);
+
+			if (overBudget && !empty)
+				continue;
+
+			texture.targetMip = mip;
+			m_textureStreamer->residentSize += levelsSize;
+			uploadedSize += levelsSize;
+		}
+
+		bool result = true;
+
+		for (StreamedTexture& texture : textures)
+		{
+			if (!texture.loaded || (texture.targetMip == texture.residentMip))
+				continue;
+
+			if (!SetResidentMip(texture, texture.targetMip, commandBuffer))
+			{
+				std::cout << "Failed to stream texture levels" << std::endl;
+				m_textureStreamer->residentSize = m_textureStreamer->residentSize - GetLevelsSize(texture, texture.targetMip) + GetLevelsSize(texture, texture.residentMip);
+				result = false;
+			}
+		}
+
+		return result;
+	}
+
+	/*
+	@brief : Gives the index of a texture in the bindless table, it changes with the resident levels of the texture
+	@param : The handle of the texture
+	@return : The index of the texture, BindlessTable::InvalidIndex while none of its levels is resident
+	*/
+	uint32_t TextureStreamer::GetTextureIndex(uint32_t handle) const
+	{
+		if (handle >= m_textureStreamer->textures.size())
+			return BindlessTable::InvalidIndex;
+
+		return m_textureStreamer->textures[handle].bindlessIndex;
+	}
+
+	/*
+	@brief : Assigns the streamer by move semantic
+	@param : The streamer to move
+	@return : A reference to this
+	*/
+	TextureStreamer& TextureStreamer::operator=(TextureStreamer&& textureStreamer) noexcept
+	{
+		std::swap(m_device, textureStreamer.m_device);
+		std::swap(m_textureStreamer, textureStreamer.m_textureStreamer);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	void TextureStreamer::PollLoading(StreamedTexture& texture)
+	{
+		if (texture.loaded || !texture.loading.valid() || (texture.loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready))
+			return;
+
+		if (!texture.loading.get())
+		{
+			std::cout << "Failed to stream texture" << std::endl;
+			texture.source.reset();
+			return;
+		}
+
+		// The transcoding runs on a worker thread too, the texture is polled again once it is over
+		if (!IsFormatSampled(*m_device, texture.source->format))
+		{
+			VkFormat format = GetTranscodedFormat(texture.source->format);
+
+			if ((format == VK_FORMAT_UNDEFINED) || !IsFormatSampled(*m_device, format))
+			{
+				std::cout << "The device cannot sample the texture format " << texture.source->format << std::endl;
+				texture.source.reset();
+				return;
+			}
+
+			std::shared_ptr<Ktx2Image> source = texture.source;
+
+			texture.loading = std::async(std::launch::async, [source, format]()
+			{
+				return TranscodeSource(*source, format);
+			});
+
+			return;
+		}
+
+		texture.loaded = true;
+		texture.levelCount = static_cast<uint32_t>(texture.source->levels.size());
+		texture.residentMip = texture.levelCount;
+		texture.minResidentMip = texture.levelCount - 1;
+
+		for (uint32_t i = 0; i < texture.levelCount; i++)
+		{
+			if (std::max(texture.source->width >> i, texture.source->height >> i) <= MinResidentExtent)
+			{
+				texture.minResidentMip = i;
+				break;
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+
+	void TextureStreamer::ComputeBudget()
+	{
+		VkDeviceSize budget = 0;
+		VkDeviceSize usage = 0;
+
+		m_textureStreamer->allocator.GetMemoryBudget(budget, usage);
+
+		// The streamed levels take what the rest of the process leaves, with some room kept for the allocations to come
+		VkDeviceSize otherUsage = (usage > m_textureStreamer->residentSize) ? usage - m_textureStreamer->residentSize : 0;
+		VkDeviceSize available = budget / 10 * 9;
+
+		m_textureStreamer->budget = (available > otherUsage) ? available - otherUsage : 0;
+
+		if (m_textureStreamer->maxResidentSize != 0)
+			m_textureStreamer->budget = std::min(m_textureStreamer->budget, m_textureStreamer->maxResidentSize);
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool TextureStreamer::Evict(VkDeviceSize size, uint32_t handle)
+	{
+		std::vector<StreamedTexture>& textures = m_textureStreamer->textures;
+		std::vector<uint32_t> candidates;
+
+		// Textures used this frame only give the levels they do not need
+		for (uint32_t i = 0; i < textures.size(); i++)
+		{
+			const StreamedTexture& texture = textures[i];
+			uint32_t limit = (texture.lastUsedFrame == m_device->GetDevice()->frameCounter.GetFrame()) ? texture.requestedMip : texture.minResidentMip;
+
+			if ((i != handle) && texture.loaded && (texture.targetMip < limit))
+				candidates.push_back(i);
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [&textures](uint32_t a, uint32_t b)
+		{
+			return textures[a].lastUsedFrame < textures[b].lastUsedFrame;
+		});
+
+		// The least recently used textures lose their largest levels first
+		for (uint32_t candidate : candidates)
+		{
+			StreamedTexture& texture = textures[candidate];
+			uint32_t limit = (texture.lastUsedFrame == m_device->GetDevice()->frameCounter.GetFrame()) ? texture.requestedMip : texture.minResidentMip;
+
+			while ((texture.targetMip < limit) && (m_textureStreamer->residentSize + size > m_textureStreamer->budget))
+			{
+				m_textureStreamer->residentSize -= GetLevelsSize(texture, texture.targetMip) - GetLevelsSize(texture, texture.targetMip + 1);
+				texture.targetMip++;
+			}
+
+			if (m_textureStreamer->residentSize + size <= m_textureStreamer->budget)
+				return true;
+		}
+
+		return false;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool TextureStreamer::SetResidentMip(StreamedTexture& texture, uint32_t mip, VkCommandBuffer commandBuffer)
+	{
+		const Ktx2Image& source = *texture.source;
+
+		Image image(*m_device, m_textureStreamer->allocator, std::max(source.width >> mip, 1u), std::max(source.height >> mip, 1u), source.format,
+			VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, texture.levelCount - mip);
+
+		if (!image.IsValid())
+			return false;
+
+		// The missing levels are staged from the source before anything is recorded, the image is dropped if the uploader is full
+		for (uint32_t i = mip; i < std::min(texture.residentMip, texture.levelCount); i++)
+		{
+			const Ktx2Level& level = source.levels[i];
+
+			if (!m_textureStreamer->imageUploader.Upload(image, source.content.data() + level.offset, level.size, i - mip))
+				return false;
+		}
+
+		// The levels already resident are copied on the device
+		uint32_t firstCopied = std::max(mip, texture.residentMip);
+
+		if (firstCopied < texture.levelCount)
+		{
+			std::vector<VkImageCopy> imageCopies;
+
+			for (uint32_t i = firstCopied; i < texture.levelCount; i++)
+			{
+				VkImageCopy imageCopy =
+				{
+					{ VK_IMAGE_ASPECT_COLOR_BIT, i - texture.residentMip, 0, 1 },
+					{ 0, 0, 0 },
+					{ VK_IMAGE_ASPECT_COLOR_BIT, i - mip, 0, 1 },
+					{ 0, 0, 0 },
+					{ std::max(source.width >> i, 1u), std::max(source.height >> i, 1u), 1 }
+				};
+
+				imageCopies.push_back(imageCopy);
+			}
+
+			texture.image.Transition(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+			image.Transition(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+			vkCmdCopyImage(commandBuffer, texture.image.GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image.GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				static_cast<uint32_t>(imageCopies.size()), imageCopies.data());
+		}
+
+		// Without staged levels the uploader does not finish the image
+		if (mip >= texture.residentMip)
+			image.Transition(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+		if (texture.image.IsValid())
+			m_textureStreamer->retiredImages.Push(m_device->GetDevice()->frameCounter, texture.image);
+
+		// The frames in flight keep sampling the previous image through its slot until it is retired
+		if (m_textureStreamer->bindlessTable.IsAvailable())
+		{
+			if (texture.bindlessIndex != BindlessTable::InvalidIndex)
+				m_textureStreamer->bindlessTable.RemoveTexture(texture.bindlessIndex);
+
+			texture.bindlessIndex = m_textureStreamer->bindlessTable.AddTexture(image.GetImageView(), texture.sampler);
+		}
+
+		texture.image = std::move(image);
+		texture.residentMip = mip;
+		texture.targetMip = mip;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	VkDeviceSize TextureStreamer::GetLevelsSize(const StreamedTexture& texture, uint32_t mip) const
+	{
+		VkDeviceSize size = 0;
+
+		for (uint32_t i = mip; i < texture.levelCount; i++)
+			size += texture.source->levels[i].size;
+
+		return size;
+	}
+}
\ No newline at end of file
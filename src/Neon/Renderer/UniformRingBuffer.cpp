@@ -0,0 +1,186 @@
+#include <iostream>
+
+#include <Neon/Renderer/Device.hpp>
+#include <Neon/Renderer/DescriptorLayoutCache.hpp>
+#include <Neon/Renderer/DescriptorAllocator.hpp>
+#include <Neon/Renderer/UniformRingBuffer.hpp>
+
+namespace Zx
+{
+	/*
+	@brief : Creates a persistently mapped uniform ring buffer, split in one region per frame in flight
+	@param : A reference to the Device
+	@param : The cache giving the layout of the descriptor set
+	@param : The allocator giving the descriptor set
+	@param : The size in bytes reserved for each frame
+	@param : The number of frames in flight
+	@param : The maximum size of one allocation, seen by the shader through the dynamic descriptor
+	*/
+	UniformRingBuffer::UniformRingBuffer(Device& device, DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator, VkDeviceSize frameSize, uint32_t frameCount,
+		VkDeviceSize range)
+	{
+		m_device = std::make_shared<Device>(device);
+		m_ringBuffer = std::make_shared<UniformRingBuffers>();
+
+		m_ringBuffer->frameSize = frameSize;
+		m_ringBuffer->frameCount = frameCount;
+		m_ringBuffer->range = range;
+
+		if (!CreateRingBuffer())
+			std::cout << "Failed to create uniform ring buffer" << std::endl;
+		else if (!CreateDescriptorSet(layoutCache, descriptorAllocator))
+			std::cout << "Failed to create uniform ring buffer descriptor set" << std::endl;
+
+		device = std::move(*m_device);
+	}
+
+	/*
+	@brief : Copy constructor
+	@param : A constant reference to the UniformRingBuffer to copy
+	*/
+	UniformRingBuffer::UniformRingBuffer(const UniformRingBuffer& uniformRingBuffer) : m_device(uniformRingBuffer.m_device), m_ringBuffer(uniformRingBuffer.m_ringBuffer)
+	{}
+
+	/*
+	@brief : Destroys a ring buffer, the memory is freed with the last owner of the buffer
+	*/
+	UniformRingBuffer::~UniformRingBuffer()
+	{}
+
+	/*
+	@brief : Rewinds the ring buffer on the region of a frame
+	@param : The index of the frame in flight, its fence must have been waited on
+	*/
+	void UniformRingBuffer::BeginFrame(uint32_t frameIndex)
+	{
+		m_ringBuffer->frameBegin = (frameIndex % m_ringBuffer->frameCount) * m_ringBuffer->frameSize;
+		m_ringBuffer->head = m_ringBuffer->frameBegin;
+	}
+
+	/*
+	@brief : Bump allocates an aligned block in the region of the current frame
+	@param : The size of the block, must not exceed the range of the descriptor
+	@param : The dynamic offset to give to vkCmdBindDescriptorSets
+	@return : Returns a pointer to the mapped memory, nullptr if the frame is full
+	*/
+	void* UniformRingBuffer::Allocate(VkDeviceSize size, uint32_t& dynamicOffset)
+	{
+		if (size > m_ringBuffer->range)
+		{
+			std::cout << "Uniform allocation of " << size << " bytes exceeds the range of the ring buffer" << std::endl;
+			return nullptr;
+		}
+
+		VkDeviceSize offset = AlignUp(m_ringBuffer->head, m_ringBuffer->alignment);
+
+		if (offset + size > m_ringBuffer->frameBegin + m_ringBuffer->frameSize)
+		{
+			std::cout << "Uniform ring buffer is full for this frame" << std::endl;
+			return nullptr;
+		}
+
+		m_ringBuffer->head = offset + size;
+		dynamicOffset = static_cast<uint32_t>(offset);
+
+		return static_cast<char*>(m_ringBuffer->buffer.GetData()) + offset;
+	}
+
+	/*
+	@brief : Makes the writes of the current frame visible to the device when the memory is not coherent
+	@return : Returns true if the flush is a success, false otherwise
+	*/
+	bool UniformRingBuffer::Flush()
+	{
+		if (m_ringBuffer->head == m_ringBuffer->frameBegin)
+			return true;
+
+		return m_ringBuffer->buffer.Flush(m_ringBuffer->frameBegin, m_ringBuffer->head - m_ringBuffer->frameBegin);
+	}
+
+	/*
+	@brief : Binds the descriptor set of the ring buffer with the offset of an allocation
+	@param : The command buffer in recording state
+	@param : The layout of the bound pipeline
+	@param : The set number of the ring buffer in the pipeline layout
+	@param : The dynamic offset returned by Allocate
+	*/
+	void UniformRingBuffer::Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, uint32_t dynamicOffset) const
+	{
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, set, 1, &m_ringBuffer->descriptorSet, 1, &dynamicOffset);
+	}
+
+	/*
+	@brief : Assigns the ring buffer by move semantic
+	@param : The ring buffer to move
+	@return : A reference to this
+	*/
+	UniformRingBuffer& UniformRingBuffer::operator=(UniformRingBuffer&& uniformRingBuffer) noexcept
+	{
+		std::swap(m_device, uniformRingBuffer.m_device);
+		std::swap(m_ringBuffer, uniformRingBuffer.m_ringBuffer);
+
+		return (*this);
+	}
+
+	//-------------------------Private method-------------------------
+
+	bool UniformRingBuffer::CreateRingBuffer()
+	{
+		VkPhysicalDeviceProperties deviceProperties;
+		vkGetPhysicalDeviceProperties(m_device->GetDevice()->physicalDevice, &deviceProperties);
+
+		m_ringBuffer->alignment = deviceProperties.limits.minUniformBufferOffsetAlignment;
+		m_ringBuffer->frameSize = AlignUp(m_ringBuffer->frameSize, m_ringBuffer->alignment);
+
+		if (m_ringBuffer->range > deviceProperties.limits.maxUniformBufferRange)
+			m_ringBuffer->range = deviceProperties.limits.maxUniformBufferRange;
+
+		// The last allocation of the last frame must still have a whole range behind it
+		VkDeviceSize bufferSize = m_ringBuffer->frameSize * m_ringBuffer->frameCount + m_ringBuffer->range;
+
+		// Host coherent memory is preferred by the buffer, it saves the flush of every frame
+		m_ringBuffer->buffer = Buffer(*m_device, bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+		if (!m_ringBuffer->buffer.IsValid())
+			return false;
+
+		BeginFrame(0);
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+
+	bool UniformRingBuffer::CreateDescriptorSet(DescriptorLayoutCache& layoutCache, DescriptorAllocator& descriptorAllocator)
+	{
+		VkDescriptorSetLayoutBinding layoutBinding =
+		{
+			0,
+			VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+			1,
+			VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+			nullptr
+		};
+
+		m_ringBuffer->descriptorSetLayout = layoutCache.GetLayout({ layoutBinding });
+
+		if (m_ringBuffer->descriptorSetLayout == VK_NULL_HANDLE)
+			return false;
+
+		// A single descriptor covers the whole buffer, the dynamic offset selects the allocation
+		m_ringBuffer->descriptorSet = descriptorAllocator.GetImmutableSet(m_ringBuffer->descriptorSetLayout,
+			{ DescriptorAllocator::BufferWrite(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, m_ringBuffer->buffer.GetBuffer(), 0, m_ringBuffer->range) });
+
+		return m_ringBuffer->descriptorSet != VK_NULL_HANDLE;
+	}
+
+	//-------------------------------------------------------------------------
+
+	VkDeviceSize UniformRingBuffer::AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+	{
+		if (alignment <= 1)
+			return value;
+
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+}
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include <iostream>
-#include <cstring>
 
 #include <Neon/Renderer/Device.hpp>
 #include <Neon/Renderer/VertexBuffer.hpp>
@@ -7,139 +6,64 @@
 namespace Zx
 {
 	/*
-	@brief : Constructs a vertex buffer
+	@brief : Constructs a device local vertex buffer filled with the given vertices
 	@param : A reference to the Device
+	@param : The vertices
+	@param : The number of vertices
+	@param : The size of one vertex in bytes
 	*/
-	VertexBuffer::VertexBuffer(Device& device)
+	VertexBuffer::VertexBuffer(Device& device, const void* vertices, uint32_t vertexCount, uint32_t stride) : m_vertexCount(vertexCount), m_stride(stride)
 	{
-		m_device = std::make_shared<Device>(device);
+		m_buffer = Buffer(device, static_cast<VkDeviceSize>(vertexCount) * stride, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertices);
 
-		if (!CreateVertexBuffer())
+		if (!m_buffer.IsValid())
 			std::cout << "Failed to create vertex buffer" << std::endl;
-
-		device = std::move(*m_device);
 	}
 
 	/*
-	@brief : Destroys a vertex buffer
+	@brief : Constructs a device local vertex buffer filled with the given vertices
+	@param : A reference to the Device
+	@param : The vertices
 	*/
-	VertexBuffer::~VertexBuffer()
-	{
-		if (m_vertexBuffer != VK_NULL_HANDLE)
-		{
-			vkDestroyBuffer(m_device->GetDevice()->logicalDevice, m_vertexBuffer, nullptr);
-			m_vertexBuffer = VK_NULL_HANDLE;
-		}
-	}
-
-	//----------------------------------Private methods----------------------------------
-
-	bool VertexBuffer::CreateVertexBuffer()
-	{
-		VertexData vertexData[] =
-		{
-			{
-				-0.7f, -0.7f, 0.0f, 1.0f,
-				1.0f, 0.0f, 0.0f, 0.0f
-			},
-			{
-				-0.7f, 0.7f, 0.0f, 1.0f,
-				0.0f, 1.0f, 0.0f, 0.0f
-			},
-			{
-				0.7f, -0.7f, 0.0f, 1.0f,
-				0.0f, 0.0f, 1.0f, 0.0f
-			},
-			{
-				0.7f, 0.7f, 0.0f, 1.0f,
-				0.3f, 0.3f, 0.3f, 0.0f
-			}
-		};
-
-		VkDeviceSize vertexSize = sizeof(vertexData);
-
-		VkBufferCreateInfo bufferCreateInfo =
-		{
-			VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-			nullptr,
-			0,
-			vertexSize,
-			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-			VK_SHARING_MODE_EXCLUSIVE,
-			0,
-			nullptr
-		};
-
-		if (vkCreateBuffer(m_device->GetDevice()->logicalDevice, &bufferCreateInfo, nullptr, &m_vertexBuffer) != VK_SUCCESS)
-		{
-			std::cout << "Failed to create buffer" << std::endl;
-			return false;
-		}
-
-		if (!AllocateBufferMemory(m_vertexBuffer, &m_memory))
-		{
-			std::cout << "Failed to allocate buffer memory" << std::endl;
-			return false;
-		}
-
-		if (vkBindBufferMemory(m_device->GetDevice()->logicalDevice, m_vertexBuffer, m_memory, 0) != VK_SUCCESS)
-		{
-			std::cout << "Failed to bind buffer memory" << std::endl;
-			return false;
-		}
-
-		void* vertexBufferMemoryPtr = nullptr;
-		if (vkMapMemory(m_device->GetDevice()->logicalDevice, m_memory, 0, vertexSize, 0, &vertexBufferMemoryPtr) != VK_SUCCESS)
-		{
-			std::cout << "Failed to map vertex buffer memory" << std::endl;
-			return false;
-		}
-
-		std::memcpy(vertexBufferMemoryPtr, vertexData, vertexSize);
+	VertexBuffer::VertexBuffer(Device& device, const std::vector<VertexData>& vertices) : VertexBuffer(device, vertices.data(), static_cast<uint32_t>(vertices.size()),
+		sizeof(VertexData))
+	{}
 
-		VkMappedMemoryRange mappedMemoryRange =
-		{
-			VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
-			nullptr,
-			m_memory,
-			0,
-			VK_WHOLE_SIZE
-		};
-		
-		vkFlushMappedMemoryRanges(m_device->GetDevice()->logicalDevice, 1, &mappedMemoryRange);
+	/*
+	@brief : Copy constructor, the copy shares the buffer
+	@param : A constant reference to the VertexBuffer to copy
+	*/
+	VertexBuffer::VertexBuffer(const VertexBuffer& vertexBuffer) : m_buffer(vertexBuffer.m_buffer), m_vertexCount(vertexBuffer.m_vertexCount), m_stride(vertexBuffer.m_stride)
+	{}
 
-		vkUnmapMemory(m_device->GetDevice()->logicalDevice, m_memory);
+	/*
+	@brief : Destroys a vertex buffer, the memory is freed with the last owner of the buffer
+	*/
+	VertexBuffer::~VertexBuffer()
+	{}
 
-		return true;
+	/*
+	@brief : Binds the vertex buffer
+	@param : The command buffer in recording state
+	@param : The binding of the vertex input
+	*/
+	void VertexBuffer::Bind(VkCommandBuffer commandBuffer, uint32_t binding) const
+	{
+		VkDeviceSize offset = 0;
+		vkCmdBindVertexBuffers(commandBuffer, binding, 1, &m_buffer.GetBuffer(), &offset);
 	}
 
-	//-------------------------------------------------------------------------
-
-	bool VertexBuffer::AllocateBufferMemory(const VkBuffer& buffer, VkDeviceMemory* memory)
+	/*
+	@brief : Assigns the vertex buffer by move semantic
+	@param : The vertex buffer to move
+	@return : A reference to this
+	*/
+	VertexBuffer& VertexBuffer::operator=(VertexBuffer&& vertexBuffer) noexcept
 	{
-		VkMemoryRequirements memoryRequirements;
-		vkGetBufferMemoryRequirements(m_device->GetDevice()->logicalDevice, buffer, &memoryRequirements);
-
-		VkPhysicalDeviceMemoryProperties memoryProperties;
-		vkGetPhysicalDeviceMemoryProperties(m_device->GetDevice()->physicalDevice, &memoryProperties);
-
-		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
-		{
-			if ((memoryRequirements.memoryTypeBits & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
-			{
-				VkMemoryAllocateInfo memoryAllocateInfo =
-				{
-					VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-					0,
-					memoryRequirements.size,
-					i
-				};
-
-				if (vkAllocateMemory(m_device->GetDevice()->logicalDevice, &memoryAllocateInfo, nullptr, memory) == VK_SUCCESS)
-					return true;
-			}
-		}
+		std::swap(m_buffer, vertexBuffer.m_buffer);
+		std::swap(m_vertexCount, vertexBuffer.m_vertexCount);
+		std::swap(m_stride, vertexBuffer.m_stride);
 
-		return false;
+		return (*this);
 	}
-}
+}
\ No newline at end of file
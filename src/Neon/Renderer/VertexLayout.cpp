@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <Neon/Utils.hpp>
+#include <Neon/Renderer/Pipeline.hpp>
+#include <Neon/Renderer/VertexLayout.hpp>
+
+#if defined(NEON_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace Zx
+{
+	namespace
+	{
+		// Float to half with round to nearest even, overflows give infinity and NaN stays NaN
+		inline uint16_t FloatToHalf(float value)
+		{
+			uint32_t bits = 0;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			uint32_t sign = bits & 0x80000000u;
+			bits ^= sign;
+
+			uint32_t half = 0;
+
+			if (bits >= ((127 + 16) << 23))
+				half = (bits > 0x7F800000u) ? 0x7E00u : 0x7C00u;
+			else if (bits < ((127 - 14) << 23))
+			{
+				// The addition of the magic number rounds the subnormal mantissa
+				const uint32_t magicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+
+				float magic = 0.0f;
+				float absolute = 0.0f;
+
+				std::memcpy(&magic, &magicBits, sizeof(magic));
+				std::memcpy(&absolute, &bits, sizeof(absolute));
+
+				absolute += magic;
+				std::memcpy(&half, &absolute, sizeof(half));
+				half -= magicBits;
+			}
+			else
+			{
+				uint32_t mantissaOdd = (bits >> 13) & 1;
+
+				bits += 0xFFFu - ((127 - 15) << 23);
+				bits += mantissaOdd;
+				half = bits >> 13;
+			}
+
+			return static_cast<uint16_t>(half | (sign >> 16));
+		}
+
+		inline int16_t FloatToSnorm16(float value)
+		{
+			value = std::min(std::max(value, -1.0f), 1.0f);
+
+			return static_cast<int16_t>(std::nearbyint(value * 32767.0f));
+		}
+
+#if defined(NEON_SSE2)
+		// Same conversion as FloatToHalf on 4 floats, the results are in the low 16 bits of each lane
+		inline __m128i FloatToHalf(__m128 value)
+		{
+			const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+			const __m128i halfMax = _mm_set1_epi32((127 + 16) << 23);
+			const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+			const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+			const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+			__m128 sign = _mm_and_ps(value, _mm_castsi128_ps(signMask));
+			__m128 absolute = _mm_xor_ps(value, sign);
+			__m128i absoluteBits = _mm_castps_si128(absolute);
+
+			__m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+			__m128i isRegular = _mm_cmpgt_epi32(halfMax, absoluteBits);
+			__m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absoluteBits);
+			__m128i special = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+
+			__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+			__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31);
+			__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absoluteBits, normalBias), mantissaOdd), 13);
+
+			__m128i regular = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+			__m128i half = _mm_or_si128(_mm_and_si128(isRegular, regular), _mm_andnot_si128(isRegular, special));
+
+			return _mm_or_si128(half, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+		}
+
+		// SSE2 has no unsigned saturating pack of 32 bits values, the values are shifted in the signed range and back
+		inline __m128i PackUint16(__m128i low, __m128i high)
+		{
+			const __m128i bias32 = _mm_set1_epi32(0x8000);
+			const __m128i bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+
+			return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(low, bias32), _mm_sub_epi32(high, bias32)), bias16);
+		}
+#endif
+	}
+
+	/*
+	@brief : Starts an empty layout for a binding of the vertex input
+	@param : The binding of the layout
+	@param : The rate of the binding, per vertex or per instance
+	*/
+	VertexLayout::VertexLayout(uint32_t binding, VkVertexInputRate inputRate) : m_attributes(), m_binding(binding), m_stride(0), m_inputRate(inputRate)
+	{}
+
+	/*
+	@brief : Appends an attribute after the previous ones
+	@param : The location of the attribute in the shader
+	@param : The format of the attribute in memory, the shader reads it as floats for the float, unorm and snorm formats
+	@return : A reference to this
+	*/
+	VertexLayout& VertexLayout::Add(uint32_t location, VkFormat format)
+	{
+		m_attributes.push_back({ location, m_binding, format, m_stride });
+		m_stride += GetFormatSize(format);
+
+		return (*this);
+	}
+
+	/*
+	@brief : Replaces the description of the binding of the layout in the vertex input of a pipeline
+	@param : The description of the pipeline
+	*/
+	void VertexLayout::Apply(PipelineInfo& info) const
+	{
+		uint32_t binding = m_binding;
+
+		info.vertexBindings.erase(std::remove_if(info.vertexBindings.begin(), info.vertexBindings.end(), [binding](const VkVertexInputBindingDescription& description)
+		{
+			return description.binding == binding;
+		}), info.vertexBindings.end());
+
+		info.vertexAttributes.erase(std::remove_if(info.vertexAttributes.begin(), info.vertexAttributes.end(), [binding](const VkVertexInputAttributeDescription& description)
+		{
+			return description.binding == binding;
+		}), info.vertexAttributes.end());
+
+		info.vertexBindings.push_back({ m_binding, m_stride, m_inputRate });
+		info.vertexAttributes.insert(info.vertexAttributes.end(), m_attributes.begin(), m_attributes.end());
+	}
+
+	/*
+	@brief : Gives the layout of CompactVertexData, the normal is decoded from its octahedral form in the shader
+	@param : The binding of the layout
+	@return : The layout, position at location 0, color at location 1 and normal at location 2
+	*/
+	VertexLayout VertexLayout::Compact(uint32_t binding)
+	{
+		VertexLayout layout(binding);
+
+		layout.Add(0, VK_FORMAT_R16G16B16A16_SFLOAT)
+			.Add(1, VK_FORMAT_R8G8B8A8_UNORM)
+			.Add(2, VK_FORMAT_R16G16_SNORM);
+
+		return layout;
+	}
+
+	/*
+	@brief : Gives the size of a vertex attribute format
+	@param : The format
+	@return : The size in bytes, 0 for a format not used by vertex attributes
+	*/
+	uint32_t VertexLayout::GetFormatSize(VkFormat format)
+	{
+		switch (format)
+		{
+		case VK_FORMAT_R8_UNORM:
+			return 1;
+		case VK_FORMAT_R8G8_UNORM:
+			return 2;
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R8G8B8A8_SNORM:
+		case VK_FORMAT_R8G8B8A8_UINT:
+		case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+		case VK_FORMAT_A2B10G10R10_SNORM_PACK32:
+		case VK_FORMAT_R16G16_UNORM:
+		case VK_FORMAT_R16G16_SNORM:
+		case VK_FORMAT_R16G16_SFLOAT:
+		case VK_FORMAT_R32_UINT:
+		case VK_FORMAT_R32_SFLOAT:
+			return 4;
+		case VK_FORMAT_R16G16B16A16_UNORM:
+		case VK_FORMAT_R16G16B16A16_SNORM:
+		case VK_FORMAT_R16G16B16A16_SFLOAT:
+		case VK_FORMAT_R32G32_SFLOAT:
+			return 8;
+		case VK_FORMAT_R32G32B32_SFLOAT:
+			return 12;
+		case VK_FORMAT_R32G32B32A32_UINT:
+		case VK_FORMAT_R32G32B32A32_SFLOAT:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	/*
+	@brief : Converts floats to half floats, rounded to the nearest even
+	@param : The floats
+	@param : The half floats
+	@param : The number of floats
+	*/
+	void PackHalf(const float* source, uint16_t* destination, std::size_t count)
+	{
+		std::size_t i = 0;
+
+#if defined(NEON_SSE2)
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i low = FloatToHalf(_mm_loadu_ps(source + i));
+			__m128i high = FloatToHalf(_mm_loadu_ps(source + i + 4));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), PackUint16(low, high));
+		}
+#endif
+
+		for (; i < count; i++)
+			destination[i] = FloatToHalf(source[i]);
+	}
+
+	/*
+	@brief : Converts floats clamped to [0, 1] to unsigned normalized bytes
+	@param : The floats
+	@param : The bytes
+	@param : The number of floats
+	*/
+	void PackUnorm8(const float* source, uint8_t* destination, std::size_t count)
+	{
+		std::size_t i = 0;
+
+#if defined(NEON_SSE2)
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(255.0f);
+
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i values[4];
+
+			// The conversion rounds to the nearest, the packs cannot saturate after the clamp
+			for (std::size_t j = 0; j < 4; j++)
+				values[j] = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + j * 4), zero), one), scale));
+
+			__m128i bytes = _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), bytes);
+		}
+#endif
+
+		for (; i < count; i++)
+			destination[i] = static_cast<uint8_t>(std::nearbyint(std::min(std::max(source[i], 0.0f), 1.0f) * 255.0f));
+	}
+
+	/*
+	@brief : Encodes unit normals on the octahedron, two signed normalized shorts per normal
+	@param : The normals, 3 floats each
+	@param : The encoded normals, 2 shorts each
+	@param : The number of normals
+	*/
+	void PackOctahedral(const float* normals, int16_t* destination, std::size_t count)
+	{
+		std::size_t i = 0;
+
+#if defined(NEON_SSE2)
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 epsilon = _mm_set1_ps(1e-20f);
+		const __m128 scale = _mm_set1_ps(32767.0f);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const float* n = normals + i * 3;
+
+			__m128 x = _mm_setr_ps(n[0], n[3], n[6], n[9]);
+			__m128 y = _mm_setr_ps(n[1], n[4], n[7], n[10]);
+			__m128 z = _mm_setr_ps(n[2], n[5], n[8], n[11]);
+
+			// Projection on the octahedron |x| + |y| + |z| = 1
+			__m128 length = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z));
+			__m128 inverse = _mm_div_ps(one, _mm_max_ps(length, epsilon));
+
+			__m128 u = _mm_mul_ps(x, inverse);
+			__m128 v = _mm_mul_ps(y, inverse);
+
+			// The lower hemisphere is folded on the corners of the square
+			__m128 foldedU = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, v)), _mm_or_ps(_mm_and_ps(u, signMask), one));
+			__m128 foldedV = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)), _mm_or_ps(_mm_and_ps(v, signMask), one));
+			__m128 isLower = _mm_cmplt_ps(z, _mm_setzero_ps());
+
+			u = _mm_or_ps(_mm_and_ps(isLower, foldedU), _mm_andnot_ps(isLower, u));
+			v = _mm_or_ps(_mm_and_ps(isLower, foldedV), _mm_andnot_ps(isLower, v));
+
+			__m128i packedU = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(u, _mm_sub_ps(_mm_setzero_ps(), one)), one), scale));
+			__m128i packedV = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, _mm_sub_ps(_mm_setzero_ps(), one)), one), scale));
+
+			// u0 v0 u1 v1 u2 v2 u3 v3
+			__m128i shorts = _mm_packs_epi32(packedU, packedV);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 2), _mm_unpacklo_epi16(shorts, _mm_srli_si128(shorts, 8)));
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			const float* n = normals + i * 3;
+
+			float length = std::fabs(n[0]) + std::fabs(n[1]) + std::fabs(n[2]);
+			float inverse = 1.0f / std::max(length, 1e-20f);
+
+			float u = n[0] * inverse;
+			float v = n[1] * inverse;
+
+			if (n[2] < 0.0f)
+			{
+				float foldedU = (1.0f - std::fabs(v)) * ((u >= 0.0f) ? 1.0f : -1.0f);
+				float foldedV = (1.0f - std::fabs(u)) * ((v >= 0.0f) ? 1.0f : -1.0f);
+
+				u = foldedU;
+				v = foldedV;
+			}
+
+			destination[i * 2] = FloatToSnorm16(u);
+			destination[i * 2 + 1] = FloatToSnorm16(v);
+		}
+	}
+
+	/*
+	@brief : Converts vertices to the compact format
+	@param : The vertices
+	@param : The unit normals of the vertices, 3 floats each, nullptr to point them all along +z
+	@param : The compact vertices
+	*/
+	void PackVertices(const std::vector<VertexData>& vertices, const float* normals, std::vector<CompactVertexData>& compactVertices)
+	{
+		compactVertices.resize(vertices.size());
+
+		for (std::size_t i = 0; i < vertices.size(); i++)
+		{
+			PackHalf(&vertices[i].x, compactVertices[i].position, 4);
+			PackUnorm8(&vertices[i].r, compactVertices[i].color, 4);
+		}
+
+		if (normals != nullptr)
+		{
+			std::vector<int16_t> packedNormals(vertices.size() * 2);
+			PackOctahedral(normals, packedNormals.data(), vertices.size());
+
+			for (std::size_t i = 0; i < vertices.size(); i++)
+			{
+				compactVertices[i].normal[0] = packedNormals[i * 2];
+				compactVertices[i].normal[1] = packedNormals[i * 2 + 1];
+			}
+		}
+		else
+		{
+			for (CompactVertexData& compactVertex : compactVertices)
+				compactVertex.normal[0] = compactVertex.normal[1] = 0;
+		}
+	}
+}
\ No newline at end of file
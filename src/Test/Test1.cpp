@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <thread>
 
 #include <Neon/Utils.hpp>
@@ -10,8 +12,21 @@
 #include <Neon/Renderer/Renderer.hpp>
 #include <Neon/Renderer/Pipeline.hpp>
 #include <Neon/Renderer/RenderPass.hpp>
+#include <Neon/Renderer/RenderGraph.hpp>
 #include <Neon/Renderer/Window.hpp>
-#include <Neon/Renderer/VertexBuffer.hpp>
+#include <Neon/Renderer/GeometryPool.hpp>
+#include <Neon/Renderer/MeshLod.hpp>
+#include <Neon/Renderer/IndirectDrawBuffer.hpp>
+#include <Neon/Renderer/CullingPass.hpp>
+#include <Neon/Renderer/DeferredLighting.hpp>
+#include <Neon/Renderer/ClusteredLighting.hpp>
+#include <Neon/Renderer/InstanceBuffer.hpp>
+#include <Neon/Renderer/ImageUploader.hpp>
+#include <Neon/Renderer/TextureStreamer.hpp>
+#include <Neon/Renderer/DescriptorAllocator.hpp>
+#include <Neon/Renderer/UniformRingBuffer.hpp>
+#include <Neon/Renderer/BindlessTable.hpp>
+#include <Neon/Renderer/FramePacer.hpp>
 #include <Neon/Renderer/ShaderModule.hpp>
 #include <Neon/Renderer/Sync.hpp>
 #include <Neon/Renderer/CommandBuffers.hpp>
@@ -19,24 +34,69 @@
 
 namespace Zx
 {
-	Test1::Test1(const RenderPass& renderPass, const SwapChain& swapChain, const Pipeline& pipeline, const VertexBuffer& vertexBuffer, const Device& device, const Window& window,
-		const CommandBuffers& commandBuffers, const std::vector<RenderingResourcesData>& renderingResources)
+	// The sample has no camera, its geometry is already in clip space
+	static const float IdentityViewProjection[16] =
+	{
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f
+	};
+
+	/*
+	@brief : The scene of a frame, built by the event thread and read by the render thread while the next one is built
+	*/
+	struct Test1::FrameData
+	{
+		// The copies of each mesh, drawn as the instances of a single draw
+		std::vector<std::vector<InstanceData>> instances;
+		std::vector<PointLight> lights;
+
+		float viewProjection[16];
+	};
+
+	Test1::Test1(const RenderPass& renderPass, const SwapChain& swapChain, const Pipeline& pipeline, const GeometryPool& geometryPool, const std::vector<std::vector<MeshLod>>& meshes, const IndirectDrawBuffer& indirectBuffer, const CullingPass& cullingPass, const DeferredLighting& deferredLighting, const ClusteredLighting& clusteredLighting, const InstanceBuffer& instanceBuffer, const ImageUploader& imageUploader, uint32_t textureIndex,
+		const TextureStreamer& textureStreamer, uint32_t streamedTexture, const UniformRingBuffer& uniformBuffer, const DescriptorAllocator& descriptorAllocator, const BindlessTable& bindlessTable, const FramePacer& framePacer, const Device& device, const Window& window, const CommandBuffers& commandBuffers, const std::vector<RenderingResourcesData>& renderingResources)
 	{
 		m_renderPass = std::make_shared<RenderPass>(renderPass);
 		m_swapChain = std::make_shared<SwapChain>(swapChain);
 		m_pipeline = std::make_shared<Pipeline>(pipeline);
-		m_vertexBuffer = std::make_shared<VertexBuffer>(vertexBuffer);
+		m_geometryPool = std::make_shared<GeometryPool>(geometryPool);
+		m_meshes = std::make_shared<std::vector<std::vector<MeshLod>>>(meshes);
+		m_indirectBuffer = std::make_shared<IndirectDrawBuffer>(indirectBuffer);
+		m_cullingPass = std::make_shared<CullingPass>(cullingPass);
+		m_deferredLighting = std::make_shared<DeferredLighting>(deferredLighting);
+		m_clusteredLighting = std::make_shared<ClusteredLighting>(clusteredLighting);
+		m_instanceBuffer = std::make_shared<InstanceBuffer>(instanceBuffer);
+		m_imageUploader = std::make_shared<ImageUploader>(imageUploader);
+		m_textureStreamer = std::make_shared<TextureStreamer>(textureStreamer);
+		m_uniformBuffer = std::make_shared<UniformRingBuffer>(uniformBuffer);
+		m_descriptorAllocator = std::make_shared<DescriptorAllocator>(descriptorAllocator);
+		m_bindlessTable = std::make_shared<BindlessTable>(bindlessTable);
+		m_framePacer = std::make_shared<FramePacer>(framePacer);
 		m_device = std::make_shared<Device>(device);
 		m_window = std::make_shared<Window>(window);
 		m_commandBuffers = std::make_shared<CommandBuffers>(commandBuffers);
 		m_renderingResources = std::make_shared<std::vector<RenderingResourcesData>>(renderingResources);
+		m_textureIndex = textureIndex;
+		m_streamedTexture = streamedTexture;
+
+		// The queue holds the draws of both frames and the resizes between them
+		m_frames = std::make_shared<std::vector<FrameData>>(2);
+		m_commands = std::make_shared<SpscQueue<RenderCommand>>(16);
+		m_freeFrames = std::make_shared<SpscQueue<uint32_t>>(m_frames->size());
+
+		for (uint32_t i = 0; i < m_frames->size(); i++)
+			m_freeFrames->Push(i);
+
+		m_renderAvailable = false;
+		m_renderFailed = false;
+		m_doneCommands = 0;
+		m_pushedCommands = 0;
 	}
 
-	bool Test1::PrepareFrame(VkCommandBuffer commandBuffer, const VkImageView& view, VkFramebuffer& framebuffer)
+	bool Test1::PrepareFrame(VkCommandBuffer commandBuffer, uint32_t imageIndex)
 	{
-		if (!m_renderPass->CreateFramebuffer(framebuffer, view))
-			return false;
-
 		VkCommandBufferBeginInfo commandBuffersBeginInfo =
 		{
 			VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -47,67 +107,148 @@ namespace Zx
 
 		vkBeginCommandBuffer(commandBuffer, &commandBuffersBeginInfo);
 
-		VkClearValue clearValue =
+		// The GPU time of the frame covers every command of its buffer
+		m_framePacer->WriteBeginTimestamp(commandBuffer);
+
+		// The streamed levels are staged with the other images, a texture keeps its current levels when they cannot be
+		m_textureStreamer->Update(commandBuffer);
+
+		// The images staged during the frame are copied before anything samples them
+		if (!m_imageUploader->Record(commandBuffer))
+			return false;
+
+		uint32_t dynamicOffset = 0;
+		float* transform = static_cast<float*>(m_uniformBuffer->Allocate(16 * sizeof(float), dynamicOffset));
+
+		if (transform == nullptr)
+			return false;
+
+		for (std::size_t i = 0; i < 16; i++)
+			transform[i] = IdentityViewProjection[i];
+
+		RenderGraph& renderGraph = m_renderPass->DeclareFrame(imageIndex);
+		uint32_t indirectBuffer = renderGraph.ImportBuffer(m_indirectBuffer->GetBuffer());
+
+		// Without an async compute queue the culling runs on the graphics queue, the graph orders the indirect draws after it
+		if (m_cullingPass->IsValid() && !m_cullingPass->IsAsync())
 		{
-			{ 1.0f, 0.8f, 0.4f, 0.0f },
-		};
+			uint32_t culling = renderGraph.AddPass(false, [this](VkCommandBuffer cullingCommandBuffer)
+			{
+				m_cullingPass->Record(cullingCommandBuffer, IdentityViewProjection);
+			});
+
+			renderGraph.Write(culling, indirectBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+		}
 
-		VkRenderPassBeginInfo renderPassBeginInfo =
+		// The G-buffer clears to a black albedo and a null normal, the lighting leaves those pixels dark
+		uint32_t firstSubpass = m_renderPass->DeclareSubpasses([this, dynamicOffset](VkCommandBuffer subpassCommandBuffer, uint32_t subpass)
 		{
-			VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-			nullptr,
-			m_renderPass->GetRenderPass(),
-			framebuffer,
+			RecordSubpass(subpassCommandBuffer, subpass, dynamicOffset);
+		}, { 1.0f, 0.8f, 0.4f, 0.0f });
+
+		renderGraph.Read(firstSubpass, indirectBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+
+		if (!renderGraph.Compile())
+			return false;
+
+		renderGraph.Execute(commandBuffer);
+
+		m_framePacer->WriteEndTimestamp(commandBuffer);
+
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
 		{
-			{
-				0,
-				0
-			},
-			m_swapChain->GetSwapChain()->extent,
-		},
-			1,
-			&clearValue
-		};
+			std::cout << "Failed to end command buffers" << std::endl;
+			return false;
+		}
 
-		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetPipeline());
+		return true;
+	}
 
-		VkViewport viewPort =
+	void Test1::RecordSubpass(VkCommandBuffer commandBuffer, uint32_t subpass, uint32_t dynamicOffset)
+	{
+		// The lighting subpass reads the G-buffer of the same pixel, the sample has no camera to invert
+		if (m_renderPass->IsDeferred() && (subpass == 1))
 		{
-			0,
-			0,
-			static_cast<float>(m_swapChain->GetSwapChain()->extent.width),
-			static_cast<float>(m_swapChain->GetSwapChain()->extent.height),
-			0,
-			1,
-		};
+			m_deferredLighting->Record(commandBuffer, IdentityViewProjection);
+			return;
+		}
 
-		VkRect2D scissor =
+		// The sets and buffers bound in the first subpass stay valid in the next one
+		if (subpass == 0)
 		{
+			VkViewport viewPort =
 			{
 				0,
-				0
-			},
-			m_swapChain->GetSwapChain()->extent
-		};
+				0,
+				static_cast<float>(m_swapChain->GetSwapChain()->extent.width),
+				static_cast<float>(m_swapChain->GetSwapChain()->extent.height),
+				0,
+				1,
+			};
 
-		vkCmdSetViewport(commandBuffer, 0, 1, &viewPort);
-		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+			VkRect2D scissor =
+			{
+				{
+					0,
+					0
+				},
+				m_swapChain->GetSwapChain()->extent
+			};
 
-		VkDeviceSize offset = 0;
-		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_vertexBuffer->GetVertexBuffer(), &offset);
+			vkCmdSetViewport(commandBuffer, 0, 1, &viewPort);
+			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-		vkCmdDraw(commandBuffer, 4, 1, 0, 0);
+			m_uniformBuffer->Bind(commandBuffer, m_pipeline->GetPipelineLayout(), 0, dynamicOffset);
 
-		vkCmdEndRenderPass(commandBuffer);
+			if (m_bindlessTable->IsAvailable())
+			{
+				// The streamed texture replaces the loaded one once its first levels are resident
+				uint32_t textureIndex = m_textureStreamer->GetTextureIndex(m_streamedTexture);
 
-		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+				if (textureIndex == BindlessTable::InvalidIndex)
+					textureIndex = m_textureIndex;
+
+				const uint32_t materialIndices[4] = { textureIndex, BindlessTable::InvalidIndex, BindlessTable::InvalidIndex, BindlessTable::InvalidIndex };
+
+				m_bindlessTable->Bind(commandBuffer, m_pipeline->GetPipelineLayout(), 1);
+				m_bindlessTable->PushIndices(commandBuffer, m_pipeline->GetPipelineLayout(), materialIndices, 4);
+			}
+
+			if (UseClusteredLighting())
+				m_clusteredLighting->Bind(commandBuffer, m_pipeline->GetPipelineLayout(), m_bindlessTable->IsAvailable() ? 2 : 1);
+
+			m_geometryPool->Bind(commandBuffer);
+			m_instanceBuffer->Bind(commandBuffer);
+		}
+
+		// The pre-pass draws the same commands with the depth only pipeline, a pipeline without depth test has none and leaves the pre-pass empty
+		if (m_renderPass->HasDepthPrePass() && (subpass == 0))
 		{
-			std::cout << "Failed to end command buffers" << std::endl;
-			return false;
+			if (m_pipeline->GetDepthPipeline() == VK_NULL_HANDLE)
+				return;
+
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetDepthPipeline());
 		}
+		else
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetPipeline());
 
-		return true;
+		RecordDraws(commandBuffer);
+	}
+
+	void Test1::RecordDraws(VkCommandBuffer commandBuffer)
+	{
+		// The submission cost stays the same whatever the number of meshes
+		if (m_cullingPass->IsValid())
+			m_indirectBuffer->DrawCount(commandBuffer);
+		else
+			m_indirectBuffer->Draw(commandBuffer, *m_instanceBuffer);
+	}
+
+	bool Test1::UseClusteredLighting() const
+	{
+		// The pipeline layout only has the set of the clusters on the forward path
+		return !m_renderPass->IsDeferred() && m_clusteredLighting->IsValid();
 	}
 
 	void Test1::ChildClear() {
@@ -116,19 +257,31 @@ namespace Zx
 
 	bool Test1::ChildOnWindowSizeChanged()
 	{
-		return true;
+		// The depth, multisampled and G-buffer attachments follow the extent of the swap chain
+		if (!m_renderPass->CreateAttachments())
+			return false;
+
+		return !m_deferredLighting->IsValid() || m_deferredLighting->UpdateInputAttachments();
 	}
 
 	bool Test1::OnWindowSizeChanged()
 	{
-		return true;
+		// The previous swap chain and attachments are retired, the frames in flight keep rendering to them
+		if (!m_swapChain->CreateSwapChain())
+			return false;
+
+		if (!m_swapChain->IsRenderAvailable())
+			return true;
+
+		return ChildOnWindowSizeChanged();
 	}
 
-	bool Test1::Draw() 
+	bool Test1::Draw(const FrameData& frame) 
 	{
 		static std::size_t resourcesIndex = 0;
 
 		RenderingResourcesData &currentRenderingResources = (*m_renderingResources)[resourcesIndex];
+		uint32_t frameIndex = static_cast<uint32_t>(resourcesIndex);
 
 		VkSwapchainKHR swap_chain = m_swapChain->GetSwapChain()->swapChain;
 		uint32_t imageIndex = 0;
@@ -141,7 +294,26 @@ namespace Zx
 			return false;
 		}
 
-		vkResetFences(m_device->GetDevice()->logicalDevice, 1, &currentRenderingResources.fence);
+		// The fence guarantees the device is done with the uniforms and descriptor sets of this frame, the shared frame counter is advanced once
+		// before the retire queues read it, even when the frame returns early on an out of date swap chain
+		m_device->BeginFrame();
+		m_swapChain->BeginFrame();
+		m_renderPass->BeginFrame();
+		m_uniformBuffer->BeginFrame(frameIndex);
+		m_descriptorAllocator->BeginFrame(frameIndex);
+		m_bindlessTable->BeginFrame();
+		m_geometryPool->BeginFrame();
+		m_indirectBuffer->BeginFrame(frameIndex);
+		m_cullingPass->BeginFrame(frameIndex);
+		m_deferredLighting->BeginFrame(frameIndex);
+		m_clusteredLighting->BeginFrame(frameIndex);
+		m_instanceBuffer->BeginFrame(frameIndex);
+		m_imageUploader->BeginFrame(frameIndex);
+		m_textureStreamer->BeginFrame();
+		m_framePacer->BeginFrame(frameIndex);
+
+		// The sample mesh spans the height of the screen
+		m_textureStreamer->Request(m_streamedTexture, static_cast<float>(m_swapChain->GetSwapChain()->extent.height));
 
 		VkResult result = vkAcquireNextImageKHR(m_device->GetDevice()->logicalDevice, swap_chain, UINT64_MAX, currentRenderingResources.imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
 
@@ -156,21 +328,93 @@ namespace Zx
 			return false;
 		}
 
-		if (!PrepareFrame(currentRenderingResources.commandBuffer, m_swapChain->GetSwapChain()->imageView[imageIndex], currentRenderingResources.framebuffer))
+		// The fence stays signaled when no image is acquired, the next wait on it does not block
+		vkResetFences(m_device->GetDevice()->logicalDevice, 1, &currentRenderingResources.fence);
+
+		// Every copy of a mesh is an instance of the same draw, the sample meshes fit in the unit sphere
+		const float center[3] = { 0.0f, 0.0f, 0.0f };
+
+		for (std::size_t i = 0; i < m_meshes->size(); i++)
+		{
+			const std::vector<InstanceData>& copies = frame.instances[i];
+
+			if (copies.empty())
+				continue;
+
+			const std::vector<MeshLod>& lods = (*m_meshes)[i];
+			const MeshRange& mesh = lods[SelectMeshLod(lods, center, 1.0f, frame.viewProjection, static_cast<float>(m_swapChain->GetSwapChain()->extent.height))].mesh;
+
+			uint32_t instanceCount = static_cast<uint32_t>(copies.size());
+			uint32_t firstInstance = 0;
+			InstanceData* instances = m_instanceBuffer->Allocate(instanceCount, firstInstance);
+
+			if (instances == nullptr)
+				return false;
+
+			std::memcpy(instances, copies.data(), instanceCount * sizeof(InstanceData));
+
+			// The shader tests each copy at the translation of its transform and appends a command for the visible ones
+			if (m_cullingPass->IsValid())
+			{
+				for (uint32_t j = 0; j < instanceCount; j++)
+					m_cullingPass->AddInstance(mesh, copies[j].transform + 12, 1.0f, firstInstance + j);
+			}
+			else
+				m_indirectBuffer->AddDraw(mesh, instanceCount, firstInstance);
+		}
+
+		if (!m_instanceBuffer->Flush())
+			return false;
+
+		for (const PointLight& light : frame.lights)
+		{
+			if (m_deferredLighting->IsValid() && !m_deferredLighting->AddLight(light))
+				return false;
+
+			if (UseClusteredLighting() && !m_clusteredLighting->AddLight(light))
+				return false;
+		}
+
+		if (m_deferredLighting->IsValid() && !m_deferredLighting->Flush())
+			return false;
+
+		// The sample has no camera, the clusters cover a default perspective of the extent of the swap chain
+		const VkExtent2D& extent = m_swapChain->GetSwapChain()->extent;
+		const ClusterProjection projection = { 1.0f, static_cast<float>(extent.width) / std::max(extent.height, 1u), 0.1f, 100.0f };
+
+		if (UseClusteredLighting() && !m_clusteredLighting->Assign(IdentityViewProjection, projection, extent))
+			return false;
+
+		// A list built by the culling shader is never written by the host, the count would race with the one the shader appends to
+		if (!m_cullingPass->IsValid() && !m_indirectBuffer->Flush())
+			return false;
+
+		// The async culling overlaps the graphics work of the previous frame
+		if (m_cullingPass->IsValid() && (!m_cullingPass->Flush() || (m_cullingPass->IsAsync() && !m_cullingPass->Submit(IdentityViewProjection))))
+			return false;
+
+		if (!PrepareFrame(currentRenderingResources.commandBuffer, imageIndex))
 		{
 			std::cout << "Failed to prepare frame" << std::endl;
 			return false;
 		}
 
-		VkPipelineStageFlags wait_dst_stage_mask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		if (!m_uniformBuffer->Flush())
+			return false;
+
+		// The indirect draws wait on the async culling of the frame
+		bool waitCulling = m_cullingPass->IsValid() && m_cullingPass->IsAsync();
+
+		VkSemaphore wait_semaphores[2] = { currentRenderingResources.imageAvailableSemaphore, waitCulling ? m_cullingPass->GetSemaphore() : VK_NULL_HANDLE };
+		VkPipelineStageFlags wait_dst_stage_mask[2] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT };
 		VkSubmitInfo submit_info = {
 			VK_STRUCTURE_TYPE_SUBMIT_INFO,
 			nullptr,
+			waitCulling ? 2u : 1u,
+			wait_semaphores,
+			wait_dst_stage_mask,
 			1,
-			&currentRenderingResources.imageAvailableSemaphore,
-			&wait_dst_stage_mask,
-			1,
-			&(*m_renderingResources)[imageIndex].commandBuffer,
+			&currentRenderingResources.commandBuffer,
 			1,
 			&currentRenderingResources.finishedRenderingSemaphore
 		};
@@ -180,10 +424,12 @@ namespace Zx
 			return false;
 		}
 
+		m_framePacer->EndFrame();
+
 		VkPresentInfoKHR present_info =
 		{
 			VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-			nullptr,
+			m_framePacer->NextPresentId(),
 			1,
 			&currentRenderingResources.finishedRenderingSemaphore,
 			1,
@@ -207,6 +453,121 @@ namespace Zx
 		return true;
 	}
 
+	void Test1::RenderThread()
+	{
+		RenderCommand command;
+
+		while (true)
+		{
+			if (!m_commands->Pop(command))
+			{
+				std::unique_lock<std::mutex> lock(m_wakeMutex);
+				m_renderWake.wait(lock, [this, &command]() { return m_commands->Pop(command); });
+			}
+
+			if (command.type == QuitCommand)
+				break;
+
+			bool result = true;
+
+			if (command.type == ResizeCommand)
+				result = OnWindowSizeChanged();
+			else if (m_swapChain->IsRenderAvailable())
+			{
+				// The frame is submitted as late as it can still be shown
+				m_framePacer->Wait();
+				result = Draw((*m_frames)[command.frame]);
+			}
+
+			// The event thread builds one of its next frames in the data of this one
+			if (command.type == DrawCommand)
+				m_freeFrames->Push(command.frame);
+
+			m_renderAvailable = m_swapChain->IsRenderAvailable();
+
+			if (!result)
+				m_renderFailed = true;
+
+			m_doneCommands++;
+
+			{
+				// The event thread checks its conditions under the lock, it cannot miss the notification
+				std::lock_guard<std::mutex> lock(m_wakeMutex);
+				m_eventWake.notify_one();
+			}
+
+			if (!result)
+				break;
+		}
+	}
+
+	bool Test1::SubmitFrame()
+	{
+		uint32_t frame = 0;
+
+		// Both frames are in use while the render thread is behind, the next one waits for it
+		if (!m_freeFrames->Pop(frame))
+		{
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			m_eventWake.wait(lock, [this, &frame]() { return m_renderFailed || m_freeFrames->Pop(frame); });
+		}
+
+		if (m_renderFailed)
+			return false;
+
+		Simulate((*m_frames)[frame]);
+
+		return PushCommand({ DrawCommand, frame });
+	}
+
+	bool Test1::PushCommand(const RenderCommand& command)
+	{
+		if (!m_commands->Push(command))
+		{
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			m_eventWake.wait(lock, [this, &command]() { return m_renderFailed || m_commands->Push(command); });
+		}
+
+		if (m_renderFailed)
+			return false;
+
+		m_pushedCommands++;
+
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_renderWake.notify_one();
+		}
+
+		return true;
+	}
+
+	bool Test1::WaitForRenderThread()
+	{
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_eventWake.wait(lock, [this]() { return m_renderFailed || (m_doneCommands == m_pushedCommands); });
+
+		return !m_renderFailed;
+	}
+
+	void Test1::Simulate(FrameData& frame) const
+	{
+		// The sample scene does not move, a game would update it from the input of the frame here
+		InstanceData instance;
+		std::memcpy(instance.transform, IdentityViewProjection, sizeof(instance.transform));
+
+		for (std::size_t i = 0; i < 4; i++)
+			instance.color[i] = 1.0f;
+
+		// A single copy of each mesh, the copies of a mesh share its draw
+		frame.instances.assign(m_meshes->size(), std::vector<InstanceData>(1, instance));
+
+		// A white light in front of the sample mesh
+		const PointLight light = { { 0.0f, 0.0f, -1.0f }, 4.0f, { 1.0f, 1.0f, 1.0f }, 1.0f };
+		frame.lights.assign(1, light);
+
+		std::memcpy(frame.viewProjection, IdentityViewProjection, sizeof(frame.viewProjection));
+	}
+
 #if defined(NEON_WINDOWS)
 	bool Test1::RenderingLoop()
 	{
@@ -220,8 +581,16 @@ namespace Zx
 		bool resize = false;
 		bool result = true;
 
+		// This thread handles the messages and builds the frames, the render thread submits them
+		m_renderAvailable = m_swapChain->IsRenderAvailable();
+		std::thread renderThread(&Test1::RenderThread, this);
+
 		while (loop) {
-			if (PeekMessage(&message, NULL, 0, 0, PM_REMOVE))
+			// A window that cannot render sleeps until its next message
+			if (!m_renderAvailable && !resize)
+				WaitMessage();
+
+			while (PeekMessage(&message, NULL, 0, 0, PM_REMOVE))
 			{
 				// Process events
 				switch (message.message) {
@@ -237,32 +606,34 @@ namespace Zx
 				TranslateMessage(&message);
 				DispatchMessage(&message);
 			}
-			else {
-				// Resize
-				if (resize) {
-					resize = false;
-					if (!OnWindowSizeChanged())
-					{
-						result = false;
-						break;
-					}
-				}
-				// Draw
-				if (m_swapChain->IsRenderAvailable())
+
+			if (!loop)
+				break;
+
+			// Resize, the render thread recreates the swap chain before the loop knows if it can render
+			if (resize) {
+				resize = false;
+				if (!PushCommand({ ResizeCommand, 0 }) || !WaitForRenderThread())
 				{
-					if (!Draw())
-					{
-						result = false;
-						break;
-					}
+					result = false;
+					break;
 				}
-				else
+			}
+			// Draw, the frame is built while the render thread submits the previous one
+			if (m_renderAvailable)
+			{
+				if (!SubmitFrame())
 				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(100));
+					result = false;
+					break;
 				}
 			}
 		}
 
+		// The frames already queued are submitted before the render thread stops
+		PushCommand({ QuitCommand, 0 });
+		renderThread.join();
+
 		return result;
 	}
 
@@ -270,82 +641,55 @@ namespace Zx
 
 	bool Test1::RenderingLoop()
 	{
-		xcb_intern_atom_cookie_t  protocols_cookie = xcb_intern_atom(m_window->GetInstance(), 1, 12, "WM_PROTOCOLS");
-		xcb_intern_atom_reply_t  *protocols_reply = xcb_intern_atom_reply(m_window->GetInstance(), protocols_cookie, 0);
-		xcb_intern_atom_cookie_t  delete_cookie = xcb_intern_atom(m_window->GetInstance(), 0, 16, "WM_DELETE_WINDOW");
-		xcb_intern_atom_reply_t  *delete_reply = xcb_intern_atom_reply(m_window->GetInstance(), delete_cookie, 0);
-		xcb_change_property(m_window->GetInstance(), XCB_PROP_MODE_REPLACE, m_window->GetHandle(), (*protocols_reply).atom, 4, 32, 1, &(*delete_reply).atom);
-		free(protocols_reply);
-
 		xcb_map_window(m_window->GetInstance(), m_window->GetHandle());
 		xcb_flush(m_window->GetInstance());
 
-		xcb_generic_event_t *event;
-		bool loop = true;
-		bool resize = false;
+		WindowEvents events;
 		bool result = true;
 
-		while (loop) 
+		// This thread handles the events and builds the frames, the render thread submits them
+		m_renderAvailable = m_swapChain->IsRenderAvailable();
+		std::thread renderThread(&Test1::RenderThread, this);
+
+		while (!events.close) 
 		{
-			event = xcb_poll_for_event(m_window->GetInstance());
+			bool render = m_renderAvailable && !m_window->IsMinimized();
 
-			if (event) 
+			// A window that cannot render sleeps on the connection until it is restored, resized or closed
+			if (!m_window->PumpEvents(events, (render || events.resize) ? 0 : -1)) 
 			{
-				switch (event->response_type & 0x7f) 
-				{
-				case XCB_CONFIGURE_NOTIFY: {
-					xcb_configure_notify_event_t *configure_event = (xcb_configure_notify_event_t*)event;
-					static uint16_t width = configure_event->width;
-					static uint16_t height = configure_event->height;
-
-					if (((configure_event->width > 0) && (width != configure_event->width)) ||
-						((configure_event->height > 0) && (height != configure_event->height))) 
-					{
-						resize = true;
-						width = configure_event->width;
-						height = configure_event->height;
-					}
-				}
+				std::cout << "Lost the connection to the X server" << std::endl;
+				result = false;
 				break;
-				
-				case XCB_CLIENT_MESSAGE:
-					if ((*(xcb_client_message_event_t*)event).data.data32[0] == (*delete_reply).atom) 
-					{
-						loop = false;
-						free(delete_reply);
-					}
-					break;
-				case XCB_KEY_PRESS:
-					loop = false;
-					break;
-				}
-				free(event);
 			}
-			else 
+
+			if (events.close)
+				break;
+
+			// The render thread recreates the swap chain before the loop knows if it can render
+			if (events.resize) 
 			{
-				if (resize) 
-				{
-					resize = false;
-					if (!OnWindowSizeChanged()) 
-					{
-						result = false;
-						break;
-					}
-				}
-				if (m_swapChain->IsRenderAvailable()) 
+				events.resize = false;
+				if (!PushCommand({ ResizeCommand, 0 }) || !WaitForRenderThread()) 
 				{
-					if (!Draw()) {
-						result = false;
-						break;
-					}
+					result = false;
+					break;
 				}
-				else 
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			}
+			// The frame is built while the render thread submits the previous one
+			if (m_renderAvailable && !m_window->IsMinimized()) 
+			{
+				if (!SubmitFrame()) {
+					result = false;
+					break;
 				}
 			}
 		}
 
+		// The frames already queued are submitted before the render thread stops
+		PushCommand({ QuitCommand, 0 });
+		renderThread.join();
+
 		return result;
 
 	}